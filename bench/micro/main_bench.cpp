@@ -0,0 +1,18 @@
+#include <benchmark/benchmark.h>
+#include <iostream>
+#include "utils/resource_loader.hpp"
+
+int main(int argc, char** argv) {
+	// Set working directory to project root (where data folder is located)
+	if (!ResourceLoader::SetDataDirectory()) {
+		std::cerr << "Warning: Could not find data directory. Benchmarks may fail to load config files." << std::endl;
+	}
+
+	::benchmark::Initialize(&argc, argv);
+	if (::benchmark::ReportUnrecognizedArguments(argc, argv)) {
+		return 1;
+	}
+	::benchmark::RunSpecifiedBenchmarks();
+	::benchmark::Shutdown();
+	return 0;
+}
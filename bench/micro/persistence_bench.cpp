@@ -0,0 +1,76 @@
+#include <benchmark/benchmark.h>
+#include "world/world.hpp"
+#include "utils/resource_loader.hpp"
+#include <filesystem>
+#include <memory>
+#include <string>
+
+// Save/load throughput of World::SaveGame/LoadGame: arg 0 is the unit count, arg 1 the format
+// (0 = JSON, 1 = cereal binary, 2 = mapped snapshot, 3 = compressed snapshot).
+// Bytes/s is the file size processed per second.
+
+static std::unique_ptr<World> createBattle(int unitCount) {
+	nlohmann::json config;
+	ResourceLoader::load_config("data/config.json", config);
+	auto world = std::make_unique<World>();
+	world->Initialize(config, false);
+
+	// Two mixed armies in opposite halves of the map
+	for (int i = 0; i < unitCount; ++i) {
+		int faction = i % 2;
+		Vec2 pos = {static_cast<float>(faction * 256 + (i / 2) % 250), static_cast<float>((i / 500) % 510)};
+		world->SpawnUnit(static_cast<UnitType>(i % 4), faction, pos);
+	}
+	return world;
+}
+
+static std::string savePath(int64_t format) {
+	const char* names[] = {"rts_persistence_bench.json", "rts_persistence_bench.bin", "rts_persistence_bench.snap", "rts_persistence_bench.snapz"};
+	return (std::filesystem::temp_directory_path() / names[format]).string();
+}
+
+static void BM_SaveGame(benchmark::State& state) {
+	auto world = createBattle(static_cast<int>(state.range(0)));
+	std::string path = savePath(state.range(1));
+
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(world->SaveGame(path));
+	}
+
+	state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(std::filesystem::file_size(path)));
+	state.counters["file_bytes"] = static_cast<double>(std::filesystem::file_size(path));
+	std::filesystem::remove(path);
+}
+BENCHMARK(BM_SaveGame)->ArgsProduct({{10000, 100000}, {0, 1, 2, 3}})->Unit(benchmark::kMillisecond);
+
+static void BM_LoadGame(benchmark::State& state) {
+	std::string path = savePath(state.range(1));
+	createBattle(static_cast<int>(state.range(0)))->SaveGame(path);
+
+	auto world = createBattle(0);
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(world->LoadGame(path));
+	}
+
+	state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(std::filesystem::file_size(path)));
+	std::filesystem::remove(path);
+}
+BENCHMARK(BM_LoadGame)->ArgsProduct({{10000, 100000}, {0, 1, 2, 3}})->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_LoadGame)->Args({1000000, 1})->Args({1000000, 2})->Args({1000000, 3})->Unit(benchmark::kMillisecond);
+
+// Main-thread pause of World::SaveGameAsync (copying the pools); the write itself is waited for untimed
+static void BM_SaveGameAsync_Pause(benchmark::State& state) {
+	auto world = createBattle(static_cast<int>(state.range(0)));
+	std::string path = savePath(state.range(1));
+
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(world->SaveGameAsync(path));
+		state.PauseTiming();
+		world->WaitForSave();
+		state.ResumeTiming();
+	}
+
+	state.counters["write_ms"] = world->PollSave().writeMs;
+	std::filesystem::remove(path);
+}
+BENCHMARK(BM_SaveGameAsync_Pause)->ArgsProduct({{10000, 100000}, {0, 1, 2, 3}})->Unit(benchmark::kMillisecond);
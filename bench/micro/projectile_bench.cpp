@@ -0,0 +1,86 @@
+#include <benchmark/benchmark.h>
+#include "world/world.hpp"
+#include "utils/resource_loader.hpp"
+#include "world/projectile_pool.hpp"
+#include <memory>
+
+// Tick cost with projectile entities (arg 1 = 0) or the ProjectilePool (arg 1 = 1): arg 0 archers per side,
+// facing each other in range with effectively infinite health, so every archer fires every cooldown forever.
+// Counters: projectiles in flight, and for entities the share of consecutive Projectile entities whose
+// Position is not the next one in the Position pool (sparse set scatter from create/destroy churn).
+
+static std::unique_ptr<World> createArcherLines(int perSide, bool pooled) {
+	nlohmann::json config;
+	ResourceLoader::load_config("data/config.json", config);
+	config["global"]["projectile_pool"] = pooled;
+	config["global"]["worker_threads"] = 1;
+	config["global"]["autosave_interval"] = 0;
+	config["units"][1]["hp"] = 1.0e9f;
+	auto world = std::make_unique<World>();
+	world->Initialize(config, false);
+
+	const int rows = 480;
+	for (int i = 0; i < perSide; ++i) {
+		float column = static_cast<float>(i / rows);
+		float y = 10.0f + (i % rows);
+		world->SpawnUnit(UnitType::Archer, 0, Vec2(250.0f - column, y));
+		world->SpawnUnit(UnitType::Archer, 1, Vec2(254.0f + column, y));
+	}
+	return world;
+}
+
+static double projectileScatter(entt::registry& registry) {
+	const auto& projectiles = registry.storage<Projectile>();
+	const auto& positions = registry.storage<Position>();
+	if (projectiles.size() < 2) {
+		return 0.0;
+	}
+
+	size_t breaks = 0;
+	for (size_t i = 1; i < projectiles.size(); ++i) {
+		if (positions.index(projectiles.data()[i]) != positions.index(projectiles.data()[i - 1]) + 1) {
+			breaks++;
+		}
+	}
+	return static_cast<double>(breaks) / (projectiles.size() - 1);
+}
+
+static void BM_ProjectileTick(benchmark::State& state) {
+	bool pooled = state.range(1) != 0;
+	auto world = createArcherLines(static_cast<int>(state.range(0)), pooled);
+
+	// Past the first targeting pass and a few volleys, so projectiles are created and destroyed every tick
+	for (int tick = 0; tick < 500; ++tick) {
+		world->Update(0.01f);
+	}
+
+	for (auto _ : state) {
+		world->Update(0.01f);
+	}
+
+	UnitCountData counts = world->GetUnitCounts();
+	state.counters["in_flight"] = counts.projectileCount;
+	state.counters["scatter"] = pooled ? 0.0 : projectileScatter(world->GetRegistry());
+}
+BENCHMARK(BM_ProjectileTick)->Args({2000, 0})->Args({2000, 1})->Args({20000, 0})->Args({20000, 1})->Unit(benchmark::kMicrosecond);
+
+// ProjectilePool::Advance alone: arg 0 projectiles flying toward far targets, none landing, so the
+// tick costs the same whatever the number in flight
+static void BM_ProjectileKernel(benchmark::State& state) {
+	ProjectilePool pool;
+	size_t count = static_cast<size_t>(state.range(0));
+	pool.Reserve(count);
+	for (size_t i = 0; i < count; ++i) {
+		float y = static_cast<float>(i % 1000);
+		pool.Activate({Vec2(0.0f, y), Vec2(15.0f, 0.0f), Vec2(1.0e9f, y), 15.0f, Projectile{8.0f, 0, false, 0.0f}});
+	}
+
+	std::vector<uint32_t> hits;
+	for (auto _ : state) {
+		hits.clear();
+		pool.Advance(0.01f, hits);
+		benchmark::DoNotOptimize(hits.data());
+	}
+	state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_ProjectileKernel)->Arg(100000)->Arg(1000000)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,62 @@
+#include <benchmark/benchmark.h>
+#include "world/world.hpp"
+#include "world/snapshot_codec.hpp"
+#include "world/snapshot_file.hpp"
+#include "utils/resource_loader.hpp"
+#include <memory>
+#include <vector>
+
+// SnapshotCodec ratio and speed on generated battles: arg 0 is the unit count.
+// Bytes/s is the uncompressed image size processed per second; "ratio" is image size / compressed size.
+
+static std::vector<std::byte> battleImage(int unitCount) {
+	nlohmann::json config;
+	ResourceLoader::load_config("data/config.json", config);
+	World world;
+	world.Initialize(config, false);
+
+	// Two mixed armies in opposite halves of the map, a few hundred ticks into the fight
+	for (int i = 0; i < unitCount; ++i) {
+		int faction = i % 2;
+		Vec2 pos = {static_cast<float>(faction * 256 + (i / 2) % 250), static_cast<float>((i / 500) % 510)};
+		world.SpawnUnit(static_cast<UnitType>(i % 4), faction, pos);
+	}
+	for (int tick = 0; tick < 100; ++tick) {
+		world.Update(1.0f / 60.0f);
+	}
+
+	std::vector<std::byte> image;
+	SnapshotFile::Capture(world.GetRegistry(), World::PersistedComponents{}, image);
+	return image;
+}
+
+static void BM_SnapshotEncode(benchmark::State& state) {
+	std::vector<std::byte> image = battleImage(static_cast<int>(state.range(0)));
+	std::vector<std::byte> encoded;
+
+	for (auto _ : state) {
+		SnapshotCodec::Encode(image, encoded);
+		benchmark::DoNotOptimize(encoded.data());
+	}
+
+	state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(image.size()));
+	state.counters["ratio"] = static_cast<double>(image.size()) / static_cast<double>(encoded.size());
+	state.counters["encoded_bytes"] = static_cast<double>(encoded.size());
+}
+BENCHMARK(BM_SnapshotEncode)->Arg(10000)->Arg(100000)->Arg(1000000)->Unit(benchmark::kMillisecond);
+
+static void BM_SnapshotDecode(benchmark::State& state) {
+	std::vector<std::byte> image = battleImage(static_cast<int>(state.range(0)));
+	std::vector<std::byte> encoded;
+	SnapshotCodec::Encode(image, encoded);
+	std::vector<std::byte> decoded;
+
+	for (auto _ : state) {
+		SnapshotCodec::Decode(encoded.data(), encoded.size(), decoded, "benchmark");
+		benchmark::DoNotOptimize(decoded.data());
+	}
+
+	state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(image.size()));
+	state.counters["ratio"] = static_cast<double>(image.size()) / static_cast<double>(encoded.size());
+}
+BENCHMARK(BM_SnapshotDecode)->Arg(10000)->Arg(100000)->Arg(1000000)->Unit(benchmark::kMillisecond);
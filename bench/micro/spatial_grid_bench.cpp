@@ -0,0 +1,209 @@
+#include <benchmark/benchmark.h>
+#include "world/spatial_grid.hpp"
+#include "components/components.hpp"
+#include <vector>
+
+// Battle-sized world: units spread over a 512x512 map with the game's cell size
+static void populateGrid(entt::registry& registry, SpatialGrid& grid, int unitCount) {
+	for (int i = 0; i < unitCount; ++i) {
+		auto entity = registry.create();
+		Vec2 pos = {static_cast<float>((i * 7919) % 512), static_cast<float>((i * 389) % 512)};
+		registry.emplace<Position>(entity, pos);
+		registry.emplace<Faction>(entity, i % MAX_FACTIONS);
+		grid.Insert(entity, pos, i % MAX_FACTIONS);
+	}
+}
+
+// Query points reused by every benchmark so the visited sets are identical
+static std::vector<Vec2> makeQueryPoints(int count) {
+	std::vector<Vec2> points;
+	points.reserve(count);
+	for (int i = 0; i < count; ++i) {
+		points.push_back({static_cast<float>((i * 131) % 512), static_cast<float>((i * 263) % 512)});
+	}
+	return points;
+}
+
+static constexpr int QueryCount = 1000;
+static constexpr float SearchRadius = 12.0f;
+
+// std::function path: one indirect call per visited entity
+static void BM_QueryRadiusStdFunction(benchmark::State& state) {
+	entt::registry registry;
+	SpatialGrid grid(registry, 512, 512, 3);
+	populateGrid(registry, grid, static_cast<int>(state.range(0)));
+	auto points = makeQueryPoints(QueryCount);
+
+	int64_t visited = 0;
+	for (auto _ : state) {
+		for (const Vec2& point : points) {
+			grid.QueryRadius(point, SearchRadius, [&](entt::entity) {
+				visited++;
+			}, 0, false);
+		}
+	}
+
+	benchmark::DoNotOptimize(visited);
+	state.SetItemsProcessed(state.iterations() * QueryCount);
+}
+BENCHMARK(BM_QueryRadiusStdFunction)->Arg(10000)->Arg(50000)->Unit(benchmark::kMicrosecond);
+
+// Templated path: the visitor is inlined into the cell walk
+static void BM_VisitRadiusTemplate(benchmark::State& state) {
+	entt::registry registry;
+	SpatialGrid grid(registry, 512, 512, 3);
+	populateGrid(registry, grid, static_cast<int>(state.range(0)));
+	auto points = makeQueryPoints(QueryCount);
+
+	int64_t visited = 0;
+	for (auto _ : state) {
+		for (const Vec2& point : points) {
+			grid.VisitRadius(point, SearchRadius, [&](entt::entity) {
+				visited++;
+			}, 0, false);
+		}
+	}
+
+	benchmark::DoNotOptimize(visited);
+	state.SetItemsProcessed(state.iterations() * QueryCount);
+}
+BENCHMARK(BM_VisitRadiusTemplate)->Arg(10000)->Arg(50000)->Unit(benchmark::kMicrosecond);
+
+// Targeting hot path, second argument selects the grid backend (0 = linked list, 1 = packed)
+static void BM_FindNearest(benchmark::State& state) {
+	entt::registry registry;
+	SpatialGrid grid(registry, 512, 512, 3);
+	populateGrid(registry, grid, static_cast<int>(state.range(0)));
+	grid.SetBackend(state.range(1) ? GridBackend::Packed : GridBackend::LinkedList);
+	auto points = makeQueryPoints(QueryCount);
+
+	for (auto _ : state) {
+		for (const Vec2& point : points) {
+			benchmark::DoNotOptimize(grid.FindNearest(point, SearchRadius, 0, false));
+		}
+	}
+
+	state.SetItemsProcessed(state.iterations() * QueryCount);
+}
+BENCHMARK(BM_FindNearest)->ArgsProduct({{10000, 50000}, {0, 1}})->Unit(benchmark::kMicrosecond);
+
+// Packed backend including the once-per-tick rebuild that follows movement
+static void BM_PackedRebuildAndQuery(benchmark::State& state) {
+	entt::registry registry;
+	SpatialGrid grid(registry, 512, 512, 3);
+	populateGrid(registry, grid, static_cast<int>(state.range(0)));
+	grid.SetBackend(GridBackend::Packed);
+	auto points = makeQueryPoints(QueryCount);
+
+	// Queries below skip faction 0, so move an enemy to force a rebuild of a grid that is read
+	entt::entity mover = entt::null;
+	for (auto [entity, faction] : registry.view<Faction>().each()) {
+		if (faction.id == 1) {
+			mover = entity;
+			break;
+		}
+	}
+
+	for (auto _ : state) {
+		// A same-cell move is enough to invalidate the packed arrays
+		const Vec2 pos = registry.get<Position>(mover).value;
+		grid.Update(mover, pos, pos);
+		for (const Vec2& point : points) {
+			benchmark::DoNotOptimize(grid.FindNearest(point, SearchRadius, 0, false));
+		}
+	}
+
+	state.SetItemsProcessed(state.iterations() * QueryCount);
+}
+BENCHMARK(BM_PackedRebuildAndQuery)->Arg(10000)->Arg(50000)->Unit(benchmark::kMicrosecond);
+
+// Packed FindNearest with the distance kernel forced to each level (0 = scalar, 1 = SSE2, 2 = AVX2)
+static void BM_FindNearestPackedKernel(benchmark::State& state) {
+	auto level = static_cast<SimdDistance::Level>(state.range(1));
+	if (!SimdDistance::IsSupported(level)) {
+		state.SkipWithError("kernel level not supported on this CPU");
+		return;
+	}
+
+	entt::registry registry;
+	SpatialGrid grid(registry, 512, 512, 3);
+	populateGrid(registry, grid, static_cast<int>(state.range(0)));
+	grid.SetBackend(GridBackend::Packed);
+	auto points = makeQueryPoints(QueryCount);
+
+	SimdDistance::Level original = SimdDistance::GetLevel();
+	SimdDistance::SetLevel(level);
+	for (auto _ : state) {
+		for (const Vec2& point : points) {
+			// Archer range from data/config.json
+			benchmark::DoNotOptimize(grid.FindNearest(point, 35.0f, 0, false));
+		}
+	}
+	SimdDistance::SetLevel(original);
+
+	state.SetLabel(SimdDistance::GetLevelName(level));
+	state.SetItemsProcessed(state.iterations() * QueryCount);
+}
+BENCHMARK(BM_FindNearestPackedKernel)->ArgsProduct({{50000}, {0, 1, 2}})->Unit(benchmark::kMicrosecond);
+
+// Clustered shooters (like a formation of archers), resolved one at a time or as a batch
+static std::vector<NearestQuery> makeShooterQueries(int count) {
+	std::vector<NearestQuery> queries;
+	queries.reserve(count);
+	for (int i = 0; i < count; ++i) {
+		Vec2 pos = {static_cast<float>(200 + (i * 7) % 40), static_cast<float>(200 + (i * 13) % 40)};
+		queries.push_back({pos, 35.0f, 0, false});
+	}
+	return queries;
+}
+
+static void BM_FindNearestLoop(benchmark::State& state) {
+	entt::registry registry;
+	SpatialGrid grid(registry, 512, 512, 3);
+	populateGrid(registry, grid, 50000);
+	grid.SetBackend(state.range(0) ? GridBackend::Packed : GridBackend::LinkedList);
+	auto queries = makeShooterQueries(QueryCount);
+
+	for (auto _ : state) {
+		for (const auto& query : queries) {
+			benchmark::DoNotOptimize(grid.FindNearest(query.pos, query.radius, query.faction, query.same_faction));
+		}
+	}
+
+	state.SetItemsProcessed(state.iterations() * QueryCount);
+}
+BENCHMARK(BM_FindNearestLoop)->Arg(0)->Arg(1)->Unit(benchmark::kMicrosecond);
+
+static void BM_FindNearestBatch(benchmark::State& state) {
+	entt::registry registry;
+	SpatialGrid grid(registry, 512, 512, 3);
+	populateGrid(registry, grid, 50000);
+	grid.SetBackend(state.range(0) ? GridBackend::Packed : GridBackend::LinkedList);
+	auto queries = makeShooterQueries(QueryCount);
+	std::vector<entt::entity> results;
+
+	for (auto _ : state) {
+		grid.FindNearestBatch(queries, results);
+		benchmark::DoNotOptimize(results.data());
+	}
+
+	state.SetItemsProcessed(state.iterations() * QueryCount);
+}
+BENCHMARK(BM_FindNearestBatch)->Arg(0)->Arg(1)->Unit(benchmark::kMicrosecond);
+
+static void BM_FindKNearestBatch(benchmark::State& state) {
+	entt::registry registry;
+	SpatialGrid grid(registry, 512, 512, 3);
+	populateGrid(registry, grid, 50000);
+	auto queries = makeShooterQueries(QueryCount);
+	std::vector<entt::entity> results;
+	const int k = static_cast<int>(state.range(0));
+
+	for (auto _ : state) {
+		grid.FindKNearestBatch(queries, k, results);
+		benchmark::DoNotOptimize(results.data());
+	}
+
+	state.SetItemsProcessed(state.iterations() * QueryCount);
+}
+BENCHMARK(BM_FindKNearestBatch)->Arg(1)->Arg(2)->Arg(4)->Unit(benchmark::kMicrosecond);
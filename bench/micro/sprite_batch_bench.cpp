@@ -0,0 +1,79 @@
+#include <benchmark/benchmark.h>
+#include "systems/sprite_batch.hpp"
+#include "world/spatial_grid.hpp"
+#include "components/components.hpp"
+#include <vector>
+
+// Measures the CPU cost of building per-frame instance buffers (no GL required)
+static void BM_SpriteBatchBuild(benchmark::State& state) {
+	const int unitCount = static_cast<int>(state.range(0));
+
+	entt::registry registry;
+	for (int i = 0; i < unitCount; ++i) {
+		auto entity = registry.create();
+		Vec2 pos = {static_cast<float>(i % 512), static_cast<float>(i / 512)};
+		registry.emplace<Position>(entity, pos);
+		registry.emplace<Unit>(entity, static_cast<UnitType>(i % 4), i % 3);
+
+		// Mix in a few selected units and projectiles like a real battle
+		if (i % 10 == 0) {
+			registry.emplace<Selected>(entity);
+		}
+		if (i % 7 == 0) {
+			registry.emplace<Projectile>(entity, 8.0f, i % 3, false, 0.0f);
+		}
+	}
+
+	std::vector<UVRect> unitUVs = {
+		{0.0f, 0.0f, 0.25f, 1.0f},
+		{0.25f, 0.0f, 0.25f, 1.0f},
+		{0.5f, 0.0f, 0.25f, 1.0f},
+		{0.75f, 0.0f, 0.25f, 1.0f}
+	};
+	std::vector<Color> factionColors = {
+		{1.0f, 0.0f, 0.0f, 1.0f},
+		{0.0f, 0.0f, 1.0f, 1.0f},
+		{0.0f, 1.0f, 0.0f, 1.0f}
+	};
+
+	SpriteBatch batch;
+	for (auto _ : state) {
+		batch.Build(registry, 1, unitUVs, factionColors, 1.0f);
+		benchmark::DoNotOptimize(batch.GetBuckets().data());
+		benchmark::ClobberMemory();
+	}
+
+	state.SetItemsProcessed(state.iterations() * unitCount);
+	state.SetBytesProcessed(state.iterations() * unitCount * static_cast<int64_t>(sizeof(SpriteInstance)));
+}
+BENCHMARK(BM_SpriteBatchBuild)->Arg(1000)->Arg(10000)->Arg(50000)->Unit(benchmark::kMicrosecond);
+
+// Same world, but the camera only sees a 128x72 window of a 512x512 map
+static void BM_SpriteBatchBuildVisible(benchmark::State& state) {
+	const int unitCount = static_cast<int>(state.range(0));
+
+	entt::registry registry;
+	SpatialGrid grid(registry, 512, 512, 3);
+	for (int i = 0; i < unitCount; ++i) {
+		auto entity = registry.create();
+		Vec2 pos = {static_cast<float>((i * 7919) % 512), static_cast<float>((i * 389) % 512)};
+		registry.emplace<Position>(entity, pos);
+		registry.emplace<Unit>(entity, static_cast<UnitType>(i % 4), i % 3);
+		registry.emplace<Faction>(entity, i % 3);
+		grid.Insert(entity, pos, i % 3);
+	}
+
+	std::vector<UVRect> unitUVs = {{0.0f, 0.0f, 0.25f, 1.0f}};
+	std::vector<Color> factionColors = {{1.0f, 0.0f, 0.0f, 1.0f}};
+
+	SpriteBatch batch;
+	for (auto _ : state) {
+		batch.BuildVisible(registry, grid, Vec2(192.0f, 220.0f), Vec2(320.0f, 292.0f), 1, unitUVs, factionColors, 1.0f);
+		benchmark::DoNotOptimize(batch.GetBuckets().data());
+		benchmark::ClobberMemory();
+	}
+
+	state.counters["visible"] = static_cast<double>(batch.GetInstanceCount());
+	state.SetItemsProcessed(state.iterations() * unitCount);
+}
+BENCHMARK(BM_SpriteBatchBuildVisible)->Arg(10000)->Arg(50000)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,70 @@
+#include <benchmark/benchmark.h>
+#include "world/world.hpp"
+#include "world/unit_factory.hpp"
+#include "utils/resource_loader.hpp"
+#include <memory>
+#include <vector>
+
+// Spawn throughput of UnitFactory: arg 0 is the number of units spawned per iteration (mixed types),
+// the same batch the UI spawn slider produces at its maximum
+static void BM_SpawnUnits(benchmark::State& state) {
+	nlohmann::json config;
+	ResourceLoader::load_config("data/config.json", config);
+	UnitFactory factory(config);
+	int count = static_cast<int>(state.range(0));
+
+	for (auto _ : state) {
+		state.PauseTiming();
+		entt::registry registry;
+		state.ResumeTiming();
+
+		for (int i = 0; i < count; ++i) {
+			Vec2 pos = {static_cast<float>(i % 100), static_cast<float>(i / 100)};
+			benchmark::DoNotOptimize(factory.spawn_unit(registry, static_cast<UnitType>(i % 4), i % 2, pos));
+		}
+
+		state.PauseTiming();
+		registry = {}; // Freeing the pools is not part of spawning
+		state.ResumeTiming();
+	}
+
+	state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_SpawnUnits)->Arg(1000)->Arg(100000)->Unit(benchmark::kMicrosecond);
+
+// S+drag spawn through World: arg 0 is the unit count, arg 1 selects SpawnUnit per position (0) or
+// one SpawnUnits call (1). Both include the spatial grid insert.
+static void BM_WorldSpawn(benchmark::State& state) {
+	nlohmann::json config;
+	ResourceLoader::load_config("data/config.json", config);
+	int count = static_cast<int>(state.range(0));
+	bool bulk = state.range(1) != 0;
+
+	std::vector<Vec2> positions;
+	positions.reserve(count);
+	for (int i = 0; i < count; ++i) {
+		positions.push_back({static_cast<float>(i % 400) + 0.5f, static_cast<float>(i / 400) + 0.5f});
+	}
+
+	for (auto _ : state) {
+		state.PauseTiming();
+		auto world = std::make_unique<World>();
+		world->Initialize(config, false);
+		state.ResumeTiming();
+
+		if (bulk) {
+			benchmark::DoNotOptimize(world->SpawnUnits(UnitType::Footman, 0, positions));
+		} else {
+			for (const Vec2& pos : positions) {
+				benchmark::DoNotOptimize(world->SpawnUnit(UnitType::Footman, 0, pos));
+			}
+		}
+
+		state.PauseTiming();
+		world.reset();
+		state.ResumeTiming();
+	}
+
+	state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_WorldSpawn)->Args({100000, 0})->Args({100000, 1})->Unit(benchmark::kMillisecond);
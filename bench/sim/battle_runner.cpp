@@ -0,0 +1,246 @@
+// Headless battle runner for balancing: loads a save, fast-forwards it to the end (World::RunUntilResolved)
+// as many times as asked and prints outcome statistics as JSON.
+//
+// Usage: RTS_BattleRunner --save PATH [--runs N] [--max-ticks M] [--dt SECONDS] [--jitter D] [--seed N]
+//                         [--threads T] [--config PATH] [--out PATH] [--per-run]
+//
+// Every run starts from the same save. --jitter moves each unit by up to D world units (seeded per run),
+// otherwise all runs are identical because the simulation is deterministic.
+
+#include "world/world.hpp"
+#include "utils/resource_loader.hpp"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+struct RunnerOptions {
+	std::string savePath;
+	int runs = 1;
+	int maxTicks = 60000;    // 10 minutes of game time at the default dt
+	float dt = 0.01f;
+	float jitter = 0.0f;
+	unsigned int seed = 1;
+	int threads = -1;        // -1 keeps the config value
+	std::string configPath = "data/config.json";
+	std::string outPath;     // Empty prints to stdout
+	bool perRun = false;     // Include every run in the report
+};
+
+static void printUsage() {
+	std::cerr << "Usage: RTS_BattleRunner --save PATH [--runs N] [--max-ticks M] [--dt SECONDS] [--jitter D] [--seed N]\n"
+	          << "                        [--threads T] [--config PATH] [--out PATH] [--per-run]" << std::endl;
+}
+
+static bool parseOptions(int argc, char** argv, RunnerOptions& options) {
+	for (int i = 1; i < argc; ++i) {
+		std::string arg = argv[i];
+		if (arg == "--per-run") {
+			options.perRun = true;
+			continue;
+		}
+		if (arg == "--help" || arg == "-h" || i + 1 >= argc) {
+			return false;
+		}
+
+		std::string value = argv[++i];
+		if (arg == "--save") options.savePath = value;
+		else if (arg == "--runs") options.runs = std::atoi(value.c_str());
+		else if (arg == "--max-ticks") options.maxTicks = std::atoi(value.c_str());
+		else if (arg == "--dt") options.dt = static_cast<float>(std::atof(value.c_str()));
+		else if (arg == "--jitter") options.jitter = static_cast<float>(std::atof(value.c_str()));
+		else if (arg == "--seed") options.seed = static_cast<unsigned int>(std::strtoul(value.c_str(), nullptr, 10));
+		else if (arg == "--threads") options.threads = std::atoi(value.c_str());
+		else if (arg == "--config") options.configPath = value;
+		else if (arg == "--out") options.outPath = value;
+		else return false;
+	}
+
+	options.runs = std::max(1, options.runs);
+	options.maxTicks = std::max(1, options.maxTicks);
+	options.jitter = std::max(0.0f, options.jitter);
+	return !options.savePath.empty() && options.dt > 0.0f;
+}
+
+// Move every unit by up to jitter in x and y, keeping idle units idle and the spatial grid in sync
+static void jitterUnits(World& world, float jitter, std::mt19937& rng) {
+	entt::registry& registry = world.GetRegistry();
+	SpatialGrid& grid = world.GetSpatialGrid();
+	std::uniform_real_distribution<float> offset(-jitter, jitter);
+	float maxX = static_cast<float>(grid.GetWidth()) - 0.001f;
+	float maxY = static_cast<float>(grid.GetHeight()) - 0.001f;
+
+	auto view = registry.view<Unit, Health, Position>();
+	for (auto entity : view) {
+		Vec2& pos = view.get<Position>(entity).value;
+		Vec2 moved(std::clamp(pos.x + offset(rng), 0.0f, maxX), std::clamp(pos.y + offset(rng), 0.0f, maxY));
+		if (auto* movement = registry.try_get<Movement>(entity); movement && movement->target == pos) {
+			movement->target = moved;
+		}
+		grid.Update(entity, pos, moved);
+		pos = moved;
+	}
+}
+
+static double percentile(std::vector<double> values, double p) {
+	if (values.empty()) {
+		return 0.0;
+	}
+	// Nearest rank
+	std::sort(values.begin(), values.end());
+	size_t rank = static_cast<size_t>(std::ceil(p / 100.0 * values.size()));
+	return values[std::min(values.size() - 1, rank > 0 ? rank - 1 : 0)];
+}
+
+int main(int argc, char** argv) {
+	RunnerOptions options;
+	if (!parseOptions(argc, argv, options)) {
+		printUsage();
+		return 1;
+	}
+
+	// Resolve user paths before moving to the project root
+	options.savePath = std::filesystem::absolute(options.savePath).string();
+	if (!options.outPath.empty()) {
+		options.outPath = std::filesystem::absolute(options.outPath).string();
+	}
+	if (!ResourceLoader::SetDataDirectory()) {
+		std::cerr << "Warning: Could not find data directory." << std::endl;
+	}
+
+	nlohmann::json config;
+	if (!ResourceLoader::load_config(options.configPath, config)) {
+		std::cerr << "Failed to load config: " << options.configPath << std::endl;
+		return 1;
+	}
+	if (options.threads >= 0) {
+		config["global"]["worker_threads"] = options.threads;
+	}
+	config["global"]["autosave_interval"] = 0;
+
+	World world;
+	if (!world.Initialize(config, false)) {
+		std::cerr << "Failed to initialize world" << std::endl;
+		return 1;
+	}
+
+	// Reload from a mapped snapshot between runs, whatever format the save is in
+	if (!world.LoadGame(options.savePath)) {
+		std::cerr << "Failed to load save: " << options.savePath << std::endl;
+		return 1;
+	}
+	// Random name so runners started side by side (sweeps, CI shards) never reload each other's start
+	std::random_device entropy;
+	std::string startName = "rts_battle_runner_" + std::to_string(entropy()) + "_" + std::to_string(entropy()) + ".snap";
+	std::string startPath = (std::filesystem::temp_directory_path() / startName).string();
+	if (!world.SaveGame(startPath)) {
+		std::cerr << "Failed to write start snapshot: " << startPath << std::endl;
+		return 1;
+	}
+
+	int wins[8] = {0};
+	int draws = 0, unresolved = 0;
+	double survivorTotals[8] = {0.0};
+	std::vector<double> ticks;
+	ticks.reserve(options.runs);
+	long long totalTicks = 0;
+	double simulateSeconds = 0.0;
+	nlohmann::ordered_json runs = nlohmann::ordered_json::array();
+
+	auto runnerStart = std::chrono::steady_clock::now();
+	for (int run = 0; run < options.runs; ++run) {
+		if (run > 0 && !world.LoadGame(startPath)) {
+			std::cerr << "Failed to reload start snapshot: " << startPath << std::endl;
+			std::filesystem::remove(startPath);
+			return 1;
+		}
+		if (options.jitter > 0.0f) {
+			std::mt19937 rng(options.seed + run);
+			jitterUnits(world, options.jitter, rng);
+		}
+
+		BattleResult result = world.RunUntilResolved(options.dt, options.maxTicks);
+		totalTicks += result.ticks;
+		simulateSeconds += result.seconds;
+		ticks.push_back(result.ticks);
+		if (!result.resolved) {
+			unresolved++;
+		} else if (result.winner < 0) {
+			draws++;
+		} else {
+			wins[result.winner]++;
+		}
+		for (int faction = 0; faction < 8; ++faction) {
+			survivorTotals[faction] += result.aliveCount[faction];
+		}
+
+		if (options.perRun) {
+			nlohmann::ordered_json row;
+			row["run"] = run;
+			row["ticks"] = result.ticks;
+			row["resolved"] = result.resolved;
+			row["winner"] = result.winner;
+			row["alive"] = std::vector<int>(result.aliveCount, result.aliveCount + MAX_FACTIONS);
+			row["seconds"] = result.seconds;
+			runs.push_back(row);
+		}
+	}
+	double runnerSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - runnerStart).count();
+	std::filesystem::remove(startPath);
+
+	// Report
+	nlohmann::ordered_json report;
+	report["config"] = {
+		{"save", options.savePath},
+		{"runs", options.runs},
+		{"max_ticks", options.maxTicks},
+		{"dt", options.dt},
+		{"jitter", options.jitter},
+		{"seed", options.seed},
+		{"worker_threads", config["global"].value("worker_threads", 1)}
+	};
+
+	report["outcomes"]["wins"] = std::vector<int>(wins, wins + MAX_FACTIONS);
+	report["outcomes"]["draws"] = draws;
+	report["outcomes"]["unresolved"] = unresolved;
+	std::vector<double> survivors;
+	for (int faction = 0; faction < MAX_FACTIONS; ++faction) {
+		survivors.push_back(survivorTotals[faction] / options.runs);
+	}
+	report["outcomes"]["mean_survivors"] = survivors;
+
+	double tickSum = static_cast<double>(totalTicks);
+	report["duration"]["mean_ticks"] = tickSum / options.runs;
+	report["duration"]["p50_ticks"] = percentile(ticks, 50.0);
+	report["duration"]["p95_ticks"] = percentile(ticks, 95.0);
+	report["duration"]["max_ticks"] = percentile(ticks, 100.0);
+	report["duration"]["mean_game_seconds"] = tickSum * options.dt / options.runs;
+
+	report["throughput"]["total_ticks"] = totalTicks;
+	report["throughput"]["ticks_per_second"] = tickSum / std::max(simulateSeconds, 1e-9);
+	report["throughput"]["battles_per_second"] = options.runs / std::max(runnerSeconds, 1e-9);
+	report["throughput"]["wall_seconds"] = runnerSeconds;
+
+	if (options.perRun) {
+		report["runs"] = runs;
+	}
+
+	if (options.outPath.empty()) {
+		std::cout << report.dump(2) << std::endl;
+	} else {
+		std::ofstream out(options.outPath);
+		if (!out.is_open()) {
+			std::cerr << "Failed to open output file: " << options.outPath << std::endl;
+			return 1;
+		}
+		out << report.dump(2) << std::endl;
+	}
+	return 0;
+}
@@ -0,0 +1,313 @@
+// Headless simulation benchmark: builds a World without rendering, spawns armies in a chosen layout,
+// runs a fixed number of ticks and prints per-system timing percentiles as JSON.
+//
+// Usage: RTS_Bench [--units N] [--factions F] [--ticks M] [--warmup W] [--dt SECONDS]
+//                  [--layout grid|lines|random] [--mix mixed|footman|archer|ballista|healer]
+//                  [--spacing S] [--seed N] [--threads T] [--backend linked_list|packed]
+//                  [--no-march] [--projectile-pool] [--config PATH] [--out PATH] [--trace PATH]
+//
+// --trace writes a Chrome trace of the measured ticks when built with RTS_PROFILER=chrome.
+
+#include "world/world.hpp"
+#include "utils/resource_loader.hpp"
+#include "utils/profiler.hpp"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+struct BenchOptions {
+	int units = 1000;        // Per faction
+	int factions = 2;
+	int ticks = 600;
+	int warmup = 60;
+	float dt = 1.0f / 60.0f;
+	std::string layout = "lines";
+	std::string mix = "mixed";
+	float spacing = 1.5f;
+	unsigned int seed = 1;
+	int threads = -1;        // -1 keeps the config value
+	std::string backend;     // Empty keeps the config value
+	bool march = true;       // Order every unit towards the world centre
+	bool projectilePool = false; // Fire into the ProjectilePool instead of creating projectile entities
+	std::string configPath = "data/config.json";
+	std::string outPath;     // Empty prints to stdout
+	std::string tracePath;   // Chrome trace of the measured ticks (RTS_PROFILER=chrome builds)
+};
+
+static void printUsage() {
+	std::cerr << "Usage: RTS_Bench [--units N] [--factions F] [--ticks M] [--warmup W] [--dt SECONDS]\n"
+	          << "                 [--layout grid|lines|random] [--mix mixed|footman|archer|ballista|healer]\n"
+	          << "                 [--spacing S] [--seed N] [--threads T] [--backend linked_list|packed]\n"
+	          << "                 [--no-march] [--projectile-pool] [--config PATH] [--out PATH] [--trace PATH]" << std::endl;
+}
+
+static bool parseOptions(int argc, char** argv, BenchOptions& options) {
+	for (int i = 1; i < argc; ++i) {
+		std::string arg = argv[i];
+		if (arg == "--no-march") {
+			options.march = false;
+			continue;
+		}
+		if (arg == "--projectile-pool") {
+			options.projectilePool = true;
+			continue;
+		}
+		if (arg == "--help" || arg == "-h" || i + 1 >= argc) {
+			return false;
+		}
+
+		std::string value = argv[++i];
+		if (arg == "--units") options.units = std::atoi(value.c_str());
+		else if (arg == "--factions") options.factions = std::atoi(value.c_str());
+		else if (arg == "--ticks") options.ticks = std::atoi(value.c_str());
+		else if (arg == "--warmup") options.warmup = std::atoi(value.c_str());
+		else if (arg == "--dt") options.dt = static_cast<float>(std::atof(value.c_str()));
+		else if (arg == "--layout") options.layout = value;
+		else if (arg == "--mix") options.mix = value;
+		else if (arg == "--spacing") options.spacing = static_cast<float>(std::atof(value.c_str()));
+		else if (arg == "--seed") options.seed = static_cast<unsigned int>(std::strtoul(value.c_str(), nullptr, 10));
+		else if (arg == "--threads") options.threads = std::atoi(value.c_str());
+		else if (arg == "--backend") options.backend = value;
+		else if (arg == "--config") options.configPath = value;
+		else if (arg == "--out") options.outPath = value;
+		else if (arg == "--trace") options.tracePath = value;
+		else return false;
+	}
+
+	options.factions = std::max(1, std::min(options.factions, MAX_FACTIONS));
+	options.units = std::max(0, options.units);
+	options.ticks = std::max(1, options.ticks);
+	options.warmup = std::max(0, options.warmup);
+	options.spacing = std::max(0.1f, options.spacing);
+	return options.layout == "grid" || options.layout == "lines" || options.layout == "random";
+}
+
+// Unit type for the i-th unit of a faction
+static UnitType pickType(const std::string& mix, int index) {
+	if (mix == "footman") return UnitType::Footman;
+	if (mix == "archer") return UnitType::Archer;
+	if (mix == "ballista") return UnitType::Ballista;
+	if (mix == "healer") return UnitType::Healer;
+
+	// Mixed army: 50% footmen, 25% archers, 10% ballistas, 15% healers
+	int slot = index % 20;
+	if (slot < 10) return UnitType::Footman;
+	if (slot < 15) return UnitType::Archer;
+	if (slot < 17) return UnitType::Ballista;
+	return UnitType::Healer;
+}
+
+// Position of the i-th unit of a faction inside the world
+static Vec2 layoutPosition(const BenchOptions& options, int faction, int index, float width, float height, std::mt19937& rng) {
+	if (options.layout == "random") {
+		std::uniform_real_distribution<float> x(0.0f, width - 1.0f);
+		std::uniform_real_distribution<float> y(0.0f, height - 1.0f);
+		return Vec2(x(rng), y(rng));
+	}
+
+	float bandWidth = width / options.factions;
+	float bandLeft = bandWidth * faction;
+
+	if (options.layout == "grid") {
+		// Square block per faction, centred in its vertical band
+		int side = static_cast<int>(std::ceil(std::sqrt(static_cast<float>(options.units))));
+		float blockSize = side * options.spacing;
+		float left = bandLeft + (bandWidth - blockSize) * 0.5f;
+		float top = (height - blockSize) * 0.5f;
+		return Vec2(left + (index % side) * options.spacing, top + (index / side) * options.spacing);
+	}
+
+	// Lines: ranks parallel to the band edge, front rank facing the centre of the world
+	int perRank = std::max(1, static_cast<int>((height - 2.0f) / options.spacing));
+	int rank = index / perRank;
+	float front = faction * 2 < options.factions ? bandLeft + bandWidth - 1.0f : bandLeft + 1.0f;
+	float direction = faction * 2 < options.factions ? -1.0f : 1.0f;
+	return Vec2(front + direction * rank * options.spacing, 1.0f + (index % perRank) * options.spacing);
+}
+
+struct Samples {
+	std::vector<double> values;
+
+	nlohmann::ordered_json Summary() {
+		nlohmann::ordered_json out;
+		if (values.empty()) {
+			return out;
+		}
+		std::sort(values.begin(), values.end());
+		double total = 0.0;
+		for (double value : values) {
+			total += value;
+		}
+
+		// Nearest-rank percentile
+		auto percentile = [this](double p) {
+			size_t rank = static_cast<size_t>(std::ceil(p / 100.0 * values.size()));
+			return values[std::min(values.size() - 1, rank > 0 ? rank - 1 : 0)];
+		};
+
+		out["mean_ms"] = total / values.size();
+		out["p50_ms"] = percentile(50.0);
+		out["p90_ms"] = percentile(90.0);
+		out["p95_ms"] = percentile(95.0);
+		out["p99_ms"] = percentile(99.0);
+		out["min_ms"] = values.front();
+		out["max_ms"] = values.back();
+		out["total_ms"] = total;
+		return out;
+	}
+};
+
+int main(int argc, char** argv) {
+	RTS_PROFILE_THREAD("Main");
+
+	BenchOptions options;
+	if (!parseOptions(argc, argv, options)) {
+		printUsage();
+		return 1;
+	}
+
+	// Resolve the output path before moving to the project root
+	if (!options.outPath.empty()) {
+		options.outPath = std::filesystem::absolute(options.outPath).string();
+	}
+	if (!options.tracePath.empty()) {
+		options.tracePath = std::filesystem::absolute(options.tracePath).string();
+	}
+	if (!ResourceLoader::SetDataDirectory()) {
+		std::cerr << "Warning: Could not find data directory." << std::endl;
+	}
+
+	nlohmann::json config;
+	if (!ResourceLoader::load_config(options.configPath, config)) {
+		std::cerr << "Failed to load config: " << options.configPath << std::endl;
+		return 1;
+	}
+	if (options.threads >= 0) {
+		config["global"]["worker_threads"] = options.threads;
+	}
+	if (!options.backend.empty()) {
+		config["global"]["grid_backend"] = options.backend;
+	}
+	if (options.projectilePool) {
+		config["global"]["projectile_pool"] = true;
+	}
+
+	World world;
+	if (!world.Initialize(config, false)) {
+		std::cerr << "Failed to initialize world" << std::endl;
+		return 1;
+	}
+
+	// Spawn armies
+	SpatialGrid& grid = world.GetSpatialGrid();
+	float width = static_cast<float>(grid.GetWidth());
+	float height = static_cast<float>(grid.GetHeight());
+	Vec2 centre(width * 0.5f, height * 0.5f);
+	std::mt19937 rng(options.seed);
+	int spawned = 0;
+
+	for (int faction = 0; faction < options.factions; ++faction) {
+		for (int i = 0; i < options.units; ++i) {
+			Vec2 pos = layoutPosition(options, faction, i, width, height, rng);
+			entt::entity entity = world.SpawnUnit(pickType(options.mix, i), faction, pos);
+			if (entity == entt::null) continue;
+			spawned++;
+
+			if (options.march) {
+				if (auto* movement = world.GetRegistry().try_get<Movement>(entity)) {
+					movement->MoveTo(pos, centre);
+				}
+			}
+		}
+	}
+
+	for (int tick = 0; tick < options.warmup; ++tick) {
+		world.Update(options.dt);
+	}
+
+	// Measured ticks
+	Samples movement, targeting, melee, ranged, healer, projectiles, death, tickTotal;
+	for (Samples* samples : {&movement, &targeting, &melee, &ranged, &healer, &projectiles, &death, &tickTotal}) {
+		samples->values.reserve(options.ticks);
+	}
+
+	const GameplayTimings& timings = world.GetGameplaySystem().GetTimings();
+	if (!options.tracePath.empty()) {
+		RTS_PROFILE_BEGIN_SESSION(options.tracePath);
+	}
+	auto runStart = std::chrono::steady_clock::now();
+	for (int tick = 0; tick < options.ticks; ++tick) {
+		auto tickStart = std::chrono::steady_clock::now();
+		world.Update(options.dt);
+		tickTotal.values.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - tickStart).count());
+
+		movement.values.push_back(timings.movement);
+		targeting.values.push_back(timings.targeting);
+		melee.values.push_back(timings.melee);
+		ranged.values.push_back(timings.ranged);
+		healer.values.push_back(timings.healer);
+		projectiles.values.push_back(timings.projectiles);
+		death.values.push_back(timings.death);
+		RTS_PROFILE_FRAME();
+	}
+	double runSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - runStart).count();
+	if (!options.tracePath.empty()) {
+		RTS_PROFILE_END_SESSION();
+	}
+
+	// Report
+	nlohmann::ordered_json report;
+	report["config"] = {
+		{"units_per_faction", options.units},
+		{"factions", options.factions},
+		{"spawned", spawned},
+		{"ticks", options.ticks},
+		{"warmup", options.warmup},
+		{"dt", options.dt},
+		{"layout", options.layout},
+		{"mix", options.mix},
+		{"spacing", options.spacing},
+		{"seed", options.seed},
+		{"march", options.march},
+		{"worker_threads", config["global"].value("worker_threads", 1)},
+		{"grid_backend", config["global"].value("grid_backend", "linked_list")},
+		{"projectile_pool", config["global"].value("projectile_pool", false)}
+	};
+
+	report["systems"]["movement"] = movement.Summary();
+	report["systems"]["targeting"] = targeting.Summary();
+	report["systems"]["melee"] = melee.Summary();
+	report["systems"]["ranged"] = ranged.Summary();
+	report["systems"]["healer"] = healer.Summary();
+	report["systems"]["projectiles"] = projectiles.Summary();
+	report["systems"]["death"] = death.Summary();
+	report["tick"] = tickTotal.Summary();
+	report["ticks_per_second"] = options.ticks / std::max(runSeconds, 1e-9);
+
+	UnitCountData counts = world.GetUnitCounts();
+	for (int faction = 0; faction < options.factions; ++faction) {
+		report["final"]["alive"].push_back(counts.footmanCount[faction] + counts.archerCount[faction] +
+			counts.ballistaCount[faction] + counts.healerCount[faction]);
+	}
+	report["final"]["projectiles"] = counts.projectileCount;
+
+	if (options.outPath.empty()) {
+		std::cout << report.dump(2) << std::endl;
+	} else {
+		std::ofstream out(options.outPath);
+		if (!out.is_open()) {
+			std::cerr << "Failed to open output file: " << options.outPath << std::endl;
+			return 1;
+		}
+		out << report.dump(2) << std::endl;
+	}
+	return 0;
+}
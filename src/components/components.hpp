@@ -214,6 +214,16 @@ struct Selected {
 	}
 };
 
+// Position before the last fixed-step tick of a frame, for render interpolation (World::Step)
+struct PreviousPosition {
+	Vec2 value;
+
+	template<class Archive>
+	void serialize(Archive &archive) {
+		archive(CEREAL_NVP(value));
+	}
+};
+
 // Sprite component for rendering
 struct Sprite {
 	int texture_id;
@@ -10,8 +10,11 @@
 #include "systems/ui_system.hpp"
 #include "utils/resource_loader.hpp"
 #include "utils/time_controller.hpp"
+#include "utils/profiler.hpp"
 
 int main(int argc, char* argv[]) {
+	RTS_PROFILE_THREAD("Main");
+
 	// Set working directory to project root (where data folder is located)
 	if (!ResourceLoader::SetDataDirectory()) {
 		std::cerr << "Warning: Could not find data directory. Trying current directory..." << std::endl;
@@ -27,6 +30,9 @@ int main(int argc, char* argv[]) {
 	// Extract screen dimensions from config
 	int screen_width = config["global"].value("screen_width", 1280);
 	int screen_height = config["global"].value("screen_height", 720);
+
+	// Chrome trace backend: record the whole session (no-op for the other backends)
+	RTS_PROFILE_BEGIN_SESSION(config["global"].value("profile_trace", "profile_trace.json"));
 	
 	// Init SDL
 	if (!SDL_Init(SDL_INIT_VIDEO | SDL_INIT_EVENTS)) {
@@ -77,6 +83,12 @@ int main(int argc, char* argv[]) {
 	UISystem uiSystem;
 	TimeController timeController;
 
+	// Fixed-step simulation: "global.simulation_rate" ticks per second of game time (0 = one variable step per frame)
+	float simulationRate = config["global"].value("simulation_rate", 0.0f);
+	if (simulationRate > 0.0f) {
+		timeController.SetFixedStep(1.0f / simulationRate, config["global"].value("max_ticks_per_frame", 120));
+	}
+
 	bool running = true;
 	SDL_Event event;
 	
@@ -99,7 +111,12 @@ int main(int argc, char* argv[]) {
 
 		// Update systems
 		inputSystem.update(world, dt);
-		world.Update(dt);
+		if (timeController.IsFixedStep()) {
+			world.Step(timeController.GetTickCount(), timeController.GetFixedStep());
+			world.SetInterpolationAlpha(timeController.GetInterpolationAlpha());
+		} else {
+			world.Update(dt);
+		}
 
 		// Render world
 		glClearColor(0.2f, 0.3f, 0.3f, 1.0f);
@@ -111,8 +128,11 @@ int main(int argc, char* argv[]) {
 		ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
 		
 		SDL_GL_SwapWindow(window);
+		RTS_PROFILE_FRAME();
 	}
 
+	RTS_PROFILE_END_SESSION();
+
 	// Cleanup
 	ImGui_ImplOpenGL3_Shutdown();
 	ImGui_ImplSDL3_Shutdown();
@@ -1,46 +1,102 @@
 #include "gameplay_system.hpp"
 #include "../world/spatial_grid.hpp"
+#include "../utils/profiler.hpp"
+#include <chrono>
 #include <iostream>
 
+// Run one pass and return how long it took in milliseconds
+template<typename Func>
+static double timePass(Func&& func) {
+	auto start = std::chrono::steady_clock::now();
+	func();
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
 void GameplaySystem::update(entt::registry& registry, float dt) {
-	update_movement(registry, dt);
-	update_targeting(registry, dt);
-	update_melee_combat(registry, dt);
-	update_ranged_combat(registry, dt);
-	update_healer(registry, dt);
-	update_projectiles(registry, dt);
-	update_death(registry, dt);
+	RTS_PROFILE_SCOPE("GameplaySystem::update");
+	// Create the pools worker threads look entities up in, so lookups never insert into the registry
+	registry.storage<Position>();
+	registry.storage<SpatialNode>();
+	registry.storage<Health>();
+	registry.storage<StateAttackingTag>();
+
+	_timings.movement += timePass([&] { update_movement(registry, dt); });
+	_timings.targeting += timePass([&] { update_targeting(registry, dt); });
+	_timings.melee += timePass([&] { update_melee_combat(registry, dt); });
+	_timings.ranged += timePass([&] { update_ranged_combat(registry, dt); });
+	_timings.healer += timePass([&] { update_healer(registry, dt); });
+	_timings.projectiles += timePass([&] { update_projectiles(registry, dt); });
+	_timings.death += timePass([&] { update_death(registry, dt); });
+	_timings.ticks++;
+}
+
+void GameplaySystem::ChunkWrites::Clear() {
+	grid_moves.clear();
+	requesters.clear();
+	queries.clear();
+	query_results.clear();
+	damage.clear();
+	launches.clear();
+	commands.Clear();
+	scratch.Reset();
+}
+
+size_t GameplaySystem::prepare_chunks(size_t count, size_t chunk_size) {
+	size_t chunk_count = JobSystem::GetChunkCount(count, chunk_size);
+	if (_chunk_writes.size() < chunk_count) {
+		_chunk_writes.resize(chunk_count);
+	}
+	for (size_t chunk = 0; chunk < chunk_count; ++chunk) {
+		_chunk_writes[chunk].Clear();
+	}
+	return chunk_count;
 }
 
 void GameplaySystem::update_movement(entt::registry& registry, float dt) {
+	RTS_PROFILE_SCOPE("Gameplay::Movement");
 	auto view = registry.view<Movement, Position>(entt::exclude<StateAttackingTag>); // Attacking units are not moved
-	
-	for (auto entity : view) {
-		auto& movement = view.get<Movement>(entity);
-		auto& pos = view.get<Position>(entity);
-		
-		// Store old position for grid update
-		Vec2 old_pos = pos.value;
-				
-		// Update position
-		pos.value += movement.velocity * dt;
-		
-		// Update spatial grid if entity has SpatialNode
-		if (registry.all_of<SpatialNode>(entity)) {
-			_spatial_grid.Update(entity, old_pos, pos.value);
+	collect_entities(view);
+	size_t chunk_count = prepare_chunks(_entities.size(), MovementChunkSize);
+
+	// Each entity only writes its own components; grid updates are deferred
+	parallel_for(_entities.size(), MovementChunkSize, [&](size_t begin, size_t end, size_t chunk) {
+		auto& writes = _chunk_writes[chunk];
+		for (size_t i = begin; i < end; ++i) {
+			entt::entity entity = _entities[i];
+			auto& movement = view.get<Movement>(entity);
+			auto& pos = view.get<Position>(entity);
+
+			// Store old position for grid update
+			Vec2 old_pos = pos.value;
+
+			// Update position
+			pos.value += movement.velocity * dt;
+
+			// Update spatial grid if entity has SpatialNode
+			if (registry.all_of<SpatialNode>(entity)) {
+				writes.grid_moves.push_back({entity, old_pos, pos.value});
+			}
+
+			// Check if reached target
+			float dist = Vec2::distance(pos.value, movement.target);
+			if (dist < 0.5f) {
+				// Reached target, stop moving
+				movement.velocity = Vec2{0.0f, 0.0f};
+				movement.target = pos.value;
+			}
 		}
-		
-		// Check if reached target
-		float dist = Vec2::distance(pos.value, movement.target);
-		if (dist < 0.5f) {
-			// Reached target, stop moving
-			movement.velocity = Vec2{0.0f, 0.0f};
-			movement.target = pos.value;
+	});
+
+	// Replay grid updates in view order so the cell lists end up exactly as in a serial run
+	for (size_t chunk = 0; chunk < chunk_count; ++chunk) {
+		for (const auto& move : _chunk_writes[chunk].grid_moves) {
+			_spatial_grid.Update(move.entity, move.old_pos, move.new_pos);
 		}
 	}
 }
 
 void GameplaySystem::update_targeting(entt::registry& registry, float dt) {
+	RTS_PROFILE_SCOPE("Gameplay::Targeting");
 	_targeting_timer += dt;
 	
 	// Only run targeting periodically
@@ -50,195 +106,239 @@ void GameplaySystem::update_targeting(entt::registry& registry, float dt) {
 	_targeting_timer = 0.0f;
 
 	// Update targets for units with DirectDamage (melee units)
-	auto attack_view = registry.view<AttackTarget, Position, Faction, DirectDamage>();
-	for (auto entity : attack_view) {
-		auto& target_comp = attack_view.get<AttackTarget>(entity);
-		const auto& pos = attack_view.get<Position>(entity);
-		const auto& faction = attack_view.get<Faction>(entity);
-		const auto& damage = attack_view.get<DirectDamage>(entity);
-
-		// Check if current target is still valid
-		bool need_new_target = false;
-		if (target_comp.target == entt::null || !registry.valid(target_comp.target)) {
-			need_new_target = true;
-			target_comp.target = entt::null;
-		} else {
-			// Check if target is alive and in range
-			if (registry.all_of<Health, Position>(target_comp.target)) {
-				const auto& target_health = registry.get<Health>(target_comp.target);
-				const auto& target_pos = registry.get<Position>(target_comp.target);
-				
-				if (target_health.current <= 0) {
-					need_new_target = true;
-				} else {
-					float dist = Vec2::distance(pos.value, target_pos.value);
-					if (dist > damage.range) {
-						need_new_target = true;
-					}
-				}
-			} else {
-				need_new_target = true;
+	retarget<DirectDamage>(registry);
+
+	// Update targets for ranged units (ProjectileEmitter)
+	retarget<ProjectileEmitter>(registry);
+}
+
+template<typename Weapon>
+void GameplaySystem::retarget(entt::registry& registry) {
+	auto view = registry.view<AttackTarget, Position, Faction, Weapon>();
+	collect_entities(view);
+	size_t chunk_count = prepare_chunks(_entities.size(), CombatChunkSize);
+
+	// Check current targets in parallel and queue a nearest-enemy query per unit that needs a new one
+	parallel_for(_entities.size(), CombatChunkSize, [&](size_t begin, size_t end, size_t chunk) {
+		auto& writes = _chunk_writes[chunk];
+		for (size_t i = begin; i < end; ++i) {
+			entt::entity entity = _entities[i];
+			auto& target_comp = view.template get<AttackTarget>(entity);
+			const auto& pos = view.template get<Position>(entity);
+			const auto& faction = view.template get<Faction>(entity);
+			const auto& weapon = view.template get<Weapon>(entity);
+
+			if (needs_new_target(registry, target_comp.target, pos.value, weapon.range)) {
+				target_comp.target = entt::null;
+				writes.requesters.push_back(entity);
+				writes.queries.push_back({pos.value, weapon.range, faction.id, false});
 			}
 		}
+	});
 
-		// Find new target if needed
-		if (need_new_target) {
-			entt::entity new_target = _spatial_grid.FindNearest(pos.value, damage.range, faction.id, false);
-			target_comp.target = new_target;
-		}
+	resolve_target_queries(registry, chunk_count);
 
-		// Sync stage attacking tag
-		if (target_comp.target != entt::null) {
-			if (!registry.all_of<StateAttackingTag>(entity)) {
-				registry.emplace<StateAttackingTag>(entity);
-			}
-		} else {
-			if (registry.all_of<StateAttackingTag>(entity)) {
-				registry.remove<StateAttackingTag>(entity);
-			}
+	// Sync stage attacking tag; the tag changes are applied in view order when the chunks are flushed
+	parallel_for(_entities.size(), CombatChunkSize, [&](size_t begin, size_t end, size_t chunk) {
+		auto& writes = _chunk_writes[chunk];
+		for (size_t i = begin; i < end; ++i) {
+			entt::entity entity = _entities[i];
+			sync_attacking_tag(registry, writes.commands, entity, view.template get<AttackTarget>(entity).target);
 		}
+	});
+	flush_chunk_commands(registry, chunk_count);
+}
+
+bool GameplaySystem::needs_new_target(const entt::registry& registry, entt::entity target, const Vec2& pos, float range) const {
+	// Check if current target is still valid
+	if (target == entt::null || !registry.valid(target)) {
+		return true;
 	}
 
-	// Update targets for ranged units (ProjectileEmitter)
-	auto ranged_view = registry.view<AttackTarget, Position, Faction, ProjectileEmitter>();
-	for (auto entity : ranged_view) {
-		auto& target_comp = ranged_view.get<AttackTarget>(entity);
-		const auto& pos = ranged_view.get<Position>(entity);
-		const auto& faction = ranged_view.get<Faction>(entity);
-		const auto& emitter = ranged_view.get<ProjectileEmitter>(entity);
-
-		// Check if current target is still valid
-		bool need_new_target = false;
-		if (target_comp.target == entt::null || !registry.valid(target_comp.target)) {
-			need_new_target = true;
-		} else {
-			// Check if target is alive and in range
-			if (registry.all_of<Health, Position>(target_comp.target)) {
-				const auto& target_health = registry.get<Health>(target_comp.target);
-				const auto& target_pos = registry.get<Position>(target_comp.target);
-				
-				if (target_health.current <= 0) {
-					need_new_target = true;
-				} else {
-					float dist = Vec2::distance(pos.value, target_pos.value);
-					if (dist > emitter.range) {
-						need_new_target = true;
-					}
-				}
-			} else {
-				need_new_target = true;
+	// Check if target is alive and in range
+	if (!registry.all_of<Health, Position>(target)) {
+		return true;
+	}
+	if (registry.get<Health>(target).current <= 0) {
+		return true;
+	}
+	return Vec2::distance(pos, registry.get<Position>(target).value) > range;
+}
+
+void GameplaySystem::resolve_target_queries(entt::registry& registry, size_t chunk_count) {
+	RTS_PROFILE_SCOPE("Gameplay::TargetQueries");
+	// Each chunk's queries are one batch: neighbouring shooters share cell scans, and the
+	// extra candidates are fallbacks, so nothing is re-queried
+	_spatial_grid.PrepareConcurrentQueries();
+	parallel_for(chunk_count, 1, [&](size_t begin, size_t end, size_t) {
+		for (size_t chunk = begin; chunk < end; ++chunk) {
+			auto& writes = _chunk_writes[chunk];
+			_spatial_grid.FindKNearestBatch(writes.queries, TargetCandidates, writes.query_results, &writes.scratch);
+		}
+	});
+
+	for (size_t chunk = 0; chunk < chunk_count; ++chunk) {
+		const auto& writes = _chunk_writes[chunk];
+		for (size_t i = 0; i < writes.requesters.size(); ++i) {
+			entt::entity new_target = entt::null;
+			for (int k = 0; k < TargetCandidates; ++k) {
+				entt::entity candidate = writes.query_results[i * TargetCandidates + k];
+				if (candidate == entt::null) break;
+
+				// Dead units leave the grid in update_death, so the nearest is normally taken
+				if (!registry.valid(candidate)) continue;
+				const auto* health = registry.try_get<Health>(candidate);
+				if (health && health->current <= 0) continue;
+
+				new_target = candidate;
+				break;
 			}
+			registry.get<AttackTarget>(writes.requesters[i]).target = new_target;
 		}
+	}
+}
 
-		// Find new target if needed
-		if (need_new_target) {
-			entt::entity new_target = _spatial_grid.FindNearest(pos.value, emitter.range, faction.id, false);
-			target_comp.target = new_target;
+void GameplaySystem::sync_attacking_tag(const entt::registry& registry, CommandBuffer& commands, entt::entity entity, entt::entity target) const {
+	// Only record actual changes, so units that keep their state cost nothing at flush time
+	bool attacking = registry.all_of<StateAttackingTag>(entity);
+	if (target != entt::null) {
+		if (!attacking) {
+			commands.Emplace<StateAttackingTag>(entity);
 		}
-		
-		// Sync stage attacking tag
-		if (target_comp.target != entt::null) {
-			if (!registry.all_of<StateAttackingTag>(entity)) {
-				registry.emplace<StateAttackingTag>(entity);
-			}
+	} else {
+		if (attacking) {
+			commands.Remove<StateAttackingTag>(entity);
 		}
-		else {
-			if (registry.all_of<StateAttackingTag>(entity)) {
-				registry.remove<StateAttackingTag>(entity);
+	}
+}
+
+void GameplaySystem::flush_chunk_commands(entt::registry& registry, size_t chunk_count) {
+	RTS_PROFILE_SCOPE("Gameplay::FlushCommands");
+	for (size_t chunk = 0; chunk < chunk_count; ++chunk) {
+		_chunk_writes[chunk].commands.Flush(registry);
+	}
+}
+
+void GameplaySystem::apply_damage(entt::registry& registry, size_t chunk_count) {
+	for (size_t chunk = 0; chunk < chunk_count; ++chunk) {
+		for (const auto& write : _chunk_writes[chunk].damage) {
+			auto& health = registry.get<Health>(write.target);
+			if (write.through_shield) {
+				health.Damage(write.amount);
+			} else {
+				health.current -= write.amount;
 			}
 		}
 	}
 }
 
 void GameplaySystem::update_melee_combat(entt::registry& registry, float dt) {
+	RTS_PROFILE_SCOPE("Gameplay::Melee");
 	auto view = registry.view<DirectDamage, AttackTarget, StateAttackingTag, Position, Faction>();
-	
-	for (auto entity : view) {
-		auto& damage_comp = view.get<DirectDamage>(entity);
-		const auto& target_comp = view.get<AttackTarget>(entity);
-		const auto& pos = view.get<Position>(entity);
+	collect_entities(view);
+	size_t chunk_count = prepare_chunks(_entities.size(), CombatChunkSize);
 
-		// Update cooldown timer
-		damage_comp.timer += dt;
+	// Attackers only touch their own timers; damage to targets is deferred
+	parallel_for(_entities.size(), CombatChunkSize, [&](size_t begin, size_t end, size_t chunk) {
+		auto& writes = _chunk_writes[chunk];
+		for (size_t i = begin; i < end; ++i) {
+			entt::entity entity = _entities[i];
+			auto& damage_comp = view.get<DirectDamage>(entity);
+			const auto& target_comp = view.get<AttackTarget>(entity);
+			const auto& pos = view.get<Position>(entity);
+
+			// Update cooldown timer
+			damage_comp.timer += dt;
+
+			// Check if can attack
+			if (damage_comp.timer < damage_comp.cooldown) continue;
 
-		// Check if can attack
-		if (damage_comp.timer >= damage_comp.cooldown) {
 			// Check if has valid target
-			if (target_comp.target != entt::null && registry.valid(target_comp.target)) {
-				if (registry.all_of<Health, Position>(target_comp.target)) {
-					const auto& target_pos = registry.get<Position>(target_comp.target);
-					float dist = Vec2::distance(pos.value, target_pos.value);
-
-					// Check if in range
-					if (dist <= damage_comp.range) {
-						// Deal damage
-						auto& target_health = registry.get<Health>(target_comp.target);
-						target_health.Damage(damage_comp.damage);
-
-						// Reset timer
-						damage_comp.timer = 0.0f;
-					}
-				}
+			if (target_comp.target == entt::null || !registry.valid(target_comp.target)) continue;
+			if (!registry.all_of<Health, Position>(target_comp.target)) continue;
+
+			const auto& target_pos = registry.get<Position>(target_comp.target);
+			float dist = Vec2::distance(pos.value, target_pos.value);
+
+			// Check if in range
+			if (dist <= damage_comp.range) {
+				// Deal damage
+				writes.damage.push_back({target_comp.target, damage_comp.damage, true});
+
+				// Reset timer
+				damage_comp.timer = 0.0f;
 			}
 		}
-	}
+	});
+
+	publish_updates<DirectDamage>(registry, _entities);
+	apply_damage(registry, chunk_count);
 }
 
 void GameplaySystem::update_ranged_combat(entt::registry& registry, float dt) {
+	RTS_PROFILE_SCOPE("Gameplay::Ranged");
 	auto view = registry.view<ProjectileEmitter, AttackTarget, StateAttackingTag, Position, Faction>();
-	
-	for (auto entity : view) {
-		auto& emitter = view.get<ProjectileEmitter>(entity);
-		const auto& target_comp = view.get<AttackTarget>(entity);
-		const auto& pos = view.get<Position>(entity);
-		const auto& faction = view.get<Faction>(entity);
+	collect_entities(view);
+	size_t chunk_count = prepare_chunks(_entities.size(), CombatChunkSize);
 
-		// Update cooldown timer
-		emitter.timer += dt;
+	// Emitters only touch their own timers; projectile creation is deferred
+	parallel_for(_entities.size(), CombatChunkSize, [&](size_t begin, size_t end, size_t chunk) {
+		auto& writes = _chunk_writes[chunk];
+		for (size_t i = begin; i < end; ++i) {
+			entt::entity entity = _entities[i];
+			auto& emitter = view.get<ProjectileEmitter>(entity);
+			const auto& target_comp = view.get<AttackTarget>(entity);
+			const auto& pos = view.get<Position>(entity);
+			const auto& faction = view.get<Faction>(entity);
+
+			// Update cooldown timer
+			emitter.timer += dt;
+
+			// Check if can fire
+			if (emitter.timer < emitter.cooldown) continue;
 
-		// Check if can fire
-		if (emitter.timer >= emitter.cooldown) {
 			// Check if has valid target
-			if (target_comp.target != entt::null && registry.valid(target_comp.target)) {
-				if (registry.all_of<Position>(target_comp.target)) {
-					const auto& target_pos = registry.get<Position>(target_comp.target);
-					float dist = Vec2::distance(pos.value, target_pos.value);
-
-					// Check if in range
-					if (dist <= emitter.range) {
-						// Spawn projectile
-						auto projectile = registry.create();
-						registry.emplace<Position>(projectile, pos.value);
-						
-						bool is_aoe = (emitter.projectile_type == 1);
-						registry.emplace<Projectile>(projectile, 
-							emitter.damage, 
-							faction.id, 
-							is_aoe, 
-							emitter.aoe_radius
-						);
-
-						// Add Movement component for projectile
-						registry.emplace<Movement>(projectile, 
-							Vec2::direction_to(pos.value, target_pos.value) * emitter.projectile_speed, // velocity 
-							target_pos.value,           // target
-							emitter.projectile_speed    // speed
-						);
-
-						// For rendering - create a simple visual
-						// We'll use a small unit-like sprite
-						registry.emplace<Unit>(projectile, UnitType::Footman, faction.id); // Placeholder type
-
-						// Reset timer
-						emitter.timer = 0.0f;
-					}
+			if (target_comp.target == entt::null || !registry.valid(target_comp.target)) continue;
+			if (!registry.all_of<Position>(target_comp.target)) continue;
+
+			const auto& target_pos = registry.get<Position>(target_comp.target);
+			float dist = Vec2::distance(pos.value, target_pos.value);
+
+			// Check if in range
+			if (dist <= emitter.range) {
+				Projectile projectile{emitter.damage, faction.id, emitter.projectile_type == 1, emitter.aoe_radius};
+				Vec2 velocity = Vec2::direction_to(pos.value, target_pos.value) * emitter.projectile_speed;
+
+				if (_use_projectile_pool) {
+					writes.launches.push_back({pos.value, velocity, target_pos.value, emitter.projectile_speed, projectile});
+				} else {
+					// Create projectile; the placeholder Unit gives it a simple visual for rendering
+					writes.commands.Create(
+						Position{pos.value},
+						projectile,
+						Movement{velocity, target_pos.value, emitter.projectile_speed},
+						Unit{UnitType::Footman, faction.id} // Placeholder type
+					);
 				}
+
+				// Reset timer
+				emitter.timer = 0.0f;
 			}
 		}
+	});
+	publish_updates<ProjectileEmitter>(registry, _entities);
+
+	// Create projectiles in view order so entity ids (or pool slots) match a serial run.
+	// Pooled shots wait for the end of the projectile pass: like new entities, they first move next tick.
+	for (size_t chunk = 0; chunk < chunk_count; ++chunk) {
+		const auto& launches = _chunk_writes[chunk].launches;
+		_projectile_launches.insert(_projectile_launches.end(), launches.begin(), launches.end());
 	}
+	flush_chunk_commands(registry, chunk_count);
 }
 
 void GameplaySystem::update_healer(entt::registry& registry, float dt) {
+	RTS_PROFILE_SCOPE("Gameplay::Healer");
 	auto view = registry.view<Healer, Position, Faction>();
 	
 	for (auto entity : view) {
@@ -253,7 +353,7 @@ void GameplaySystem::update_healer(entt::registry& registry, float dt) {
 		if (healer.timer >= healer.cooldown) {
 			// Find all allies in range
 			bool found_allies = false;
-			_spatial_grid.QueryRadius(pos.value, healer.range, [&](entt::entity ally) {
+			_spatial_grid.VisitRadius(pos.value, healer.range, [&](entt::entity ally) {
 				if (registry.valid(ally) && registry.all_of<Health>(ally)) {
 					auto& health = registry.get<Health>(ally);
 					// Only heal if not at full health
@@ -270,57 +370,103 @@ void GameplaySystem::update_healer(entt::registry& registry, float dt) {
 			}
 		}
 	}
+	publish_updates<Healer>(registry, view);
 }
 
 void GameplaySystem::update_projectiles(entt::registry& registry, float dt) {
+	RTS_PROFILE_SCOPE("Gameplay::Projectiles");
 	auto view = registry.view<Projectile, Position, Movement>();
-	
-	std::vector<entt::entity> to_destroy;
+	collect_entities(view);
+	size_t chunk_count = prepare_chunks(_entities.size(), CombatChunkSize);
+
+	// Impacts only read the grid and health; damage and destruction are deferred
+	_spatial_grid.PrepareConcurrentQueries();
+	parallel_for(_entities.size(), CombatChunkSize, [&](size_t begin, size_t end, size_t chunk) {
+		auto& writes = _chunk_writes[chunk];
+		for (size_t i = begin; i < end; ++i) {
+			entt::entity entity = _entities[i];
+			const auto& projectile = view.get<Projectile>(entity);
+			const auto& pos = view.get<Position>(entity);
+			const auto& movement = view.get<Movement>(entity);
+
+			// Check if reached target (movement system handles actual movement)
+			// Movement system stops movement when dist < 0.5f, so we check if state is NotMoving
+			if (!movement.velocity.isZero()) continue;
 
-	for (auto entity : view) {
-		auto& projectile = view.get<Projectile>(entity);
-		const auto& pos = view.get<Position>(entity);
-		const auto& movement = view.get<Movement>(entity);
-
-		// Check if reached target (movement system handles actual movement)
-		// Movement system stops movement when dist < 0.5f, so we check if state is NotMoving
-		if (movement.velocity.isZero()) {
 			// Projectile hit
-			if (projectile.is_aoe) {
-				// AOE damage
-				_spatial_grid.QueryRadius(pos.value, projectile.aoe_radius, [&](entt::entity enemy) {
-					if (registry.valid(enemy) && registry.all_of<Health>(enemy)) {
-						auto& health = registry.get<Health>(enemy);
-						float actual_damage = projectile.damage - health.shield;
-						if (actual_damage > 0) {
-							health.current -= actual_damage;
-						}
-					}
-				}, projectile.faction, false);
-			} else {
-				// Single target damage - find nearest enemy at impact point
-				entt::entity target = _spatial_grid.FindNearest(pos.value, 1.0f, projectile.faction, false);
-				if (target != entt::null && registry.valid(target)) {
-					if (registry.all_of<Health>(target)) {
-						auto& health = registry.get<Health>(target);
-						health.Damage(projectile.damage);
-					}
-				}
-			}
+			projectile_impact(registry, pos.value, projectile, writes.damage);
 
 			// Mark for destruction
-			to_destroy.push_back(entity);
+			writes.commands.Destroy(entity);
 		}
-	}
+	});
+
+	apply_damage(registry, chunk_count);
 
 	// Destroy projectiles that hit
-	registry.destroy(to_destroy.begin(), to_destroy.end());
+	flush_chunk_commands(registry, chunk_count);
+
+	if (_use_projectile_pool) {
+		update_pooled_projectiles(registry, dt);
+	}
+}
+
+void GameplaySystem::update_pooled_projectiles(entt::registry& registry, float dt) {
+	RTS_PROFILE_SCOPE("Gameplay::PooledProjectiles");
+	// Impact times were fixed at launch: only projectiles whose time has come are visited
+	_projectile_hits.clear();
+	_projectile_pool.Advance(dt, _projectile_hits);
+	size_t chunk_count = prepare_chunks(_projectile_hits.size(), CombatChunkSize);
+
+	// Same deferral as the entity pass: impacts read, damage and slot release happen after
+	_spatial_grid.PrepareConcurrentQueries();
+	parallel_for(_projectile_hits.size(), CombatChunkSize, [&](size_t begin, size_t end, size_t chunk) {
+		auto& writes = _chunk_writes[chunk];
+		for (size_t i = begin; i < end; ++i) {
+			uint32_t slot = _projectile_hits[i];
+			projectile_impact(registry, _projectile_pool.GetPosition(slot), _projectile_pool.GetProjectile(slot), writes.damage);
+		}
+	});
+
+	apply_damage(registry, chunk_count);
+
+	// Free the slots from the highest down, so each move-from-last only touches slots still to be kept
+	for (auto it = _projectile_hits.rbegin(); it != _projectile_hits.rend(); ++it) {
+		_projectile_pool.Deactivate(*it);
+	}
+
+	for (const auto& launch : _projectile_launches) {
+		_projectile_pool.Activate(launch);
+	}
+	_projectile_launches.clear();
+}
+
+void GameplaySystem::projectile_impact(entt::registry& registry, const Vec2& pos, const Projectile& projectile, std::vector<DamageWrite>& damage) {
+	if (projectile.is_aoe) {
+		// AOE damage
+		_spatial_grid.VisitRadius(pos, projectile.aoe_radius, [&](entt::entity enemy) {
+			if (registry.valid(enemy) && registry.all_of<Health>(enemy)) {
+				const auto& health = registry.get<Health>(enemy);
+				float actual_damage = projectile.damage - health.shield;
+				if (actual_damage > 0) {
+					damage.push_back({enemy, actual_damage, false});
+				}
+			}
+		}, projectile.faction, false);
+	} else {
+		// Single target damage - find nearest enemy at impact point
+		entt::entity target = _spatial_grid.FindNearest(pos, 1.0f, projectile.faction, false);
+		if (target != entt::null && registry.valid(target)) {
+			if (registry.all_of<Health>(target)) {
+				damage.push_back({target, projectile.damage, true});
+			}
+		}
+	}
 }
 
 void GameplaySystem::update_death(entt::registry& registry, float dt) {
+	RTS_PROFILE_SCOPE("Gameplay::Death");
 	auto view = registry.view<Health>();
-	
-	std::vector<entt::entity> to_destroy;
 
 	for (auto entity : view) {
 		const auto& health = view.get<Health>(entity);
@@ -330,10 +476,10 @@ void GameplaySystem::update_death(entt::registry& registry, float dt) {
 			if (registry.all_of<SpatialNode>(entity)) {
 				_spatial_grid.Remove(entity);
 			}
-			to_destroy.push_back(entity);
+			_commands.Destroy(entity);
 		}
 	}
 
-	registry.destroy(to_destroy.begin(), to_destroy.end());
+	_commands.Flush(registry);
 }
 
@@ -2,17 +2,78 @@
 
 #include <entt/entt.hpp>
 #include "../components/components.hpp"
+#include "../world/spatial_grid.hpp"
+#include "../world/command_buffer.hpp"
+#include "../world/projectile_pool.hpp"
+#include "../utils/frame_arena.hpp"
+#include "../utils/job_system.hpp"
+#include <algorithm>
+#include <vector>
 
-class SpatialGrid;
+// Wall-clock time of each gameplay pass, summed over the updates since the last ResetTimings, in milliseconds
+struct GameplayTimings {
+	double movement = 0.0;
+	double targeting = 0.0;
+	double melee = 0.0;
+	double ranged = 0.0;
+	double healer = 0.0;
+	double projectiles = 0.0;
+	double death = 0.0;
+	int ticks = 0; // Updates summed into the passes above
+
+	double Total() const { return movement + targeting + melee + ranged + healer + projectiles + death; }
+};
 
 class GameplaySystem {
 public:
 	GameplaySystem(SpatialGrid& spatial_grid) : _spatial_grid(spatial_grid) {}
 
+	// Run the parallel passes on this pool (nullptr runs every pass on the calling thread)
+	void SetJobSystem(JobSystem* jobs) { _jobs = jobs; }
+
 	// Update all gameplay systems
 	void update(entt::registry& registry, float dt);
 
+	// Per-pass timings summed over the updates since the last ResetTimings
+	const GameplayTimings& GetTimings() const { return _timings; }
+	void ResetTimings() { _timings = {}; }
+
+	// Fire new projectiles into the ProjectilePool instead of creating projectile entities.
+	// Projectile entities already in the registry keep flying as entities.
+	void EnableProjectilePool(bool enabled) { _use_projectile_pool = enabled; }
+	bool IsProjectilePoolEnabled() const { return _use_projectile_pool; }
+	ProjectilePool& GetProjectilePool() { return _projectile_pool; }
+	const ProjectilePool& GetProjectilePool() const { return _projectile_pool; }
+
 private:
+	// Writes that touch other entities or the grid, recorded by a chunk and applied after the parallel loop
+	struct GridMove {
+		entt::entity entity;
+		Vec2 old_pos;
+		Vec2 new_pos;
+	};
+
+	struct DamageWrite {
+		entt::entity target;
+		float amount;
+		bool through_shield; // true: Health::Damage(amount), false: amount already has the shield removed
+	};
+
+	// One chunk's deferred writes. Chunks are merged in chunk order, which is view order,
+	// so the result is the same as a single-threaded pass for any thread count.
+	struct ChunkWrites {
+		std::vector<GridMove> grid_moves;
+		std::vector<entt::entity> requesters;
+		std::vector<NearestQuery> queries;
+		std::vector<entt::entity> query_results;
+		std::vector<DamageWrite> damage;
+		std::vector<ProjectileLaunch> launches; // Shots into the projectile pool
+		CommandBuffer commands; // Structural changes (tags, projectile creation and destruction)
+		FrameArena scratch{16 * 1024}; // Temporaries of the chunk's spatial queries, reset with the chunk
+
+		void Clear();
+	};
+
 	// Individual system updates
 	void update_movement(entt::registry& registry, float dt);
 	void update_targeting(entt::registry& registry, float dt);
@@ -20,10 +81,81 @@ private:
 	void update_ranged_combat(entt::registry& registry, float dt);
 	void update_healer(entt::registry& registry, float dt);
 	void update_projectiles(entt::registry& registry, float dt);
+	void update_pooled_projectiles(entt::registry& registry, float dt);
 	void update_death(entt::registry& registry, float dt);
 
+	// Targeting helpers - Weapon is DirectDamage or ProjectileEmitter (both have a range)
+	template<typename Weapon>
+	void retarget(entt::registry& registry);
+	bool needs_new_target(const entt::registry& registry, entt::entity target, const Vec2& pos, float range) const;
+	void resolve_target_queries(entt::registry& registry, size_t chunk_count);
+	void sync_attacking_tag(const entt::registry& registry, CommandBuffer& commands, entt::entity entity, entt::entity target) const;
+
+	// Damage of a projectile landing at pos (read-only, safe from several chunks at once)
+	void projectile_impact(entt::registry& registry, const Vec2& pos, const Projectile& projectile, std::vector<DamageWrite>& damage);
+
+	// Merge helpers, run on the calling thread
+	void apply_damage(entt::registry& registry, size_t chunk_count);
+	void flush_chunk_commands(entt::registry& registry, size_t chunk_count);
+
+	// Copy a view's entities so chunks can index them
+	template<typename View>
+	void collect_entities(const View& view) {
+		_entities.clear();
+		for (auto entity : view) {
+			_entities.push_back(entity);
+		}
+	}
+
+	// Publish on_update for entities whose Component was written in place (the delta recorder tracks the
+	// cooldown pools this way); skipped when nothing listens. Call it outside parallel sections.
+	template<typename Component, typename Entities>
+	void publish_updates(entt::registry& registry, const Entities& entities) {
+		if (registry.on_update<Component>().empty()) {
+			return;
+		}
+		for (auto entity : entities) {
+			registry.patch<Component>(entity);
+		}
+	}
+
+	// Clear the write buffers of every chunk for count elements; returns the chunk count
+	size_t prepare_chunks(size_t count, size_t chunk_size);
+
+	// ParallelFor on the job system, or the same chunks in order on this thread
+	template<typename Func>
+	void parallel_for(size_t count, size_t chunk_size, Func&& func) {
+		if (_jobs) {
+			_jobs->ParallelFor(count, chunk_size, func);
+			return;
+		}
+		size_t chunk_count = JobSystem::GetChunkCount(count, chunk_size);
+		for (size_t chunk = 0; chunk < chunk_count; ++chunk) {
+			size_t begin = chunk * chunk_size;
+			func(begin, std::min(begin + chunk_size, count), chunk);
+		}
+	}
+
+	// Nearest enemies fetched per query: the nearest plus a fallback
+	static constexpr int TargetCandidates = 2;
+
+	// Elements per chunk for each parallel pass
+	static constexpr size_t MovementChunkSize = 1024;
+	static constexpr size_t CombatChunkSize = 512;
+
 	SpatialGrid& _spatial_grid;
+	JobSystem* _jobs = nullptr;
+	GameplayTimings _timings;
 	float _targeting_timer = 0.0f;
 	const float _targeting_interval = 1.0f; // Run targeting every second
-};
 
+	// Reused between ticks to avoid per-tick allocations
+	std::vector<entt::entity> _entities;
+	std::vector<ChunkWrites> _chunk_writes;
+	CommandBuffer _commands; // Structural changes from the serial passes
+
+	bool _use_projectile_pool = false;
+	ProjectilePool _projectile_pool;
+	std::vector<ProjectileLaunch> _projectile_launches; // Fired by the ranged pass, activated after the projectile pass
+	std::vector<uint32_t> _projectile_hits;             // Pool slots that hit this tick, ascending
+};
@@ -56,7 +56,7 @@ Vec2 InputSystem::screen_to_world(float screen_x, float screen_y, const Camera&
 	return Vec2{world_x, world_y};
 }
 
-void InputSystem::issue_move_command(entt::registry& registry, const Vec2& click_world_pos) {
+void InputSystem::issue_move_command(entt::registry& registry, const Vec2& click_world_pos, std::pmr::memory_resource* scratch) {
 	// Get all selected units
 	auto selected_view = registry.view<Selected, Position, Movement>();
 	
@@ -66,7 +66,7 @@ void InputSystem::issue_move_command(entt::registry& registry, const Vec2& click
 	float min_y = std::numeric_limits<float>::max();
 	float max_y = std::numeric_limits<float>::lowest();
 	
-	std::vector<entt::entity> selected_units;
+	std::pmr::vector<entt::entity> selected_units(scratch);
 	for (auto entity : selected_view) {
 		const auto& pos = selected_view.get<Position>(entity);
 		selected_units.push_back(entity);
@@ -167,7 +167,7 @@ void InputSystem::update(World& world, float dt) {
 			// If drag distance is small, treat it as a click
 			if (drag_distance < 5.0f) {
 				Vec2 click_world_pos = screen_to_world(_mouse_x, _mouse_y, camera, _screen_width, _screen_height);
-				issue_move_command(registry, click_world_pos);
+				issue_move_command(registry, click_world_pos, &world.GetFrameArena());
 				was_dragging = _is_dragging;
 				was_left_mouse_down = _left_mouse_down;
 				_last_mouse_x = _mouse_x;
@@ -197,21 +197,21 @@ void InputSystem::update(World& world, float dt) {
 				float spacing_x = rect_width / grid_size;
 				float spacing_y = rect_height / grid_size;
 				
-				int spawned = 0;
-				for (int y = 0; y <= grid_size && spawned < _spawn_count; ++y) {
-					for (int x = 0; x <= grid_size && spawned < _spawn_count; ++x) {
-						Vec2 spawn_pos = {
+				std::vector<Vec2> spawn_positions;
+				spawn_positions.reserve(_spawn_count);
+				for (int y = 0; y <= grid_size && static_cast<int>(spawn_positions.size()) < _spawn_count; ++y) {
+					for (int x = 0; x <= grid_size && static_cast<int>(spawn_positions.size()) < _spawn_count; ++x) {
+						spawn_positions.push_back({
 							rect_min.x + x * spacing_x,
 							rect_min.y + y * spacing_y
-						};
-						world.SpawnUnit(_spawn_type, _spawn_faction, spawn_pos);
-						spawned++;
+						});
 					}
 				}
+				world.SpawnUnits(_spawn_type, _spawn_faction, spawn_positions);
 			}
 		} else if (_d_down) {
 			// Delete units in rect
-			spatial_grid.QueryRect(rect_min, rect_max, [&](entt::entity entity) {
+			spatial_grid.VisitRect(rect_min, rect_max, [&](entt::entity entity) {
 				if (registry.valid(entity)) {
 					// Remove from spatial grid before destroying
 					if (registry.all_of<SpatialNode>(entity)) {
@@ -229,7 +229,7 @@ void InputSystem::update(World& world, float dt) {
 			}
 			
 			// Add selection to entities in rect
-			spatial_grid.QueryRect(rect_min, rect_max, [&](entt::entity entity) {
+			spatial_grid.VisitRect(rect_min, rect_max, [&](entt::entity entity) {
 				if (registry.valid(entity) && registry.all_of<Unit>(entity)) {
 					registry.emplace_or_replace<Selected>(entity);
 				}
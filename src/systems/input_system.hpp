@@ -2,6 +2,7 @@
 #include <SDL3/SDL_opengl.h>
 #include <entt/entt.hpp>
 #include "../components/components.hpp"
+#include <memory_resource>
 
 class World;
 
@@ -30,7 +31,7 @@ public:
 
 private:
 	Vec2 screen_to_world(float screen_x, float screen_y, const Camera& camera, int screen_width, int screen_height);
-	void issue_move_command(entt::registry& registry, const Vec2& click_world_pos);
+	void issue_move_command(entt::registry& registry, const Vec2& click_world_pos, std::pmr::memory_resource* scratch);
 	
     bool _left_mouse_down = false;
     bool _right_mouse_down = false;
@@ -1,8 +1,15 @@
 #include "render_system.hpp"
+#include "../utils/profiler.hpp"
 #include "../utils/gl_loader.hpp"
 #include "../utils/resource_loader.hpp"
+#include "../utils/gl_buffer_backend.hpp"
+#include "../world/spatial_grid.hpp"
+#include "../world/projectile_pool.hpp"
 #include "../components/components.hpp"
+#include <cstddef>
+#include <cstring>
 #include <iostream>
+#include <limits>
 #include <array>
 
 // Shader supporting textures and colors
@@ -64,6 +71,48 @@ void main() {
 }
 )";
 
+// Instanced shader: position, scale, UV rect and color come from per-instance attributes
+const char* instanced_vertex_shader_src = R"(
+#version 330 core
+layout (location = 0) in vec2 aPos;
+layout (location = 1) in vec2 aTexCoord;
+layout (location = 2) in vec4 aPosScale; // x, y, scale, unused
+layout (location = 3) in vec4 aUVRect;   // x, y, w, h
+layout (location = 4) in vec4 aColor;
+
+uniform vec2 uOffset;
+uniform float uZoom;
+
+out vec2 TexCoord;
+out vec4 InstanceColor;
+
+void main() {
+    vec2 scaledPos = aPos * aPosScale.z;
+    vec2 worldPos = (scaledPos + aPosScale.xy - uOffset) * uZoom;
+
+    vec2 ndc = worldPos / vec2(640.0, 360.0);
+    gl_Position = vec4(ndc, 0.0, 1.0);
+
+    TexCoord.x = aUVRect.x + (aTexCoord.x * aUVRect.z);
+    TexCoord.y = aUVRect.y + (aTexCoord.y * aUVRect.w);
+    InstanceColor = aColor;
+}
+)";
+
+const char* instanced_fragment_shader_src = R"(
+#version 330 core
+out vec4 FragColor;
+in vec2 TexCoord;
+in vec4 InstanceColor;
+
+uniform sampler2D uTexture;
+
+void main() {
+    FragColor = texture(uTexture, TexCoord) * InstanceColor;
+    if (FragColor.a < 0.1) discard;
+}
+)";
+
 // Line shader for world border
 const char* line_vertex_shader_src = R"(
 #version 330 core
@@ -90,11 +139,34 @@ void main() {
 }
 )";
 
+static unsigned int createShaderProgram(const char* vertexSrc, const char* fragmentSrc) {
+	unsigned int vertexShader = glCreateShader(GL_VERTEX_SHADER);
+	glShaderSource(vertexShader, 1, &vertexSrc, NULL);
+	glCompileShader(vertexShader);
+
+	unsigned int fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
+	glShaderSource(fragmentShader, 1, &fragmentSrc, NULL);
+	glCompileShader(fragmentShader);
+
+	unsigned int program = glCreateProgram();
+	glAttachShader(program, vertexShader);
+	glAttachShader(program, fragmentShader);
+	glLinkProgram(program);
+
+	glDeleteShader(vertexShader);
+	glDeleteShader(fragmentShader);
+
+	return program;
+}
+
 void RenderSystem::init(const nlohmann::json& config) {
 	// Load Config params
+	bool instancingRequested = true;
 	if(config.contains("global")) {
 		_tile_size = config["global"].value("tile_size", 32);
         _unit_size = config["global"].value("unit_size", 2.0f);
+		instancingRequested = config["global"].value("instanced_rendering", true);
+		_culling_enabled = config["global"].value("render_culling", true);
 		
 		// Load world border color (default: green = 0.6)
 		if (config["global"].contains("world_border_color")) {
@@ -111,21 +183,7 @@ void RenderSystem::init(const nlohmann::json& config) {
 	// _terrain_texture = ResourceLoader::load_texture("data/terrain.png"); // Todo: terrain rendering
 
 	// Compile Shaders
-	unsigned int vertexShader = glCreateShader(GL_VERTEX_SHADER);
-	glShaderSource(vertexShader, 1, &vertex_shader_src, NULL);
-	glCompileShader(vertexShader);
-
-	unsigned int fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
-	glShaderSource(fragmentShader, 1, &fragment_shader_src, NULL);
-	glCompileShader(fragmentShader);
-
-	_shader_program = glCreateProgram();
-	glAttachShader(_shader_program, vertexShader);
-	glAttachShader(_shader_program, fragmentShader);
-	glLinkProgram(_shader_program);
-
-	glDeleteShader(vertexShader);
-	glDeleteShader(fragmentShader);
+	_shader_program = createShaderProgram(vertex_shader_src, fragment_shader_src);
 
 	// Setup Quad (Standard 1x1 centered, will scale in shader)
 	// Vertices: x, y, u, v
@@ -184,27 +242,52 @@ void RenderSystem::init(const nlohmann::json& config) {
 
 	// Initialize line rendering pipeline for world border
 	initLinePipeline();
+
+	// Instancing needs GL 3.3 entry points, otherwise keep the per-sprite uniform path
+	_use_instancing = instancingRequested && RTS_GL::glDrawArraysInstanced && RTS_GL::glVertexAttribDivisor &&
+	                  GlBufferBackend::IsSupported();
+
+	// Shared streaming buffer for sprite instances, lines and debug overlays
+	if (GlBufferBackend::IsSupported()) {
+		_stream_backend = std::make_unique<GlBufferBackend>(GL_ARRAY_BUFFER);
+		_stream_ring = std::make_unique<RingBuffer>(*_stream_backend, StreamSegmentSize);
+	}
+
+	if (_use_instancing) {
+		initInstancedPipeline();
+	}
 }
 
-void RenderSystem::initLinePipeline() {
-	// Compile line shaders
-	unsigned int vertexShader = glCreateShader(GL_VERTEX_SHADER);
-	glShaderSource(vertexShader, 1, &line_vertex_shader_src, NULL);
-	glCompileShader(vertexShader);
+void RenderSystem::initInstancedPipeline() {
+	_instanced_shader_program = createShaderProgram(instanced_vertex_shader_src, instanced_fragment_shader_src);
 
-	unsigned int fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
-	glShaderSource(fragmentShader, 1, &line_fragment_shader_src, NULL);
-	glCompileShader(fragmentShader);
+	glGenVertexArrays(1, &_instanced_vao);
 
-	_line_shader_program = glCreateProgram();
-	glAttachShader(_line_shader_program, vertexShader);
-	glAttachShader(_line_shader_program, fragmentShader);
-	glLinkProgram(_line_shader_program);
+	glBindVertexArray(_instanced_vao);
 
-	glDeleteShader(vertexShader);
-	glDeleteShader(fragmentShader);
+	// Per-vertex quad data is shared with the fallback pipeline
+	glBindBuffer(GL_ARRAY_BUFFER, _vbo);
+	glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)0);
+	glEnableVertexAttribArray(0);
+	glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)(2 * sizeof(float)));
+	glEnableVertexAttribArray(1);
+
+	// Per-instance data, advanced once per instance.
+	// Pointers into the ring buffer are set per draw since the offset changes every frame.
+	for (unsigned int attrib = 2; attrib <= 4; ++attrib) {
+		glEnableVertexAttribArray(attrib);
+		RTS_GL::glVertexAttribDivisor(attrib, 1);
+	}
 
-	// Setup line VAO/VBO (will be updated dynamically)
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	glBindVertexArray(0);
+}
+
+void RenderSystem::initLinePipeline() {
+	// Compile line shaders
+	_line_shader_program = createShaderProgram(line_vertex_shader_src, line_fragment_shader_src);
+
+	// Setup line VAO/VBO (static, filled once world bounds are known)
 	glGenVertexArrays(1, &_line_vao);
 	glGenBuffers(1, &_line_vbo);
 
@@ -217,11 +300,44 @@ void RenderSystem::initLinePipeline() {
 
 	glBindBuffer(GL_ARRAY_BUFFER, 0);
 	glBindVertexArray(0);
+
+	// Debug lines stream through the ring buffer, pointer is set per draw
+	glGenVertexArrays(1, &_debug_line_vao);
+	glBindVertexArray(_debug_line_vao);
+	glEnableVertexAttribArray(0);
+	glBindVertexArray(0);
+
+	uploadWorldBorder();
 }
 
 void RenderSystem::SetWorldBounds(int width, int height) {
 	_world_width = width;
 	_world_height = height;
+	uploadWorldBorder();
+}
+
+void RenderSystem::uploadWorldBorder() {
+	if (_line_vbo == 0 || _world_width <= 0 || _world_height <= 0) return;
+
+	// Define border vertices (closed rectangle using LINE_LOOP)
+	float w = static_cast<float>(_world_width);
+	float h = static_cast<float>(_world_height);
+
+	float vertices[] = {
+		0.0f, 0.0f,    // Bottom-left
+		w,    0.0f,    // Bottom-right
+		w,    h,       // Top-right
+		0.0f, h        // Top-left
+	};
+
+	// The border only changes with world bounds, so upload it once
+	glBindBuffer(GL_ARRAY_BUFFER, _line_vbo);
+	glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void RenderSystem::AddDebugLine(const Vec2& from, const Vec2& to, const Color& color) {
+	_debug_lines.push_back({from, to, color});
 }
 
 void RenderSystem::renderWorldBorder(const Vec2& camOffset, float camZoom) {
@@ -240,21 +356,6 @@ void RenderSystem::renderWorldBorder(const Vec2& camOffset, float camZoom) {
 	// Use border color from config
 	glUniform4f(colorLoc, _border_color.r, _border_color.g, _border_color.b, _border_color.a);
 
-	// Define border vertices (closed rectangle using LINE_LOOP)
-	float w = static_cast<float>(_world_width);
-	float h = static_cast<float>(_world_height);
-	
-	float vertices[] = {
-		0.0f, 0.0f,    // Bottom-left
-		w,    0.0f,    // Bottom-right
-		w,    h,       // Top-right
-		0.0f, h        // Top-left
-	};
-
-	// Update VBO with border vertices
-	glBindBuffer(GL_ARRAY_BUFFER, _line_vbo);
-	glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_DYNAMIC_DRAW);
-
 	// Set line width to 2 pixels
 	glLineWidth(2.0f);
 
@@ -266,6 +367,7 @@ void RenderSystem::renderWorldBorder(const Vec2& camOffset, float camZoom) {
 }
 
 void RenderSystem::update(entt::registry& registry) {
+	RTS_PROFILE_SCOPE("RenderSystem::update");
 	// Get Camera
 	auto camView = registry.view<Camera, MainCamera>();
 	Vec2 camOffset = {0.0f, 0.0f};
@@ -281,12 +383,123 @@ void RenderSystem::update(entt::registry& registry) {
 	// Render world border first (behind units)
 	renderWorldBorder(camOffset, camZoom);
 
-	// Setup unit rendering
+	// Collect per-instance sprite data once, both paths draw from it
+	if (_culling_enabled && _spatial_grid) {
+		// Inverse of the vertex shader transform: ndc = (world - offset) * zoom / (640, 360)
+		Vec2 halfExtents = {640.0f / camZoom, 360.0f / camZoom};
+		_sprite_batch.BuildVisible(registry, *_spatial_grid, camOffset - halfExtents, camOffset + halfExtents,
+		                           _atlas_texture, _unitUVs, _faction_colors, _unit_size);
+		if (_projectile_pool) {
+			_sprite_batch.AddProjectiles(*_projectile_pool, camOffset - halfExtents, camOffset + halfExtents,
+			                             _atlas_texture, _unitUVs, _faction_colors, _unit_size);
+		}
+	} else {
+		_sprite_batch.Build(registry, _atlas_texture, _unitUVs, _faction_colors, _unit_size);
+		if (_projectile_pool) {
+			Vec2 everywhere = {std::numeric_limits<float>::max(), std::numeric_limits<float>::max()};
+			_sprite_batch.AddProjectiles(*_projectile_pool, -everywhere, everywhere,
+			                             _atlas_texture, _unitUVs, _faction_colors, _unit_size);
+		}
+	}
+
+	// Write everything streamed this frame before the first draw that reads the ring: without persistent
+	// mapping the segment is unmapped by FinishWrites, and GL rejects draws from a mapped buffer
+	if (_stream_ring) {
+		_stream_ring->BeginFrame();
+		if (_use_instancing) {
+			uploadSpriteInstances();
+		}
+		uploadDebugLines();
+		_stream_ring->FinishWrites();
+	}
+
+	// Enable Alpha Blending
+	glEnable(GL_BLEND);
+	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+	if (_use_instancing) {
+		renderSpritesInstanced(camOffset, camZoom);
+	} else {
+		renderSpritesFallback(camOffset, camZoom);
+	}
+
+	renderDebugLines(camOffset, camZoom);
+
+	// Fence after the draws so the segment is reused only once the GPU has read it
+	if (_stream_ring) {
+		_stream_ring->EndFrame();
+	}
+}
+
+void RenderSystem::uploadSpriteInstances() {
+	_instance_ranges.clear();
+
+	for (const auto& bucket : _sprite_batch.GetBuckets()) {
+		if (bucket.instances.empty()) continue;
+
+		size_t count = bucket.instances.size();
+		RingAllocation allocation = _stream_ring->Allocate(count * sizeof(SpriteInstance), alignof(SpriteInstance));
+		if (!allocation.IsValid()) {
+			// Segment is full this frame (it grows next frame) - upload what still fits
+			count = _stream_ring->GetAvailable(alignof(SpriteInstance)) / sizeof(SpriteInstance);
+			if (count == 0) break;
+			allocation = _stream_ring->Allocate(count * sizeof(SpriteInstance), alignof(SpriteInstance));
+		}
+
+		std::memcpy(allocation.data, bucket.instances.data(), allocation.size);
+		_instance_ranges.push_back({bucket.texture, allocation.offset, count});
+	}
+}
+
+void RenderSystem::uploadDebugLines() {
+	_debug_lines_uploaded = false;
+	if (_debug_lines.empty()) return;
+
+	RingAllocation allocation = _stream_ring->Allocate(_debug_lines.size() * 2 * sizeof(Vec2), alignof(Vec2));
+	if (!allocation.IsValid()) return;
+
+	Vec2* vertices = static_cast<Vec2*>(allocation.data);
+	for (size_t i = 0; i < _debug_lines.size(); ++i) {
+		vertices[i * 2] = _debug_lines[i].from;
+		vertices[i * 2 + 1] = _debug_lines[i].to;
+	}
+	_debug_line_offset = allocation.offset;
+	_debug_lines_uploaded = true;
+}
+
+void RenderSystem::renderSpritesInstanced(const Vec2& camOffset, float camZoom) {
+	RTS_PROFILE_SCOPE("RenderSystem::SpritesInstanced");
+	glUseProgram(_instanced_shader_program);
+	glBindVertexArray(_instanced_vao);
+
+	int offsetLoc = glGetUniformLocation(_instanced_shader_program, "uOffset");
+	int zoomLoc = glGetUniformLocation(_instanced_shader_program, "uZoom");
+	glUniform2f(offsetLoc, camOffset.x, camOffset.y);
+	glUniform1f(zoomLoc, camZoom);
+
+	glBindBuffer(GL_ARRAY_BUFFER, _stream_ring->GetBufferId());
+
+	// One draw call per texture, from the ranges uploaded this frame
+	for (const InstanceRange& range : _instance_ranges) {
+		::glBindTexture(GL_TEXTURE_2D, range.texture);
+
+		const char* base = reinterpret_cast<const char*>(range.offset);
+		glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, sizeof(SpriteInstance), base + offsetof(SpriteInstance, x));
+		glVertexAttribPointer(3, 4, GL_FLOAT, GL_FALSE, sizeof(SpriteInstance), base + offsetof(SpriteInstance, uv));
+		glVertexAttribPointer(4, 4, GL_FLOAT, GL_FALSE, sizeof(SpriteInstance), base + offsetof(SpriteInstance, color));
+
+		RTS_GL::glDrawArraysInstanced(GL_TRIANGLE_FAN, 0, 4, static_cast<GLsizei>(range.count));
+	}
+
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	glBindVertexArray(0);
+	glUseProgram(0);
+}
+
+void RenderSystem::renderSpritesFallback(const Vec2& camOffset, float camZoom) {
+	RTS_PROFILE_SCOPE("RenderSystem::SpritesFallback");
 	glUseProgram(_shader_program);
 	glBindVertexArray(_vao);
-	
-	// Bind Texture
-	::glBindTexture(GL_TEXTURE_2D, _atlas_texture);
 
 	int offsetLoc = glGetUniformLocation(_shader_program, "uOffset");
 	int zoomLoc = glGetUniformLocation(_shader_program, "uZoom");
@@ -298,51 +511,67 @@ void RenderSystem::update(entt::registry& registry) {
 	glUniform2f(offsetLoc, camOffset.x, camOffset.y);
 	glUniform1f(zoomLoc, camZoom);
 
-	// Enable Alpha Blending
-	glEnable(GL_BLEND);
-	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	// One draw call per sprite
+	for (const auto& bucket : _sprite_batch.GetBuckets()) {
+		::glBindTexture(GL_TEXTURE_2D, bucket.texture);
 
-	// Render all entities with Position and Unit components
-	auto view = registry.view<Position, Unit>();
-	for (auto entity : view) {
-		const auto& pos = view.get<Position>(entity);
-		const auto& unit = view.get<Unit>(entity);
-		
-		// Safety check for indices
-		int typeIdx = static_cast<int>(unit.type);
-		int factionIdx = unit.faction;
+		for (const auto& instance : bucket.instances) {
+			glUniform2f(objPosLoc, instance.x, instance.y);
+			glUniform2f(objScaleLoc, instance.scale, instance.scale);
 
-		if (typeIdx < 0 || typeIdx >= _unitUVs.size()) typeIdx = 0;
-		if (factionIdx < 0 || factionIdx >= _faction_colors.size()) factionIdx = 0;
+			// uUVRect: x, y, w, h
+			glUniform4f(uvRectLoc, instance.uv.x, instance.uv.y, instance.uv.w, instance.uv.h);
 
-		const auto& uv = _unitUVs[typeIdx];
-		Color color = _faction_colors[factionIdx];
-		
-		// Highlight selected units (make them brighter/white tint)
-		if (registry.all_of<Selected>(entity)) {
-			color.r = (color.r + 1.0f) * 0.5f; // Brighten
-			color.g = (color.g + 1.0f) * 0.5f;
-			color.b = (color.b + 1.0f) * 0.5f;
+			// Color
+			glUniform4f(colorLoc, instance.color.r, instance.color.g, instance.color.b, instance.color.a);
+
+			glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
 		}
+	}
 
-		glUniform2f(objPosLoc, pos.value.x, pos.value.y);
-		
-		// Projectiles should be smaller
-		float size = _unit_size;
-		if (registry.all_of<Projectile>(entity)) {
-			size = _unit_size * 0.3f;
+	glBindVertexArray(0);
+	glUseProgram(0);
+}
+
+void RenderSystem::renderDebugLines(const Vec2& camOffset, float camZoom) {
+	if (_debug_lines.empty()) return;
+	if (!_debug_lines_uploaded) {
+		_debug_lines.clear();
+		return;
+	}
+
+	glUseProgram(_line_shader_program);
+	glBindVertexArray(_debug_line_vao);
+
+	int offsetLoc = glGetUniformLocation(_line_shader_program, "uOffset");
+	int zoomLoc = glGetUniformLocation(_line_shader_program, "uZoom");
+	int colorLoc = glGetUniformLocation(_line_shader_program, "uColor");
+	glUniform2f(offsetLoc, camOffset.x, camOffset.y);
+	glUniform1f(zoomLoc, camZoom);
+
+	glBindBuffer(GL_ARRAY_BUFFER, _stream_ring->GetBufferId());
+	glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(Vec2), reinterpret_cast<const void*>(_debug_line_offset));
+
+	glLineWidth(1.0f);
+
+	// Draw runs of same-colored lines with one call each
+	size_t first = 0;
+	while (first < _debug_lines.size()) {
+		const Color& color = _debug_lines[first].color;
+		size_t last = first + 1;
+		while (last < _debug_lines.size() && std::memcmp(&_debug_lines[last].color, &color, sizeof(Color)) == 0) {
+			++last;
 		}
-		glUniform2f(objScaleLoc, size, size);
-		
-		// uUVRect: x, y, w, h
-		glUniform4f(uvRectLoc, uv.x, uv.y, uv.w, uv.h);
-		
-		// Color
-		glUniform4f(colorLoc, color.r, color.g, color.b, color.a);
 
-		glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
+		glUniform4f(colorLoc, color.r, color.g, color.b, color.a);
+		glDrawArrays(GL_LINES, static_cast<GLint>(first * 2), static_cast<GLsizei>((last - first) * 2));
+		first = last;
 	}
-	
+
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
 	glBindVertexArray(0);
 	glUseProgram(0);
+
+	// Debug lines are immediate mode - queue again every frame
+	_debug_lines.clear();
 }
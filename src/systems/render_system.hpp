@@ -3,7 +3,14 @@
 #include <entt/entt.hpp>
 #include <nlohmann/json.hpp>
 #include <vector>
+#include <memory>
 #include "../components/components.hpp"
+#include "sprite_batch.hpp"
+#include "../utils/ring_buffer.hpp"
+#include "../utils/gpu_buffer_backend.hpp"
+
+class SpatialGrid;
+class ProjectilePool;
 
 class RenderSystem {
 public:
@@ -12,24 +19,87 @@ public:
 	
 	// Set world dimensions for border rendering
 	void SetWorldBounds(int width, int height);
+
+	// Spatial grid used to cull units outside the camera view (nullptr draws everything)
+	void SetSpatialGrid(const SpatialGrid* spatial_grid) { _spatial_grid = spatial_grid; }
+
+	// Projectiles flying outside the registry, drawn after the entities (nullptr draws none)
+	void SetProjectilePool(const ProjectilePool* projectile_pool) { _projectile_pool = projectile_pool; }
+
+	// Draw units this far from their PreviousPosition to their Position (1 = current positions)
+	void SetInterpolationAlpha(float alpha) { _sprite_batch.SetInterpolationAlpha(alpha); }
+
+	// Farthest a unit or projectile moves in one tick, so culling keeps sprites drawn behind their position
+	void SetMaxTickMovement(float distance) { _sprite_batch.SetMaxTickMovement(distance); }
 	
 	const std::vector<Color>& GetFactionColors() const { return _faction_colors; }
+
+	// True when sprites are drawn with one instanced call per texture
+	bool IsInstancingEnabled() const { return _use_instancing; }
+
+	// Queue a world-space line for this frame's debug overlay
+	void AddDebugLine(const Vec2& from, const Vec2& to, const Color& color);
 	
 private:
+	struct DebugLine {
+		Vec2 from;
+		Vec2 to;
+		Color color;
+	};
+
+	// Instances of one texture written to the stream ring, drawn with one instanced call
+	struct InstanceRange {
+		unsigned int texture;
+		size_t offset; // Byte offset in the ring buffer
+		size_t count;
+	};
+
+	// Initial size of one ring segment, grows on demand
+	static constexpr size_t StreamSegmentSize = 4 * 1024 * 1024;
+
 	void initLinePipeline();
+	void initInstancedPipeline();
+	void uploadWorldBorder();
 	void renderWorldBorder(const Vec2& camOffset, float camZoom);
+	void uploadSpriteInstances();
+	void uploadDebugLines();
+	void renderDebugLines(const Vec2& camOffset, float camZoom);
+	void renderSpritesInstanced(const Vec2& camOffset, float camZoom);
+	void renderSpritesFallback(const Vec2& camOffset, float camZoom);
 
 	unsigned int _vao = 0;
 	unsigned int _vbo = 0;
 	unsigned int _shader_program = 0;
 	unsigned int _atlas_texture = 0;
 	unsigned int _terrain_texture = 0;
+
+	// Instanced sprite rendering resources
+	bool _use_instancing = false;
+	unsigned int _instanced_vao = 0;
+	unsigned int _instanced_shader_program = 0;
+	SpriteBatch _sprite_batch;
+
+	// Triple-buffered streaming storage shared by sprites, lines and debug overlays
+	std::unique_ptr<GpuBufferBackend> _stream_backend;
+	std::unique_ptr<RingBuffer> _stream_ring;
+	unsigned int _debug_line_vao = 0;
+	std::vector<DebugLine> _debug_lines;
+
+	// Where this frame's streamed data landed in the ring; filled before the first draw reads it
+	std::vector<InstanceRange> _instance_ranges;
+	size_t _debug_line_offset = 0;
+	bool _debug_lines_uploaded = false;
 	
 	// Line rendering resources
 	unsigned int _line_vao = 0;
 	unsigned int _line_vbo = 0;
 	unsigned int _line_shader_program = 0;
 	
+	// Camera culling
+	const SpatialGrid* _spatial_grid = nullptr;
+	const ProjectilePool* _projectile_pool = nullptr;
+	bool _culling_enabled = true;
+
 	// World bounds
 	int _world_width = 0;
 	int _world_height = 0;
@@ -0,0 +1,170 @@
+#include "sprite_batch.hpp"
+#include "../world/spatial_grid.hpp"
+#include "../world/projectile_pool.hpp"
+
+void SpriteBatch::Clear() {
+	for (auto& bucket : _buckets) {
+		bucket.instances.clear();
+	}
+}
+
+void SpriteBatch::Add(unsigned int texture, const SpriteInstance& instance) {
+	getInstances(texture).push_back(instance);
+}
+
+std::vector<SpriteInstance>& SpriteBatch::getInstances(unsigned int texture) {
+	// Only a handful of textures exist, linear search is faster than a map
+	for (auto& bucket : _buckets) {
+		if (bucket.texture == texture) {
+			return bucket.instances;
+		}
+	}
+
+	_buckets.emplace_back();
+	_buckets.back().texture = texture;
+	return _buckets.back().instances;
+}
+
+Vec2 SpriteBatch::drawPosition(entt::registry& registry, entt::entity entity, const Vec2& pos) const {
+	if (_alpha >= 1.0f) {
+		return pos;
+	}
+	const auto* previous = registry.try_get<PreviousPosition>(entity);
+	return previous ? previous->value + (pos - previous->value) * _alpha : pos;
+}
+
+SpriteInstance SpriteBatch::makeInstance(entt::registry& registry, entt::entity entity, const Vec2& pos, const Unit& unit,
+                                         const std::vector<UVRect>& unitUVs, const std::vector<Color>& factionColors,
+                                         float unitSize) const {
+	// Safety check for indices
+	int typeIdx = static_cast<int>(unit.type);
+	int factionIdx = unit.faction;
+
+	if (typeIdx < 0 || typeIdx >= static_cast<int>(unitUVs.size())) typeIdx = 0;
+	if (factionIdx < 0 || factionIdx >= static_cast<int>(factionColors.size())) factionIdx = 0;
+
+	Vec2 draw = drawPosition(registry, entity, pos);
+	SpriteInstance instance;
+	instance.x = draw.x;
+	instance.y = draw.y;
+	instance.padding = 0.0f;
+	instance.uv = unitUVs[typeIdx];
+	instance.color = factionColors[factionIdx];
+
+	// Highlight selected units (make them brighter/white tint)
+	if (registry.all_of<Selected>(entity)) {
+		instance.color.r = (instance.color.r + 1.0f) * 0.5f;
+		instance.color.g = (instance.color.g + 1.0f) * 0.5f;
+		instance.color.b = (instance.color.b + 1.0f) * 0.5f;
+	}
+
+	// Projectiles should be smaller
+	instance.scale = unitSize;
+	if (registry.all_of<Projectile>(entity)) {
+		instance.scale = unitSize * 0.3f;
+	}
+
+	return instance;
+}
+
+void SpriteBatch::Build(entt::registry& registry, unsigned int texture, const std::vector<UVRect>& unitUVs,
+                        const std::vector<Color>& factionColors, float unitSize) {
+	Clear();
+	if (unitUVs.empty() || factionColors.empty()) {
+		return;
+	}
+
+	auto view = registry.view<Position, Unit>();
+	auto& instances = getInstances(texture);
+	instances.reserve(view.size_hint());
+
+	for (auto entity : view) {
+		const auto& pos = view.get<Position>(entity);
+		const auto& unit = view.get<Unit>(entity);
+		instances.push_back(makeInstance(registry, entity, pos.value, unit, unitUVs, factionColors, unitSize));
+	}
+}
+
+void SpriteBatch::BuildVisible(entt::registry& registry, const SpatialGrid& grid, const Vec2& viewMin, const Vec2& viewMax,
+                               unsigned int texture, const std::vector<UVRect>& unitUVs,
+                               const std::vector<Color>& factionColors, float unitSize) {
+	Clear();
+	if (unitUVs.empty() || factionColors.empty()) {
+		return;
+	}
+
+	auto& instances = getInstances(texture);
+
+	// Grow the rect by half a sprite so units straddling the screen edge are kept
+	Vec2 margin = {unitSize * 0.5f, unitSize * 0.5f};
+	Vec2 cullMin = viewMin - margin;
+	Vec2 cullMax = viewMax + margin;
+
+	// The grid holds current positions, but sprites are drawn up to one tick behind them
+	float reach = _alpha < 1.0f ? _maxTickMovement : 0.0f;
+	Vec2 queryMin = cullMin - Vec2{reach, reach};
+	Vec2 queryMax = cullMax + Vec2{reach, reach};
+
+	// Units: only the cells under the camera
+	for (entt::entity entity : grid.QueryCells(queryMin, queryMax)) {
+		const auto* pos = registry.try_get<Position>(entity);
+		const auto* unit = registry.try_get<Unit>(entity);
+		if (!pos || !unit) continue;
+
+		// Edge cells also hold clamped out-of-world units, so test where the sprite is drawn exactly
+		if (!Vec2::point_in_rect(drawPosition(registry, entity, pos->value), cullMin, cullMax)) continue;
+
+		instances.push_back(makeInstance(registry, entity, pos->value, *unit, unitUVs, factionColors, unitSize));
+	}
+
+	// Projectiles never enter the grid
+	auto projectileView = registry.view<Projectile, Position, Unit>();
+	for (auto entity : projectileView) {
+		const auto& pos = projectileView.get<Position>(entity);
+		if (!Vec2::point_in_rect(drawPosition(registry, entity, pos.value), cullMin, cullMax)) continue;
+
+		const auto& unit = projectileView.get<Unit>(entity);
+		instances.push_back(makeInstance(registry, entity, pos.value, unit, unitUVs, factionColors, unitSize));
+	}
+}
+
+void SpriteBatch::AddProjectiles(const ProjectilePool& pool, const Vec2& viewMin, const Vec2& viewMax,
+                                 unsigned int texture, const std::vector<UVRect>& unitUVs,
+                                 const std::vector<Color>& factionColors, float unitSize) {
+	if (unitUVs.empty() || factionColors.empty()) {
+		return;
+	}
+
+	auto& instances = getInstances(texture);
+	Vec2 margin = {unitSize * 0.5f, unitSize * 0.5f};
+	Vec2 cullMin = viewMin - margin;
+	Vec2 cullMax = viewMax + margin;
+
+	for (size_t i = 0; i < pool.GetCount(); ++i) {
+		Vec2 pos = pool.GetPosition(i);
+		Vec2 previous = pool.GetPreviousPosition(i);
+		Vec2 draw = _alpha >= 1.0f ? pos : previous + (pos - previous) * _alpha;
+		if (!Vec2::point_in_rect(draw, cullMin, cullMax)) continue;
+
+		// Same look as a projectile entity: placeholder Footman sprite at 0.3 scale
+		int factionIdx = pool.GetFaction(i);
+		if (factionIdx < 0 || factionIdx >= static_cast<int>(factionColors.size())) factionIdx = 0;
+
+		SpriteInstance instance;
+		instance.x = draw.x;
+		instance.y = draw.y;
+		instance.scale = unitSize * 0.3f;
+		instance.padding = 0.0f;
+		instance.uv = unitUVs[static_cast<int>(UnitType::Footman)];
+		instance.color = factionColors[factionIdx];
+		instances.push_back(instance);
+	}
+}
+
+size_t SpriteBatch::GetInstanceCount() const {
+	size_t count = 0;
+	for (const auto& bucket : _buckets) {
+		count += bucket.instances.size();
+	}
+	return count;
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <entt/entt.hpp>
+#include <vector>
+#include "../components/components.hpp"
+
+class SpatialGrid;
+class ProjectilePool;
+
+// Per-instance data for instanced sprite rendering.
+// Layout must match the instanced vertex attributes set up in RenderSystem (3 x vec4).
+struct SpriteInstance {
+	float x, y;    // World position
+	float scale;   // Quad size in world units
+	float padding; // Keeps uv and color 16-byte aligned
+	UVRect uv;
+	Color color;
+};
+
+// All instances sharing one texture - drawn with a single instanced call
+struct SpriteBatchBucket {
+	unsigned int texture = 0;
+	std::vector<SpriteInstance> instances;
+};
+
+// CPU-side builder for per-frame sprite instance data.
+// Has no GL dependencies so it can be benchmarked headless.
+class SpriteBatch {
+public:
+	// Reset instance counts but keep allocated capacity between frames
+	void Clear();
+
+	// Append an instance to the bucket of the given texture
+	void Add(unsigned int texture, const SpriteInstance& instance);
+
+	// Collect one instance for every entity with Position and Unit
+	void Build(entt::registry& registry, unsigned int texture, const std::vector<UVRect>& unitUVs,
+	           const std::vector<Color>& factionColors, float unitSize);
+
+	// Same as Build, but only for entities drawn inside a world-space rectangle (tested on the
+	// interpolated position). Units are fetched from the spatial grid cells overlapping the rect, so cost
+	// scales with what is visible. Projectiles are not in the grid and are tested directly.
+	void BuildVisible(entt::registry& registry, const SpatialGrid& grid, const Vec2& viewMin, const Vec2& viewMax,
+	                  unsigned int texture, const std::vector<UVRect>& unitUVs,
+	                  const std::vector<Color>& factionColors, float unitSize);
+
+	// Append the pooled projectiles inside a world-space rectangle, drawn like projectile entities
+	void AddProjectiles(const ProjectilePool& pool, const Vec2& viewMin, const Vec2& viewMax,
+	                    unsigned int texture, const std::vector<UVRect>& unitUVs,
+	                    const std::vector<Color>& factionColors, float unitSize);
+
+	// Blend between PreviousPosition and Position for entities that have both (1 = Position only)
+	void SetInterpolationAlpha(float alpha) { _alpha = alpha; }
+
+	// Farthest an entity can move in one tick. While interpolating, the culling query grows by this
+	// much so units drawn inside the view but already stepped out of it are still found.
+	void SetMaxTickMovement(float distance) { _maxTickMovement = distance; }
+
+	const std::vector<SpriteBatchBucket>& GetBuckets() const { return _buckets; }
+
+	// Total number of instances over all buckets
+	size_t GetInstanceCount() const;
+
+private:
+	// Get (or create) the instance list for a texture
+	std::vector<SpriteInstance>& getInstances(unsigned int texture);
+
+	// Fill an instance from unit data (selection tint, projectile size)
+	SpriteInstance makeInstance(entt::registry& registry, entt::entity entity, const Vec2& pos, const Unit& unit,
+	                            const std::vector<UVRect>& unitUVs, const std::vector<Color>& factionColors,
+	                            float unitSize) const;
+
+	// Interpolated draw position of an entity at pos
+	Vec2 drawPosition(entt::registry& registry, entt::entity entity, const Vec2& pos) const;
+
+	std::vector<SpriteBatchBucket> _buckets;
+	float _alpha = 1.0f;
+	float _maxTickMovement = 0.0f;
+};
@@ -1,12 +1,15 @@
 #include "ui_system.hpp"
 #include "input_system.hpp"
 #include "../utils/time_controller.hpp"
+#include "../utils/allocation_stats.hpp"
 #include <backends/imgui_impl_sdl3.h>
 #include <backends/imgui_impl_opengl3.h>
+#include <algorithm>
+#include <cfloat>
+#include <cstdio>
 #include <cstring>
 #include <cmath>
-#include <sstream>
-#include <iomanip>
+#include <memory_resource>
 
 void UISystem::Render(World& world, InputSystem& inputSystem, float dt, TimeController& timeController) {
 	// UI Frame
@@ -14,7 +17,10 @@ void UISystem::Render(World& world, InputSystem& inputSystem, float dt, TimeCont
 	ImGui_ImplSDL3_NewFrame();
 	ImGui::NewFrame();
 
+	recordPerformance(world);
+
 	renderDebugWindow(world, dt, timeController);
+	renderPerformanceWindow(world);
 	renderSelectionWindow(world);
 	renderSelectionRect(world, inputSystem);
 
@@ -56,6 +62,10 @@ void UISystem::renderDebugWindow(World& world, float dt, TimeController& timeCon
 	// Display current speed value as text
 	ImGui::SameLine();
 	ImGui::Text("(%.2fx)", speedValues[speedSliderValue]);
+	if (timeController.IsFixedStep()) {
+		ImGui::Text("Fixed step %.1f ms: %d ticks this frame, %llu dropped", timeController.GetFixedStep() * 1000.0f,
+			timeController.GetTickCount(), static_cast<unsigned long long>(timeController.GetDroppedTicks()));
+	}
 	
 	ImGui::Separator();
 	
@@ -101,11 +111,28 @@ void UISystem::renderDebugWindow(World& world, float dt, TimeController& timeCon
 	if (ImGui::InputText("File Path", filePathBuffer, sizeof(filePathBuffer))) {
 		_saveFilePath = std::string(filePathBuffer);
 	}
-	
+	ImGui::TextDisabled(".bin: binary archive, .snap: mapped snapshot, .snapz: compressed snapshot, anything else: JSON");
+	
+	// Save runs in the background; the frame only pays for copying the pools
+	const SaveStatus& saveStatus = world.PollSave();
+	bool saving = saveStatus.state == SaveStatus::State::Saving;
+	if (_saveInProgress && !saving) {
+		_saveInProgress = false;
+		char message[128];
+		if (saveStatus.state == SaveStatus::State::Saved) {
+			std::snprintf(message, sizeof(message), "Game saved successfully! (pause %.2f ms, write %.1f ms)", saveStatus.captureMs, saveStatus.writeMs);
+			_saveLoadStatus = message;
+		} else {
+			_saveLoadStatus = "Error: Failed to save game.";
+		}
+	}
+
 	// Save and Load buttons
+	ImGui::BeginDisabled(saving);
 	if (ImGui::Button("Save Game")) {
-		if (world.SaveGame(_saveFilePath)) {
-			_saveLoadStatus = "Game saved successfully!";
+		if (world.SaveGameAsync(_saveFilePath)) {
+			_saveInProgress = true;
+			_saveLoadStatus = "Saving...";
 		} else {
 			_saveLoadStatus = "Error: Failed to save game.";
 		}
@@ -120,6 +147,7 @@ void UISystem::renderDebugWindow(World& world, float dt, TimeController& timeCon
 			_saveLoadStatus = "Error: Failed to load game.";
 		}
 	}
+	ImGui::EndDisabled();
 	
 	// Status message
 	if (!_saveLoadStatus.empty()) {
@@ -134,6 +162,143 @@ void UISystem::renderDebugWindow(World& world, float dt, TimeController& timeCon
 	ImGui::End();
 }
 
+// Gameplay pass names, in GameplayTimings order
+static const char* const PassNames[] = {"Movement", "Targeting", "Melee", "Ranged", "Healer", "Projectiles", "Death"};
+
+void UISystem::recordPerformance(World& world) {
+	// Allocations on any thread since the previous frame's sample
+	size_t allocationTotal = AllocationStats::GetTotal();
+	size_t allocations = _lastAllocationTotal > 0 ? allocationTotal - _lastAllocationTotal : 0;
+	_lastAllocationTotal = allocationTotal;
+
+	if (_perfPaused) {
+		return;
+	}
+
+	const GameplayTimings& timings = world.GetGameplaySystem().GetTimings();
+	const double passes[PassCount] = {timings.movement, timings.targeting, timings.melee, timings.ranged,
+		timings.healer, timings.projectiles, timings.death};
+	for (int i = 0; i < PassCount; ++i) {
+		_passHistory[i].Push(static_cast<float>(passes[i]));
+	}
+	_gameplayHistory.Push(static_cast<float>(timings.Total()));
+	_tickHistory.Push(static_cast<float>(timings.ticks));
+	_frameHistory.Push(ImGui::GetIO().DeltaTime * 1000.0f); // Real frame time, independent of the game speed
+	_allocationHistory.Push(static_cast<float>(allocations));
+}
+
+void UISystem::renderPerformanceWindow(World& world) {
+	if (!ImGui::Begin("Performance")) {
+		ImGui::End();
+		return;
+	}
+
+	ImGui::Checkbox("Pause history", &_perfPaused);
+	ImGui::SameLine();
+	ImGui::Text("(%d frames)", _frameHistory.GetCount());
+
+	// Rolling plot with "last / avg / max" as the overlay
+	char overlay[96];
+	auto plot = [&overlay](const char* label, const SampleHistory& history, const char* unit, float scaleMax) {
+		std::snprintf(overlay, sizeof(overlay), "%.2f %s (avg %.2f, max %.2f)",
+			history.GetLatest(), unit, history.GetAverage(), history.GetMax());
+		ImGui::PlotLines(label, history.GetData(), history.GetCount(), history.GetOffset(), overlay, 0.0f, scaleMax, ImVec2(0.0f, 50.0f));
+	};
+
+	plot("Frame", _frameHistory, "ms", FLT_MAX);
+	plot("Gameplay", _gameplayHistory, "ms", FLT_MAX);
+	plot("Ticks", _tickHistory, "/frame", FLT_MAX);
+	if (AllocationStats::IsEnabled()) {
+		plot("Allocations", _allocationHistory, "/frame", FLT_MAX);
+	}
+
+	// Per-pass breakdown; the pass that dominated the worst gameplay frame in the window is highlighted
+	int worst = _gameplayHistory.GetMaxIndex();
+	int worstPass = -1;
+	if (worst >= 0) {
+		for (int i = 0; i < PassCount; ++i) {
+			if (worstPass < 0 || _passHistory[i].Get(worst) > _passHistory[worstPass].Get(worst)) {
+				worstPass = i;
+			}
+		}
+		ImGui::Text("Worst frame: %.2f ms over %.0f ticks, %d frames ago, mostly %s",
+			_gameplayHistory.Get(worst), _tickHistory.Get(worst), _gameplayHistory.GetCount() - 1 - worst, PassNames[worstPass]);
+	}
+
+	if (ImGui::BeginTable("Passes", 5, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+		ImGui::TableSetupColumn("Pass");
+		ImGui::TableSetupColumn("Last ms");
+		ImGui::TableSetupColumn("Avg ms");
+		ImGui::TableSetupColumn("Max ms");
+		ImGui::TableSetupColumn("Worst frame ms");
+		ImGui::TableHeadersRow();
+
+		for (int i = 0; i < PassCount; ++i) {
+			const SampleHistory& history = _passHistory[i];
+			ImGui::TableNextRow();
+			if (i == worstPass) {
+				ImGui::TableSetBgColor(ImGuiTableBgTarget_RowBg1, IM_COL32(120, 30, 30, 255));
+			}
+			ImGui::TableNextColumn();
+			ImGui::TextUnformatted(PassNames[i]);
+			ImGui::TableNextColumn();
+			ImGui::Text("%.3f", history.GetLatest());
+			ImGui::TableNextColumn();
+			ImGui::Text("%.3f", history.GetAverage());
+			ImGui::TableNextColumn();
+			ImGui::Text("%.3f", history.GetMax());
+			ImGui::TableNextColumn();
+			ImGui::Text("%.3f", worst >= 0 ? history.Get(worst) : 0.0f);
+		}
+		ImGui::EndTable();
+	}
+
+	if (ImGui::CollapsingHeader("Pass history")) {
+		// Shared scale so the passes compare at a glance
+		float scaleMax = std::max(_gameplayHistory.GetMax(), 0.001f);
+		for (int i = 0; i < PassCount; ++i) {
+			plot(PassNames[i], _passHistory[i], "ms", scaleMax);
+		}
+	}
+
+	if (ImGui::CollapsingHeader("Entities", ImGuiTreeNodeFlags_DefaultOpen)) {
+		UnitCountData counts = world.GetUnitCounts();
+		int footmen = 0, archers = 0, ballistas = 0, healers = 0;
+		for (int f = 0; f < 8; ++f) {
+			footmen += counts.footmanCount[f];
+			archers += counts.archerCount[f];
+			ballistas += counts.ballistaCount[f];
+			healers += counts.healerCount[f];
+		}
+		ImGui::Text("Footman: %d  Archer: %d  Ballista: %d  Healer: %d", footmen, archers, ballistas, healers);
+		ImGui::Text("Projectiles: %d", counts.projectileCount);
+
+		if (ImGui::TreeNode("Component pools")) {
+			for (auto [id, storage] : world.GetRegistry().storage()) {
+				auto name = storage.type().name();
+				ImGui::Text("%.*s: %d", static_cast<int>(name.size()), name.data(), static_cast<int>(storage.size()));
+			}
+			ImGui::TreePop();
+		}
+	}
+
+	if (ImGui::CollapsingHeader("Spatial grid", ImGuiTreeNodeFlags_DefaultOpen)) {
+		GridOccupancy occupancy = world.GetSpatialGrid().GetOccupancy(&world.GetFrameArena());
+		float occupiedPercent = occupancy.cells > 0 ? 100.0f * occupancy.occupiedCells / occupancy.cells : 0.0f;
+		ImGui::Text("Entities: %d", occupancy.entities);
+		ImGui::Text("Occupied cells: %d / %d (%.1f%%)", occupancy.occupiedCells, occupancy.cells, occupiedPercent);
+		ImGui::Text("Per occupied cell: avg %.2f, max %d", occupancy.GetMeanPerOccupiedCell(), occupancy.maxPerCell);
+	}
+
+	if (ImGui::CollapsingHeader("Memory")) {
+		const FrameArena& arena = world.GetFrameArena();
+		ImGui::Text("Frame arena: %zu / %zu bytes, %zu blocks allocated",
+			arena.GetUsed(), arena.GetCapacity(), arena.GetBlockAllocations());
+	}
+
+	ImGui::End();
+}
+
 void UISystem::renderSelectionRect(World& world, InputSystem& inputSystem) {
 	if (!inputSystem.is_selecting()) {
 		return;
@@ -181,8 +346,8 @@ void UISystem::renderSelectionWindow(World& world) {
 	// Get all selected units
 	auto selectedView = registry.view<Selected, Unit>();
 	
-	// Collect first 50 selected units
-	std::vector<entt::entity> selectedUnits;
+	// Collect first 50 selected units (frame scratch memory, released on the next world update)
+	std::pmr::vector<entt::entity> selectedUnits(&world.GetFrameArena());
 	selectedUnits.reserve(50);
 	for (auto entity : selectedView) {
 		if (selectedUnits.size() >= 50) {
@@ -194,11 +359,15 @@ void UISystem::renderSelectionWindow(World& world) {
 	// Resize info array
 	_selectionInfo.resize(selectedUnits.size());
 	
-	// Helper function to format float with 1 decimal place
-	auto formatFloat = [](float value) -> std::string {
-		std::ostringstream oss;
-		oss << std::fixed << std::setprecision(1) << value;
-		return oss.str();
+	// Info line builder: formats into the frame arena instead of a heap-allocating ostringstream
+	std::pmr::string line(&world.GetFrameArena());
+	line.reserve(256);
+	auto append = [&line](const char* format, auto... args) {
+		char buffer[128];
+		int length = std::snprintf(buffer, sizeof(buffer), format, args...);
+		if (length > 0) {
+			line.append(buffer, std::min<size_t>(length, sizeof(buffer) - 1));
+		}
 	};
 	
 	// Populate info for each unit
@@ -219,64 +388,48 @@ void UISystem::renderSelectionWindow(World& world) {
 		}
 		
 		// Build info string
-		std::ostringstream oss;
+		line.clear();
 		
 		// Health component
 		if (registry.all_of<Health>(entity)) {
 			const auto& health = registry.get<Health>(entity);
-			oss << "H:" << static_cast<int>(health.current)
-			    << ", M:" << static_cast<int>(health.max)
-			    << ", S:" << static_cast<int>(health.shield)
-			    << ", ";
+			append("H:%d, M:%d, S:%d, ", static_cast<int>(health.current), static_cast<int>(health.max), static_cast<int>(health.shield));
 		}
 		
 		// Unit component
-		oss << "F:" << unit.faction
-		    << ", T:" << static_cast<int>(unit.type)
-		    << ", ";
+		append("F:%d, T:%d, ", unit.faction, static_cast<int>(unit.type));
 		
 		// Movement component
 		if (registry.all_of<Movement>(entity)) {
 			const auto& movement = registry.get<Movement>(entity);
-			oss << "Sp:" << formatFloat(movement.speed) << ", ";
+			append("Sp:%.1f, ", movement.speed);
 		}
 		
 		// DirectDamage component
 		if (registry.all_of<DirectDamage>(entity)) {
 			const auto& damage = registry.get<DirectDamage>(entity);
-			oss << "D:" << formatFloat(damage.damage)
-			    << ", R:" << formatFloat(damage.range)
-			    << ", C:" << formatFloat(damage.cooldown)
-			    << ", ";
+			append("D:%.1f, R:%.1f, C:%.1f, ", damage.damage, damage.range, damage.cooldown);
 		}
 		
 		// ProjectileEmitter component
 		if (registry.all_of<ProjectileEmitter>(entity)) {
 			const auto& emitter = registry.get<ProjectileEmitter>(entity);
-			oss << "D:" << formatFloat(emitter.damage)
-			    << ", R:" << formatFloat(emitter.range)
-			    << ", C:" << formatFloat(emitter.cooldown)
-			    << ", PS:" << formatFloat(emitter.projectile_speed)
-			    << ", ";
+			append("D:%.1f, R:%.1f, C:%.1f, PS:%.1f, ", emitter.damage, emitter.range, emitter.cooldown, emitter.projectile_speed);
 		}
 		
 		// Healer component
 		if (registry.all_of<Healer>(entity)) {
 			const auto& healer = registry.get<Healer>(entity);
-			oss << "He:" << formatFloat(healer.heal_amount)
-			    << ", R:" << formatFloat(healer.range)
-			    << ", C:" << formatFloat(healer.cooldown)
-			    << ", ";
+			append("He:%.1f, R:%.1f, C:%.1f, ", healer.heal_amount, healer.range, healer.cooldown);
 		}
 		
-		info.text = oss.str();
-		
 		// Remove trailing comma and space
-		if (!info.text.empty() && info.text.size() >= 2) {
-			if (info.text.substr(info.text.size() - 2) == ", ") {
-				info.text = info.text.substr(0, info.text.size() - 2);
-			}
+		if (line.size() >= 2 && line.compare(line.size() - 2, 2, ", ") == 0) {
+			line.resize(line.size() - 2);
 		}
+		
+		// Assign keeps the capacity info.text already has from earlier frames
+		info.text.assign(line.data(), line.size());
 	}
 	
 	// Create ImGui window
@@ -1,10 +1,13 @@
 #pragma once
 
 #include <imgui.h>
+#include <array>
+#include <cstddef>
 #include <string>
 #include <vector>
 #include "../components/components.hpp"
 #include "../world/world.hpp"
+#include "../utils/sample_history.hpp"
 
 class InputSystem;
 class TimeController;
@@ -30,6 +33,10 @@ private:
 	void renderDebugWindow(World& world, float dt, TimeController& timeController);
 	void renderSelectionRect(World& world, InputSystem& inputSystem);
 	void renderSelectionWindow(World& world);
+	void renderPerformanceWindow(World& world);
+
+	// Push this frame's timings and allocation count into the performance history
+	void recordPerformance(World& world);
 
 	// Spawn parameters
 	int _spawnTypeIdx = 0;
@@ -39,8 +46,19 @@ private:
 	// Save/Load parameters
 	std::string _saveFilePath = "data/saves/game.json";
 	std::string _saveLoadStatus = "";
+	bool _saveInProgress = false; // Waiting for World::SaveGameAsync to finish
 
 	// Selection window data
 	std::vector<UnitInfoLine> _selectionInfo;
+
+	// Performance window data: one sample per frame, gameplay passes in GameplayTimings order (summed over the frame's ticks)
+	static constexpr int PassCount = 7;
+	std::array<SampleHistory, PassCount> _passHistory;
+	SampleHistory _frameHistory;
+	SampleHistory _gameplayHistory;
+	SampleHistory _tickHistory;
+	SampleHistory _allocationHistory;
+	size_t _lastAllocationTotal = 0;
+	bool _perfPaused = false;
 };
 
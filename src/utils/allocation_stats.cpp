@@ -0,0 +1,91 @@
+#include "allocation_stats.hpp"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+static std::atomic<size_t> g_allocations{0};
+
+#ifdef RTS_COUNT_ALLOCATIONS
+
+bool AllocationStats::IsEnabled() {
+	return true;
+}
+
+// Allocates like the default operator new: retries through the installed new_handler until it frees
+// memory, and throws bad_alloc only when there is none
+static void* allocate(std::size_t size, std::size_t alignment) {
+	g_allocations.fetch_add(1, std::memory_order_relaxed);
+	if (size == 0) {
+		size = 1;
+	}
+	for (;;) {
+		void* memory;
+		if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+#ifdef _WIN32
+			memory = _aligned_malloc(size, alignment);
+#else
+			// aligned_alloc needs a size that is a multiple of the alignment
+			memory = std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+#endif
+		} else {
+			memory = std::malloc(size);
+		}
+		if (memory) {
+			return memory;
+		}
+		std::new_handler handler = std::get_new_handler();
+		if (!handler) {
+			throw std::bad_alloc();
+		}
+		handler();
+	}
+}
+
+static void deallocateAligned(void* memory, std::size_t alignment) noexcept {
+	if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+#ifdef _WIN32
+		_aligned_free(memory);
+#else
+		std::free(memory);
+#endif
+	} else {
+		std::free(memory);
+	}
+}
+
+// The array and nothrow forms forward to these by default, so they are counted too
+void* operator new(std::size_t size) {
+	return allocate(size, 0);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+	return allocate(size, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void* memory) noexcept {
+	std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept {
+	std::free(memory);
+}
+
+void operator delete(void* memory, std::align_val_t alignment) noexcept {
+	deallocateAligned(memory, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void* memory, std::size_t, std::align_val_t alignment) noexcept {
+	deallocateAligned(memory, static_cast<std::size_t>(alignment));
+}
+
+#else
+
+bool AllocationStats::IsEnabled() {
+	return false;
+}
+
+#endif
+
+size_t AllocationStats::GetTotal() {
+	return g_allocations.load(std::memory_order_relaxed);
+}
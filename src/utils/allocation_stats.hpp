@@ -0,0 +1,15 @@
+#pragma once
+
+#include <cstddef>
+
+// Process-wide count of global operator new calls. With RTS_COUNT_ALLOCATIONS (the CMake option of the
+// same name), allocation_stats.cpp replaces operator new/delete, and the replacement is linked into any
+// binary that calls GetTotal(). Without it the allocator is untouched and GetTotal() stays at zero.
+class AllocationStats {
+public:
+	// Whether the counting operator new is built in
+	static bool IsEnabled();
+
+	// Allocations since the process started, on any thread
+	static size_t GetTotal();
+};
@@ -0,0 +1,64 @@
+#include "frame_arena.hpp"
+#include <algorithm>
+#include <cstdint>
+
+FrameArena::FrameArena(size_t blockSize)
+	: _blockSize(std::max<size_t>(blockSize, 64))
+{
+}
+
+void* FrameArena::Allocate(size_t size, size_t alignment) {
+	size = std::max<size_t>(size, 1);
+	alignment = std::max<size_t>(alignment, 1);
+
+	while (_current < _blocks.size()) {
+		Block& block = _blocks[_current];
+		uintptr_t base = reinterpret_cast<uintptr_t>(block.data.get());
+		uintptr_t aligned = (base + _head + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1);
+		size_t offset = static_cast<size_t>(aligned - base);
+
+		if (offset + size <= block.size) {
+			_used += offset + size - _head;
+			_head = offset + size;
+			return block.data.get() + offset;
+		}
+
+		// Block exhausted: move on to the next one (only chained blocks exist past _current)
+		_used += block.size - _head;
+		++_current;
+		_head = 0;
+	}
+
+	addBlock(size + alignment);
+	return Allocate(size, alignment);
+}
+
+void FrameArena::Reset() {
+	// Fold an overflowing chain into one block sized for the peak, so the next frame fits without chaining
+	if (_blocks.size() > 1) {
+		size_t capacity = GetCapacity();
+		_blocks.clear();
+		addBlock(capacity);
+	}
+	_current = 0;
+	_head = 0;
+	_used = 0;
+}
+
+size_t FrameArena::GetCapacity() const {
+	size_t capacity = 0;
+	for (const auto& block : _blocks) {
+		capacity += block.size;
+	}
+	return capacity;
+}
+
+void FrameArena::addBlock(size_t minSize) {
+	Block block;
+	block.size = std::max(_blockSize, minSize);
+	block.data = std::make_unique<std::byte[]>(block.size);
+	_blocks.push_back(std::move(block));
+	_blockAllocations++;
+	_current = _blocks.size() - 1;
+	_head = 0;
+}
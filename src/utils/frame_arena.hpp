@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+// Linear (bump-pointer) allocator for data that lives until the end of a frame.
+// Allocations are never freed one by one; Reset() releases everything at once.
+// When a frame overflows the current block a new block is chained; the next Reset()
+// replaces the chain with a single block big enough for the peak, so steady-state
+// frames never touch the heap.
+// It is also a std::pmr::memory_resource, so std::pmr containers can use it for scratch storage.
+// Deallocation is a no-op and the memory comes back on Reset().
+class FrameArena : public std::pmr::memory_resource {
+public:
+	static constexpr size_t DefaultBlockSize = 64 * 1024;
+
+	explicit FrameArena(size_t blockSize = DefaultBlockSize);
+
+	FrameArena(const FrameArena&) = delete;
+	FrameArena& operator=(const FrameArena&) = delete;
+	FrameArena(FrameArena&&) = default;
+	FrameArena& operator=(FrameArena&&) = default;
+
+	// Bump-allocate size bytes; alignment must be a power of two
+	void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+	// Release every allocation made since the last reset
+	void Reset();
+
+	// Bytes handed out since the last reset (including alignment padding)
+	size_t GetUsed() const { return _used; }
+
+	// Total bytes owned by the arena
+	size_t GetCapacity() const;
+
+	// Number of blocks ever requested from the heap. This stops changing once the arena has warmed up.
+	size_t GetBlockAllocations() const { return _blockAllocations; }
+
+protected:
+	void* do_allocate(size_t bytes, size_t alignment) override { return Allocate(bytes, alignment); }
+	void do_deallocate(void*, size_t, size_t) override {}
+	bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+private:
+	struct Block {
+		std::unique_ptr<std::byte[]> data;
+		size_t size = 0;
+	};
+
+	void addBlock(size_t minSize);
+
+	std::vector<Block> _blocks;
+	size_t _blockSize;
+	size_t _current = 0; // Block being bumped
+	size_t _head = 0;    // Offset inside the current block
+	size_t _used = 0;
+	size_t _blockAllocations = 0;
+};
@@ -0,0 +1,110 @@
+#include "gl_buffer_backend.hpp"
+#include "gl_loader.hpp"
+#include <cstdint>
+
+GlBufferBackend::GlBufferBackend(unsigned int target)
+	: _target(target)
+{
+}
+
+GlBufferBackend::~GlBufferBackend() {
+	Destroy();
+}
+
+bool GlBufferBackend::IsSupported() {
+	return RTS_GL::hasMapBufferRange && RTS_GL::hasSync;
+}
+
+bool GlBufferBackend::Create(size_t size) {
+	Destroy();
+
+	glGenBuffers(1, &_buffer);
+	glBindBuffer(_target, _buffer);
+	_size = size;
+
+	if (RTS_GL::hasBufferStorage) {
+		// Immutable storage mapped once for the lifetime of the buffer
+		GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+		RTS_GL::glBufferStorage(_target, static_cast<GLsizeiptr>(size), nullptr, flags);
+		_persistentPtr = RTS_GL::glMapBufferRange(_target, 0, static_cast<GLsizeiptr>(size), flags);
+	} else {
+		glBufferData(_target, static_cast<GLsizeiptr>(size), nullptr, GL_STREAM_DRAW);
+	}
+
+	glBindBuffer(_target, 0);
+	return _buffer != 0;
+}
+
+void GlBufferBackend::Destroy() {
+	if (_buffer == 0) {
+		return;
+	}
+
+	if (_persistentPtr || _mapped) {
+		glBindBuffer(_target, _buffer);
+		RTS_GL::glUnmapBuffer(_target);
+		glBindBuffer(_target, 0);
+	}
+
+	glDeleteBuffers(1, &_buffer);
+	_buffer = 0;
+	_size = 0;
+	_persistentPtr = nullptr;
+	_mapped = false;
+}
+
+void* GlBufferBackend::Map(size_t offset, size_t size) {
+	if (_buffer == 0 || offset + size > _size) {
+		return nullptr;
+	}
+
+	if (_persistentPtr) {
+		return static_cast<char*>(_persistentPtr) + offset;
+	}
+
+	// The ring's fences guarantee the GPU is done with this range, so skip the driver's implicit sync
+	glBindBuffer(_target, _buffer);
+	GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_INVALIDATE_RANGE_BIT;
+	void* ptr = RTS_GL::glMapBufferRange(_target, static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(size), flags);
+	glBindBuffer(_target, 0);
+
+	_mapped = ptr != nullptr;
+	return ptr;
+}
+
+void GlBufferBackend::Unmap() {
+	if (!_mapped) {
+		return;
+	}
+
+	glBindBuffer(_target, _buffer);
+	RTS_GL::glUnmapBuffer(_target);
+	glBindBuffer(_target, 0);
+	_mapped = false;
+}
+
+GpuFence GlBufferBackend::InsertFence() {
+	GLsync sync = RTS_GL::glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	return static_cast<GpuFence>(reinterpret_cast<uintptr_t>(sync));
+}
+
+void GlBufferBackend::WaitAndDeleteFence(GpuFence fence) {
+	if (fence == 0) {
+		return;
+	}
+
+	GLsync sync = reinterpret_cast<GLsync>(static_cast<uintptr_t>(fence));
+
+	// Flush on the first wait so the fence is guaranteed to be submitted, then poll in 1ms steps
+	GLbitfield waitFlags = GL_SYNC_FLUSH_COMMANDS_BIT;
+	const GLuint64 timeoutNs = 1000000;
+	while (true) {
+		GLenum result = RTS_GL::glClientWaitSync(sync, waitFlags, timeoutNs);
+		if (result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED || result == GL_WAIT_FAILED) {
+			break;
+		}
+		waitFlags = 0;
+	}
+
+	RTS_GL::glDeleteSync(sync);
+}
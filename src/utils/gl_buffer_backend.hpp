@@ -0,0 +1,35 @@
+#pragma once
+
+#include "gpu_buffer_backend.hpp"
+
+// OpenGL implementation of GpuBufferBackend.
+// Uses persistent coherent mapping when the context supports buffer storage (GL 4.4 / ARB_buffer_storage),
+// otherwise maps each frame's range with GL_MAP_UNSYNCHRONIZED_BIT and relies on fences for safety.
+class GlBufferBackend : public GpuBufferBackend {
+public:
+	GlBufferBackend(unsigned int target);
+	~GlBufferBackend() override;
+
+	// True if the context supports range mapping and fences (checked by load_gl_functions)
+	static bool IsSupported();
+
+	bool Create(size_t size) override;
+	void Destroy() override;
+
+	bool IsPersistent() const override { return _persistentPtr != nullptr; }
+
+	void* Map(size_t offset, size_t size) override;
+	void Unmap() override;
+
+	GpuFence InsertFence() override;
+	void WaitAndDeleteFence(GpuFence fence) override;
+
+	unsigned int GetBufferId() const override { return _buffer; }
+
+private:
+	unsigned int _target;
+	unsigned int _buffer = 0;
+	size_t _size = 0;
+	void* _persistentPtr = nullptr;
+	bool _mapped = false;
+};
@@ -1,4 +1,5 @@
 #include "gl_loader.hpp"
+#include <cstdio>
 #include <iostream>
 
 // ... existing pointers ...
@@ -33,6 +34,34 @@ PFNGLUNIFORM4FPROC glUniform4f = nullptr;
 namespace RTS_GL {
     PFNGLGENERATEMIPMAPPROC glGenerateMipmap = nullptr;
     PFNGLACTIVETEXTUREPROC glActiveTexture = nullptr;
+    PFNGLDRAWARRAYSINSTANCEDPROC glDrawArraysInstanced = nullptr;
+    PFNGLVERTEXATTRIBDIVISORPROC glVertexAttribDivisor = nullptr;
+    PFNGLMAPBUFFERRANGEPROC glMapBufferRange = nullptr;
+    PFNGLUNMAPBUFFERPROC glUnmapBuffer = nullptr;
+    PFNGLFENCESYNCPROC glFenceSync = nullptr;
+    PFNGLCLIENTWAITSYNCPROC glClientWaitSync = nullptr;
+    PFNGLDELETESYNCPROC glDeleteSync = nullptr;
+    PFNGLBUFFERSTORAGEPROC glBufferStorage = nullptr;
+    bool hasMapBufferRange = false;
+    bool hasSync = false;
+    bool hasBufferStorage = false;
+}
+
+// Version of the current context as major * 10 + minor, 0 if it cannot be read
+static int context_version() {
+    const char* version = reinterpret_cast<const char*>(glGetString(GL_VERSION));
+    if (!version) {
+        return 0;
+    }
+    // "4.6.0 NVIDIA ...", "OpenGL ES 3.2 ...": the first "major.minor" in the string
+    for (const char* c = version; *c; ++c) {
+        int major = 0;
+        int minor = 0;
+        if (*c >= '0' && *c <= '9' && std::sscanf(c, "%d.%d", &major, &minor) == 2) {
+            return major * 10 + minor;
+        }
+    }
+    return 0;
 }
 
 int load_gl_functions() {
@@ -66,6 +95,22 @@ int load_gl_functions() {
 
     RTS_GL::glGenerateMipmap = (PFNGLGENERATEMIPMAPPROC)SDL_GL_GetProcAddress("glGenerateMipmap");
     RTS_GL::glActiveTexture = (PFNGLACTIVETEXTUREPROC)SDL_GL_GetProcAddress("glActiveTexture");
+    RTS_GL::glDrawArraysInstanced = (PFNGLDRAWARRAYSINSTANCEDPROC)SDL_GL_GetProcAddress("glDrawArraysInstanced");
+    RTS_GL::glVertexAttribDivisor = (PFNGLVERTEXATTRIBDIVISORPROC)SDL_GL_GetProcAddress("glVertexAttribDivisor");
+    RTS_GL::glMapBufferRange = (PFNGLMAPBUFFERRANGEPROC)SDL_GL_GetProcAddress("glMapBufferRange");
+    RTS_GL::glUnmapBuffer = (PFNGLUNMAPBUFFERPROC)SDL_GL_GetProcAddress("glUnmapBuffer");
+    RTS_GL::glFenceSync = (PFNGLFENCESYNCPROC)SDL_GL_GetProcAddress("glFenceSync");
+    RTS_GL::glClientWaitSync = (PFNGLCLIENTWAITSYNCPROC)SDL_GL_GetProcAddress("glClientWaitSync");
+    RTS_GL::glDeleteSync = (PFNGLDELETESYNCPROC)SDL_GL_GetProcAddress("glDeleteSync");
+    RTS_GL::glBufferStorage = (PFNGLBUFFERSTORAGEPROC)SDL_GL_GetProcAddress("glBufferStorage");
+
+    int version = context_version();
+    RTS_GL::hasMapBufferRange = RTS_GL::glMapBufferRange && RTS_GL::glUnmapBuffer &&
+        (version >= 30 || SDL_GL_ExtensionSupported("GL_ARB_map_buffer_range"));
+    RTS_GL::hasSync = RTS_GL::glFenceSync && RTS_GL::glClientWaitSync && RTS_GL::glDeleteSync &&
+        (version >= 32 || SDL_GL_ExtensionSupported("GL_ARB_sync"));
+    RTS_GL::hasBufferStorage = RTS_GL::glBufferStorage &&
+        (version >= 44 || SDL_GL_ExtensionSupported("GL_ARB_buffer_storage"));
 
     if (!glGenBuffers || !glCreateProgram || !glGetUniformLocation) {
         return 0; // Failed
@@ -89,6 +89,24 @@ extern PFNGLUNIFORM4FPROC glUniform4f;
 namespace RTS_GL {
     extern PFNGLGENERATEMIPMAPPROC glGenerateMipmap;
     extern PFNGLACTIVETEXTUREPROC glActiveTexture;
+
+    // Instancing (GL 3.3). May be null on older drivers - callers must fall back.
+    extern PFNGLDRAWARRAYSINSTANCEDPROC glDrawArraysInstanced;
+    extern PFNGLVERTEXATTRIBDIVISORPROC glVertexAttribDivisor;
+
+    // Streaming buffers: mapping (GL 3.0), fences (GL 3.2), persistent storage (GL 4.4 / ARB_buffer_storage)
+    extern PFNGLMAPBUFFERRANGEPROC glMapBufferRange;
+    extern PFNGLUNMAPBUFFERPROC glUnmapBuffer;
+    extern PFNGLFENCESYNCPROC glFenceSync;
+    extern PFNGLCLIENTWAITSYNCPROC glClientWaitSync;
+    extern PFNGLDELETESYNCPROC glDeleteSync;
+    extern PFNGLBUFFERSTORAGEPROC glBufferStorage;
+
+    // What the current context supports, from its version and extension list. Drivers may hand out
+    // entry points the context cannot use, so a loaded pointer alone does not mean the feature works.
+    extern bool hasMapBufferRange; // GL 3.0 / ARB_map_buffer_range
+    extern bool hasSync;           // GL 3.2 / ARB_sync
+    extern bool hasBufferStorage;  // GL 4.4 / ARB_buffer_storage
 }
 
 int load_gl_functions();
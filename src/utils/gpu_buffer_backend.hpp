@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Opaque fence handle, 0 means "no fence"
+using GpuFence = uint64_t;
+
+// Minimal buffer/fence interface used by RingBuffer.
+// The GL implementation lives in GlBufferBackend; tests use a CPU-only fake.
+class GpuBufferBackend {
+public:
+	virtual ~GpuBufferBackend() = default;
+
+	// Allocate GPU storage of the given size (drops any previous storage)
+	virtual bool Create(size_t size) = 0;
+	virtual void Destroy() = 0;
+
+	// True if the whole buffer stays mapped between frames (Map/Unmap are then free)
+	virtual bool IsPersistent() const = 0;
+
+	// Get a CPU write pointer for a byte range. Caller guarantees the GPU no longer reads it.
+	virtual void* Map(size_t offset, size_t size) = 0;
+	virtual void Unmap() = 0;
+
+	// Fence all GPU commands issued so far
+	virtual GpuFence InsertFence() = 0;
+
+	// Block until the fence is signaled, then release it
+	virtual void WaitAndDeleteFence(GpuFence fence) = 0;
+
+	// Native buffer handle for binding (GL buffer name)
+	virtual unsigned int GetBufferId() const = 0;
+};
@@ -0,0 +1,113 @@
+#include "job_system.hpp"
+#include "profiler.hpp"
+#include <string>
+
+// Set while a thread is executing chunks, so nested ParallelFor calls run inline instead of deadlocking
+static thread_local bool t_insideJob = false;
+
+JobSystem::JobSystem(int threadCount) {
+	if (threadCount <= 0) {
+		threadCount = static_cast<int>(std::thread::hardware_concurrency());
+	}
+	threadCount = std::max(threadCount, 1);
+
+	_workers.reserve(threadCount - 1);
+	for (int i = 1; i < threadCount; ++i) {
+		_workers.emplace_back(&JobSystem::workerLoop, this, i);
+	}
+}
+
+JobSystem::~JobSystem() {
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_stopping = true;
+	}
+	_wake.notify_all();
+
+	for (auto& worker : _workers) {
+		worker.join();
+	}
+}
+
+size_t JobSystem::GetChunkCount(size_t count, size_t chunkSize) {
+	chunkSize = std::max<size_t>(chunkSize, 1);
+	return (count + chunkSize - 1) / chunkSize;
+}
+
+void JobSystem::run(size_t chunkCount, ChunkFn fn, void* context) {
+	if (chunkCount == 0) {
+		return;
+	}
+
+	// Nothing to share: run on the caller without waking anyone
+	if (_workers.empty() || chunkCount == 1 || t_insideJob) {
+		bool wasInside = t_insideJob;
+		t_insideJob = true;
+		for (size_t chunk = 0; chunk < chunkCount; ++chunk) {
+			fn(context, chunk);
+		}
+		t_insideJob = wasInside;
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_fn = fn;
+		_context = context;
+		_chunkCount = chunkCount;
+		_nextChunk.store(0, std::memory_order_relaxed);
+		_busyWorkers = static_cast<int>(_workers.size());
+		_generation++;
+	}
+	_wake.notify_all();
+
+	t_insideJob = true;
+	executeChunks();
+	t_insideJob = false;
+
+	// Every worker has to check out before the job state can be reused by the next call
+	std::unique_lock<std::mutex> lock(_mutex);
+	_done.wait(lock, [this] { return _busyWorkers == 0; });
+	_fn = nullptr;
+	_context = nullptr;
+	_chunkCount = 0;
+}
+
+void JobSystem::executeChunks() {
+	while (true) {
+		size_t chunk = _nextChunk.fetch_add(1, std::memory_order_relaxed);
+		if (chunk >= _chunkCount) {
+			break;
+		}
+		RTS_PROFILE_SCOPE("JobSystem::Chunk");
+		_fn(_context, chunk);
+	}
+}
+
+void JobSystem::workerLoop(int index) {
+	uint64_t seenGeneration = 0;
+	t_insideJob = true;
+
+	std::string threadName = "Worker " + std::to_string(index);
+	RTS_PROFILE_THREAD(threadName.c_str());
+
+	while (true) {
+		{
+			std::unique_lock<std::mutex> lock(_mutex);
+			_wake.wait(lock, [&] { return _stopping || _generation != seenGeneration; });
+			if (_stopping) {
+				return;
+			}
+			seenGeneration = _generation;
+		}
+
+		executeChunks();
+
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			if (--_busyWorkers == 0) {
+				_done.notify_one();
+			}
+		}
+	}
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// Fixed thread pool that runs data-parallel loops.
+// The calling thread takes part in every loop. Idle threads pull the next unclaimed chunk from a
+// shared counter, so a slow chunk never holds up the others.
+// Chunk boundaries depend only on the element count and chunk size, never on the thread count.
+// Callers that write per-chunk results and merge them in chunk order get the same output for any thread count.
+class JobSystem {
+public:
+	// threadCount includes the calling thread; <= 0 uses std::thread::hardware_concurrency()
+	explicit JobSystem(int threadCount = 0);
+	~JobSystem();
+
+	JobSystem(const JobSystem&) = delete;
+	JobSystem& operator=(const JobSystem&) = delete;
+
+	// Threads taking part in a ParallelFor, including the caller
+	int GetThreadCount() const { return static_cast<int>(_workers.size()) + 1; }
+
+	// Number of chunks ParallelFor will use for this count and chunk size
+	static size_t GetChunkCount(size_t count, size_t chunkSize);
+
+	// Run func(begin, end, chunkIndex) for [0, count) split into chunks of at most chunkSize.
+	// Blocks until every chunk is done. Nested calls from inside a chunk run inline.
+	template<typename Func>
+	void ParallelFor(size_t count, size_t chunkSize, Func&& func);
+
+private:
+	using ChunkFn = void (*)(void* context, size_t chunk);
+
+	// Execute chunkCount chunks across the pool and wait for all of them
+	void run(size_t chunkCount, ChunkFn fn, void* context);
+
+	// Claim and execute chunks of the current job until none are left
+	void executeChunks();
+
+	void workerLoop(int index);
+
+	std::vector<std::thread> _workers;
+	std::mutex _mutex;
+	std::condition_variable _wake;
+	std::condition_variable _done;
+	bool _stopping = false;
+	uint64_t _generation = 0;
+	int _busyWorkers = 0;
+
+	// Current job, written under _mutex before workers are woken
+	ChunkFn _fn = nullptr;
+	void* _context = nullptr;
+	size_t _chunkCount = 0;
+	std::atomic<size_t> _nextChunk{0};
+};
+
+template<typename Func>
+void JobSystem::ParallelFor(size_t count, size_t chunkSize, Func&& func) {
+	if (count == 0) {
+		return;
+	}
+	chunkSize = std::max<size_t>(chunkSize, 1);
+
+	struct Context {
+		std::remove_reference_t<Func>* func;
+		size_t count;
+		size_t chunkSize;
+	};
+	Context context{&func, count, chunkSize};
+
+	run(GetChunkCount(count, chunkSize), [](void* data, size_t chunk) {
+		const Context& ctx = *static_cast<const Context*>(data);
+		size_t begin = chunk * ctx.chunkSize;
+		size_t end = std::min(begin + ctx.chunkSize, ctx.count);
+		(*ctx.func)(begin, end, chunk);
+	}, &context);
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+// Read-only memory mapping of a whole file. The mapping lives as long as the object;
+// pages are loaded by the OS on first access, so opening a large file is cheap.
+class MappedFile {
+public:
+	MappedFile() = default;
+	~MappedFile();
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+	MappedFile(MappedFile&& other) noexcept;
+	MappedFile& operator=(MappedFile&& other) noexcept;
+
+	// Map path, replacing any current mapping. Fails for missing or empty files.
+	bool Open(const std::string& path);
+
+	// Unmap the file
+	void Close();
+
+	bool IsOpen() const { return _data != nullptr; }
+	const std::byte* GetData() const { return _data; }
+	size_t GetSize() const { return _size; }
+
+private:
+	const std::byte* _data = nullptr;
+	size_t _size = 0;
+#ifdef _WIN32
+	void* _file = nullptr;    // HANDLE
+	void* _mapping = nullptr; // HANDLE
+#endif
+};
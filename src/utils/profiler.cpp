@@ -0,0 +1,146 @@
+#include "profiler.hpp"
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+struct ProfileTraceEvent {
+	const char* name;
+	int64_t startNs;
+	int64_t endNs; // -1 for instant events
+};
+
+// Events of one thread. Shared with the global list so they outlive the thread.
+struct ProfileThreadBuffer {
+	std::mutex mutex; // Only contended while a session is being written
+	std::vector<ProfileTraceEvent> events;
+	std::string name;
+	uint32_t id = 0;
+};
+
+static std::mutex g_sessionMutex;
+static std::vector<std::shared_ptr<ProfileThreadBuffer>> g_buffers;
+static std::string g_sessionPath;
+static int64_t g_sessionStart = 0;
+
+static thread_local std::shared_ptr<ProfileThreadBuffer> t_buffer;
+
+static ProfileThreadBuffer& threadBuffer() {
+	if (!t_buffer) {
+		t_buffer = std::make_shared<ProfileThreadBuffer>();
+		std::lock_guard<std::mutex> lock(g_sessionMutex);
+		t_buffer->id = static_cast<uint32_t>(g_buffers.size()) + 1;
+		g_buffers.push_back(t_buffer);
+	}
+	return *t_buffer;
+}
+
+// Zone names are identifiers and literals, but escape anyway so the trace always parses
+static void writeEscaped(std::ostream& out, const char* text) {
+	for (const char* c = text; *c; ++c) {
+		if (*c == '"' || *c == '\\') {
+			out << '\\' << *c;
+		} else if (static_cast<unsigned char>(*c) >= 0x20) {
+			out << *c;
+		}
+	}
+}
+
+static void writeTimestamp(std::ostream& out, int64_t ns) {
+	char buffer[32];
+	std::snprintf(buffer, sizeof(buffer), "%.3f", static_cast<double>(ns) / 1000.0);
+	out << buffer;
+}
+
+bool Profiler::BeginSession(const std::string& path) {
+	std::lock_guard<std::mutex> lock(g_sessionMutex);
+	if (_active.load()) {
+		return false;
+	}
+
+	for (auto& buffer : g_buffers) {
+		std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+		buffer->events.clear();
+	}
+	g_sessionPath = path;
+	g_sessionStart = Now();
+	_active.store(true);
+	return true;
+}
+
+bool Profiler::EndSession() {
+	std::lock_guard<std::mutex> lock(g_sessionMutex);
+	if (!_active.exchange(false)) {
+		return false;
+	}
+
+	std::ofstream out(g_sessionPath);
+	if (!out.is_open()) {
+		return false;
+	}
+
+	out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+	bool first = true;
+	auto separator = [&]() {
+		out << (first ? "\n" : ",\n");
+		first = false;
+	};
+
+	for (auto& buffer : g_buffers) {
+		std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+
+		if (!buffer->name.empty()) {
+			separator();
+			out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->id << ",\"args\":{\"name\":\"";
+			writeEscaped(out, buffer->name.c_str());
+			out << "\"}}";
+		}
+
+		for (const ProfileTraceEvent& event : buffer->events) {
+			separator();
+			out << "{\"name\":\"";
+			writeEscaped(out, event.name);
+			out << "\",\"pid\":1,\"tid\":" << buffer->id << ",\"ts\":";
+			writeTimestamp(out, event.startNs - g_sessionStart);
+			if (event.endNs >= 0) {
+				out << ",\"ph\":\"X\",\"dur\":";
+				writeTimestamp(out, event.endNs - event.startNs);
+			} else {
+				out << ",\"ph\":\"i\",\"s\":\"g\"";
+			}
+			out << "}";
+		}
+		buffer->events.clear();
+	}
+
+	out << "\n]}\n";
+	return out.good();
+}
+
+void Profiler::SetThreadName(const char* name) {
+	ProfileThreadBuffer& buffer = threadBuffer();
+	std::lock_guard<std::mutex> lock(buffer.mutex);
+	buffer.name = name;
+}
+
+void Profiler::RecordZone(const char* name, int64_t startNs, int64_t endNs) {
+	ProfileThreadBuffer& buffer = threadBuffer();
+	std::lock_guard<std::mutex> lock(buffer.mutex);
+	buffer.events.push_back({name, startNs, endNs});
+}
+
+void Profiler::RecordInstant(const char* name) {
+	if (!IsActive()) {
+		return;
+	}
+	ProfileThreadBuffer& buffer = threadBuffer();
+	std::lock_guard<std::mutex> lock(buffer.mutex);
+	buffer.events.push_back({name, Now(), -1});
+}
+
+int64_t Profiler::Now() {
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now().time_since_epoch()).count();
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+// Scoped profiling zones. The backend is picked with the RTS_PROFILER CMake option:
+//   none   - every macro compiles to nothing (default)
+//   tracy  - zones are sent to the Tracy client; connect the Tracy profiler to the running process
+//   chrome - zones are buffered per thread and written as Chrome trace-event JSON when the session ends;
+//            open the file in chrome://tracing or ui.perfetto.dev (no profiler server needed)
+//
+// RTS_PROFILE_SCOPE(name)          zone until the end of the enclosing block, name must be a string literal
+// RTS_PROFILE_FUNCTION()           zone named after the enclosing function
+// RTS_PROFILE_FRAME()              mark the end of a frame
+// RTS_PROFILE_THREAD(name)         name the calling thread in the trace
+// RTS_PROFILE_BEGIN_SESSION(path)  start recording to a trace file (chrome backend only)
+// RTS_PROFILE_END_SESSION()        stop recording and write the file (chrome backend only)
+
+// Built-in trace recorder behind the chrome backend
+class Profiler {
+public:
+	// Start collecting zones; the trace is written to path by EndSession()
+	static bool BeginSession(const std::string& path);
+
+	// Stop collecting and write the trace. Returns false if no session was running or the file could not be written.
+	static bool EndSession();
+
+	static bool IsActive() { return _active.load(std::memory_order_relaxed); }
+
+	// Name shown for the calling thread
+	static void SetThreadName(const char* name);
+
+	// Record a completed zone / an instant event on the calling thread (timestamps from Now())
+	static void RecordZone(const char* name, int64_t startNs, int64_t endNs);
+	static void RecordInstant(const char* name);
+
+	// Monotonic clock in nanoseconds
+	static int64_t Now();
+
+private:
+	inline static std::atomic<bool> _active{false};
+};
+
+// RAII zone for the chrome backend: measures from construction to destruction
+class ProfileZone {
+public:
+	explicit ProfileZone(const char* name)
+		: _name(name)
+		, _start(Profiler::IsActive() ? Profiler::Now() : -1)
+	{
+	}
+
+	~ProfileZone() {
+		if (_start >= 0) {
+			Profiler::RecordZone(_name, _start, Profiler::Now());
+		}
+	}
+
+	ProfileZone(const ProfileZone&) = delete;
+	ProfileZone& operator=(const ProfileZone&) = delete;
+
+private:
+	const char* _name;
+	int64_t _start;
+};
+
+#define RTS_PROFILE_CONCAT_INNER(a, b) a##b
+#define RTS_PROFILE_CONCAT(a, b) RTS_PROFILE_CONCAT_INNER(a, b)
+
+#if defined(RTS_PROFILER_TRACY)
+
+#include <tracy/Tracy.hpp>
+
+#define RTS_PROFILE_SCOPE(name) ZoneScopedN(name)
+#define RTS_PROFILE_FUNCTION() ZoneScoped
+#define RTS_PROFILE_FRAME() FrameMark
+#define RTS_PROFILE_THREAD(name) tracy::SetThreadName(name)
+#define RTS_PROFILE_BEGIN_SESSION(path) ((void)0)
+#define RTS_PROFILE_END_SESSION() ((void)0)
+
+#elif defined(RTS_PROFILER_CHROME)
+
+#define RTS_PROFILE_SCOPE(name) ProfileZone RTS_PROFILE_CONCAT(_profileZone, __COUNTER__)(name)
+#define RTS_PROFILE_FUNCTION() RTS_PROFILE_SCOPE(__func__)
+#define RTS_PROFILE_FRAME() Profiler::RecordInstant("Frame")
+#define RTS_PROFILE_THREAD(name) Profiler::SetThreadName(name)
+#define RTS_PROFILE_BEGIN_SESSION(path) Profiler::BeginSession(path)
+#define RTS_PROFILE_END_SESSION() Profiler::EndSession()
+
+#else
+
+#define RTS_PROFILE_SCOPE(name) ((void)0)
+#define RTS_PROFILE_FUNCTION() ((void)0)
+#define RTS_PROFILE_FRAME() ((void)0)
+#define RTS_PROFILE_THREAD(name) ((void)0)
+#define RTS_PROFILE_BEGIN_SESSION(path) ((void)0)
+#define RTS_PROFILE_END_SESSION() ((void)0)
+
+#endif
@@ -0,0 +1,127 @@
+#include "ring_buffer.hpp"
+#include <algorithm>
+
+// Segment boundaries stay aligned for any attribute/uniform offset requirement
+static constexpr size_t SegmentAlignment = 256;
+
+RingBuffer::RingBuffer(GpuBufferBackend& backend, size_t segmentSize, int segmentCount)
+	: _backend(backend)
+	, _segmentSize(0)
+	, _segmentCount(std::max(1, segmentCount))
+	, _fences(std::max(1, segmentCount), 0)
+{
+	_segmentSize = alignUp(std::max<size_t>(segmentSize, SegmentAlignment), SegmentAlignment);
+	_backend.Create(_segmentSize * _segmentCount);
+}
+
+RingBuffer::~RingBuffer() {
+	if (_mapped && !_backend.IsPersistent()) {
+		_backend.Unmap();
+	}
+	for (auto& fence : _fences) {
+		if (fence != 0) {
+			_backend.WaitAndDeleteFence(fence);
+			fence = 0;
+		}
+	}
+	_backend.Destroy();
+}
+
+size_t RingBuffer::alignUp(size_t value, size_t alignment) const {
+	if (alignment <= 1) return value;
+	return (value + alignment - 1) / alignment * alignment;
+}
+
+void RingBuffer::grow(size_t minSegmentSize) {
+	// Resizing invalidates everything in flight, so drain the GPU first.
+	// This only happens on the frame after a new peak, not in steady state.
+	for (auto& fence : _fences) {
+		if (fence != 0) {
+			_backend.WaitAndDeleteFence(fence);
+			fence = 0;
+		}
+	}
+
+	size_t newSize = _segmentSize;
+	while (newSize < minSegmentSize) {
+		newSize *= 2;
+	}
+	_segmentSize = alignUp(newSize, SegmentAlignment);
+
+	_backend.Destroy();
+	_backend.Create(_segmentSize * _segmentCount);
+	_currentSegment = -1;
+}
+
+void RingBuffer::BeginFrame() {
+	if (_inFrame) {
+		return;
+	}
+
+	if (_peakRequest > _segmentSize) {
+		grow(_peakRequest);
+	}
+
+	_currentSegment = (_currentSegment + 1) % _segmentCount;
+
+	// Only blocks if the GPU is still reading the segment from `_segmentCount` frames ago
+	GpuFence& fence = _fences[_currentSegment];
+	if (fence != 0) {
+		_backend.WaitAndDeleteFence(fence);
+		fence = 0;
+	}
+
+	size_t segmentOffset = static_cast<size_t>(_currentSegment) * _segmentSize;
+	_mapped = static_cast<char*>(_backend.Map(segmentOffset, _segmentSize));
+	_head = 0;
+	_inFrame = _mapped != nullptr;
+}
+
+RingAllocation RingBuffer::Allocate(size_t size, size_t alignment) {
+	RingAllocation allocation;
+	if (!_mapped || size == 0) {
+		return allocation;
+	}
+
+	size_t start = alignUp(_head, alignment);
+	_peakRequest = std::max(_peakRequest, start + size);
+	if (start + size > _segmentSize) {
+		return allocation; // Doesn't fit this frame, segment grows next frame
+	}
+
+	allocation.data = _mapped + start;
+	allocation.offset = static_cast<size_t>(_currentSegment) * _segmentSize + start;
+	allocation.size = size;
+	_head = start + size;
+	return allocation;
+}
+
+size_t RingBuffer::GetAvailable(size_t alignment) const {
+	if (!_mapped) {
+		return 0;
+	}
+	size_t start = alignUp(_head, alignment);
+	return start >= _segmentSize ? 0 : _segmentSize - start;
+}
+
+void RingBuffer::FinishWrites() {
+	if (!_mapped) {
+		return;
+	}
+
+	if (!_backend.IsPersistent()) {
+		_backend.Unmap();
+	}
+	_mapped = nullptr;
+}
+
+void RingBuffer::EndFrame() {
+	if (!_inFrame) {
+		return;
+	}
+
+	// The fence must follow the frame's draws, and the draws need the segment unmapped
+	FinishWrites();
+	_fences[_currentSegment] = _backend.InsertFence();
+	_inFrame = false;
+}
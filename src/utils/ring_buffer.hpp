@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include "gpu_buffer_backend.hpp"
+
+// A sub-range of the ring handed out for one frame
+struct RingAllocation {
+	void* data = nullptr; // CPU write pointer
+	size_t offset = 0;    // Byte offset inside the GPU buffer (for attribute pointers)
+	size_t size = 0;
+
+	bool IsValid() const { return data != nullptr; }
+};
+
+// Multi-buffered streaming allocator for per-frame vertex/instance data.
+// The buffer is split into segments (3 by default); each frame writes into its own
+// segment and fences it, so the CPU only waits when it laps a segment the GPU
+// is still reading. Allocations are bump-pointer and never stall the pipeline.
+class RingBuffer {
+public:
+	static constexpr int DefaultSegmentCount = 3;
+
+	RingBuffer(GpuBufferBackend& backend, size_t segmentSize, int segmentCount = DefaultSegmentCount);
+	~RingBuffer();
+
+	RingBuffer(const RingBuffer&) = delete;
+	RingBuffer& operator=(const RingBuffer&) = delete;
+
+	// Start a frame: wait for the next segment to be released by the GPU and map it
+	void BeginFrame();
+
+	// Bump-allocate inside the current segment. Returns an invalid allocation if the
+	// segment is full; the segment grows on the next BeginFrame to fit the peak usage.
+	RingAllocation Allocate(size_t size, size_t alignment = 16);
+
+	// Bytes still available in the current segment after aligning to `alignment`
+	size_t GetAvailable(size_t alignment = 16) const;
+
+	// Close the CPU writes of this frame: unmap the segment if not persistent, since GL rejects draws that
+	// read a buffer with a non-persistent mapping. Call it after the last Allocate and before the first draw;
+	// Allocate fails for the rest of the frame.
+	void FinishWrites();
+
+	// End the frame after its draws: unmap (if FinishWrites was not called) and fence the segment
+	void EndFrame();
+
+	unsigned int GetBufferId() const { return _backend.GetBufferId(); }
+	size_t GetSegmentSize() const { return _segmentSize; }
+	int GetSegmentCount() const { return _segmentCount; }
+	int GetCurrentSegment() const { return _currentSegment; }
+	bool IsInFrame() const { return _inFrame; }
+
+private:
+	void grow(size_t minSegmentSize);
+	size_t alignUp(size_t value, size_t alignment) const;
+
+	GpuBufferBackend& _backend;
+	size_t _segmentSize;
+	int _segmentCount;
+
+	int _currentSegment = -1;
+	size_t _head = 0;         // Bytes used in the current segment
+	size_t _peakRequest = 0;  // Largest per-frame demand seen, drives growth
+	bool _inFrame = false;
+	char* _mapped = nullptr;  // Start of the current segment's mapping, nullptr once writes are finished
+
+	std::vector<GpuFence> _fences; // One per segment, 0 if not in flight
+};
@@ -0,0 +1,43 @@
+#include "sample_history.hpp"
+#include <algorithm>
+
+SampleHistory::SampleHistory(int capacity)
+	: _values(std::max(capacity, 1), 0.0f)
+{
+}
+
+void SampleHistory::Push(float value) {
+	_values[_next] = value;
+	_next = (_next + 1) % GetCapacity();
+	_count = std::min(_count + 1, GetCapacity());
+}
+
+void SampleHistory::Clear() {
+	_next = 0;
+	_count = 0;
+}
+
+float SampleHistory::Get(int index) const {
+	return _values[(GetOffset() + index) % GetCapacity()];
+}
+
+int SampleHistory::GetMaxIndex() const {
+	int best = -1;
+	for (int i = 0; i < _count; ++i) {
+		if (best < 0 || Get(i) > Get(best)) {
+			best = i;
+		}
+	}
+	return best;
+}
+
+float SampleHistory::GetAverage() const {
+	if (_count == 0) {
+		return 0.0f;
+	}
+	float total = 0.0f;
+	for (int i = 0; i < _count; ++i) {
+		total += Get(i);
+	}
+	return total / _count;
+}
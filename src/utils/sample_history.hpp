@@ -0,0 +1,36 @@
+#pragma once
+
+#include <vector>
+
+// Rolling window of the last N samples (oldest overwritten first), for plotting per-frame values.
+// GetData()/GetCount()/GetOffset() map directly onto ImGui::PlotLines(values, count, values_offset).
+class SampleHistory {
+public:
+	static constexpr int DefaultCapacity = 300;
+
+	explicit SampleHistory(int capacity = DefaultCapacity);
+
+	void Push(float value);
+	void Clear();
+
+	// Sample by age: 0 is the oldest, GetCount() - 1 the latest
+	float Get(int index) const;
+	float GetLatest() const { return _count > 0 ? Get(_count - 1) : 0.0f; }
+
+	// Age index of the largest sample (-1 when empty)
+	int GetMaxIndex() const;
+	float GetMax() const { return _count > 0 ? Get(GetMaxIndex()) : 0.0f; }
+	float GetAverage() const;
+
+	int GetCount() const { return _count; }
+	int GetCapacity() const { return static_cast<int>(_values.size()); }
+
+	// Raw ring storage and the position of the oldest sample in it
+	const float* GetData() const { return _values.data(); }
+	int GetOffset() const { return _count < GetCapacity() ? 0 : _next; }
+
+private:
+	std::vector<float> _values;
+	int _next = 0;  // Slot written by the next Push
+	int _count = 0;
+};
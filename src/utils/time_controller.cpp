@@ -1,4 +1,6 @@
 #include "time_controller.hpp"
+#include <algorithm>
+#include <cmath>
 
 TimeController::TimeController()
 	: _lastTime(SDL_GetPerformanceCounter())
@@ -10,13 +12,34 @@ TimeController::TimeController()
 
 void TimeController::Update() {
 	Uint64 currentTime = SDL_GetPerformanceCounter();
-	_rawDeltaTime = (float)(currentTime - _lastTime) / (float)SDL_GetPerformanceFrequency();
+	float rawDeltaTime = (float)(currentTime - _lastTime) / (float)SDL_GetPerformanceFrequency();
 	_lastTime = currentTime;
+	Update(rawDeltaTime);
+}
+
+void TimeController::Update(float rawDeltaTime) {
+	_rawDeltaTime = rawDeltaTime;
 
 	// Cap dt to prevent huge jumps
 	if (_rawDeltaTime > 0.1f) {
 		_rawDeltaTime = 0.1f;
 	}
+
+	_tickCount = 0;
+	if (!IsFixedStep()) {
+		return;
+	}
+
+	_accumulator += GetDeltaTime();
+	double ticks = std::floor(_accumulator / _fixedStep + 1e-6); // Whole steps that land a rounding error short still count
+	if (ticks > _maxTicksPerFrame) {
+		// Over budget: run what fits and let the simulation fall behind the clock
+		_droppedTicks += static_cast<uint64_t>(ticks) - _maxTicksPerFrame;
+		_accumulator -= (ticks - _maxTicksPerFrame) * _fixedStep;
+		ticks = _maxTicksPerFrame;
+	}
+	_tickCount = static_cast<int>(ticks);
+	_accumulator = std::max(0.0, _accumulator - ticks * _fixedStep);
 }
 
 float TimeController::GetDeltaTime() const {
@@ -42,3 +65,17 @@ float TimeController::GetSpeedCoefficient() const {
 	return _speedCoefficient;
 }
 
+void TimeController::SetFixedStep(float step, int maxTicksPerFrame) {
+	_fixedStep = std::max(step, 0.0f);
+	_maxTicksPerFrame = std::max(maxTicksPerFrame, 1);
+	_accumulator = 0.0;
+	_tickCount = 0;
+}
+
+float TimeController::GetInterpolationAlpha() const {
+	if (!IsFixedStep()) {
+		return 1.0f;
+	}
+	return std::min(static_cast<float>(_accumulator / _fixedStep), 1.0f);
+}
+
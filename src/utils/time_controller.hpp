@@ -1,6 +1,7 @@
 #pragma once
 
 #include <SDL3/SDL.h>
+#include <cstdint>
 
 class TimeController {
 public:
@@ -9,6 +10,9 @@ public:
 	// Update internal time tracking (call each frame)
 	void Update();
 
+	// Same as Update() with a measured frame time instead of the clock (headless runs, tests)
+	void Update(float rawDeltaTime);
+
 	// Get the modified delta time (0 if paused, otherwise raw_dt * coefficient)
 	float GetDeltaTime() const;
 
@@ -20,10 +24,32 @@ public:
 	void SetSpeedCoefficient(float coefficient);
 	float GetSpeedCoefficient() const;
 
+	// Fixed-step mode (step > 0): the modified delta time accumulates and is spent in whole steps,
+	// so speeding up runs more ticks instead of bigger ones. At most maxTicksPerFrame are run per
+	// frame; time beyond that budget is dropped so a slow frame cannot snowball. step <= 0 turns it off.
+	void SetFixedStep(float step, int maxTicksPerFrame);
+	bool IsFixedStep() const { return _fixedStep > 0.0f; }
+	float GetFixedStep() const { return _fixedStep; }
+
+	// Fixed steps to simulate this frame
+	int GetTickCount() const { return _tickCount; }
+
+	// How far the accumulator is into the next step [0, 1): render between the last two ticks with this
+	float GetInterpolationAlpha() const;
+
+	// Ticks dropped because the catch-up budget ran out
+	uint64_t GetDroppedTicks() const { return _droppedTicks; }
+
 private:
 	Uint64 _lastTime;
 	bool _isPaused;
 	float _speedCoefficient;
 	float _rawDeltaTime;
-};
 
+	// Fixed-step accumulator (double so long sessions do not drift)
+	float _fixedStep = 0.0f;
+	int _maxTicksPerFrame = 1;
+	double _accumulator = 0.0;
+	int _tickCount = 0;
+	uint64_t _droppedTicks = 0;
+};
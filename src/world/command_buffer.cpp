@@ -0,0 +1,45 @@
+#include "command_buffer.hpp"
+
+CommandBuffer::~CommandBuffer() {
+	disposePayloads();
+}
+
+void CommandBuffer::Destroy(entt::entity entity) {
+	_commands.push_back({entity, nullptr, nullptr, nullptr});
+}
+
+void CommandBuffer::Flush(entt::registry& registry) {
+	for (size_t i = 0; i < _commands.size();) {
+		const Command& command = _commands[i];
+		if (command.apply) {
+			command.apply(registry, command.entity, command.payload);
+			++i;
+			continue;
+		}
+
+		// Batch a run of destroys into one registry call, matching how systems destroyed entities before
+		_destroyBatch.clear();
+		for (; i < _commands.size() && !_commands[i].apply; ++i) {
+			if (registry.valid(_commands[i].entity)) {
+				_destroyBatch.push_back(_commands[i].entity);
+			}
+		}
+		registry.destroy(_destroyBatch.begin(), _destroyBatch.end());
+	}
+
+	Clear();
+}
+
+void CommandBuffer::Clear() {
+	disposePayloads();
+	_commands.clear();
+	_arena.Reset();
+}
+
+void CommandBuffer::disposePayloads() {
+	for (const auto& command : _commands) {
+		if (command.dispose) {
+			command.dispose(command.payload);
+		}
+	}
+}
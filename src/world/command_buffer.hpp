@@ -0,0 +1,124 @@
+#pragma once
+
+#include <entt/entt.hpp>
+#include "../utils/frame_arena.hpp"
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Records structural registry changes (create, destroy, add/remove component) so systems can
+// iterate views without invalidating them, and applies them later at a sync point with Flush().
+// Commands are applied in the order they were recorded. Payloads live in a FrameArena that is
+// reset on every flush, so recording does no heap allocation once the buffers have warmed up.
+// A buffer is not thread-safe: parallel passes record into one buffer per chunk and flush them in chunk order.
+class CommandBuffer {
+public:
+	CommandBuffer() = default;
+	~CommandBuffer();
+
+	CommandBuffer(const CommandBuffer&) = delete;
+	CommandBuffer& operator=(const CommandBuffer&) = delete;
+	CommandBuffer(CommandBuffer&&) = default;
+	CommandBuffer& operator=(CommandBuffer&&) = default;
+
+	// Create an entity with the given components (emplaced in argument order)
+	template<typename... Components>
+	void Create(Components&&... components);
+
+	// Add a component, or replace it if the entity already has one. Empty types (tags) are only added if missing.
+	template<typename Component, typename... Args>
+	void Emplace(entt::entity entity, Args&&... args);
+
+	// Remove a component if present
+	template<typename Component>
+	void Remove(entt::entity entity);
+
+	// Destroy an entity. Consecutive destroys are applied as one batch, like registry.destroy(first, last),
+	// so an entity must not be queued for destruction twice in a row.
+	void Destroy(entt::entity entity);
+
+	// Apply every recorded command to the registry, then reset the buffer.
+	// Commands targeting entities that are no longer valid are skipped.
+	void Flush(entt::registry& registry);
+
+	// Drop every recorded command without applying it
+	void Clear();
+
+	bool IsEmpty() const { return _commands.empty(); }
+	size_t GetCommandCount() const { return _commands.size(); }
+
+private:
+	using ApplyFn = void (*)(entt::registry& registry, entt::entity entity, void* payload);
+	using DisposeFn = void (*)(void* payload);
+
+	struct Command {
+		entt::entity entity;
+		ApplyFn apply;       // nullptr for Destroy
+		DisposeFn dispose;   // nullptr when the payload is trivially destructible
+		void* payload;
+	};
+
+	// Construct a payload in the arena
+	template<typename T, typename... Args>
+	T* construct(Args&&... args) {
+		void* memory = _arena.Allocate(sizeof(T), alignof(T));
+		return new (memory) T{std::forward<Args>(args)...};
+	}
+
+	template<typename T>
+	void record(entt::entity entity, ApplyFn apply, T* payload) {
+		DisposeFn dispose = nullptr;
+		if constexpr (!std::is_trivially_destructible_v<T>) {
+			dispose = [](void* data) { static_cast<T*>(data)->~T(); };
+		}
+		_commands.push_back({entity, apply, dispose, payload});
+	}
+
+	void disposePayloads();
+
+	std::vector<Command> _commands;
+	std::vector<entt::entity> _destroyBatch;
+	FrameArena _arena{4 * 1024};
+};
+
+template<typename... Components>
+void CommandBuffer::Create(Components&&... components) {
+	using Payload = std::tuple<std::decay_t<Components>...>;
+	Payload* payload = construct<Payload>(std::forward<Components>(components)...);
+
+	record(entt::null, [](entt::registry& registry, entt::entity, void* data) {
+		auto entity = registry.create();
+		std::apply([&](auto&... component) {
+			(registry.emplace<std::decay_t<decltype(component)>>(entity, std::move(component)), ...);
+		}, *static_cast<Payload*>(data));
+	}, payload);
+}
+
+template<typename Component, typename... Args>
+void CommandBuffer::Emplace(entt::entity entity, Args&&... args) {
+	if constexpr (std::is_empty_v<Component>) {
+		_commands.push_back({entity, [](entt::registry& registry, entt::entity target, void*) {
+			if (registry.valid(target) && !registry.all_of<Component>(target)) {
+				registry.emplace<Component>(target);
+			}
+		}, nullptr, nullptr});
+	} else {
+		Component* payload = construct<Component>(std::forward<Args>(args)...);
+		record(entity, [](entt::registry& registry, entt::entity target, void* data) {
+			if (registry.valid(target)) {
+				registry.emplace_or_replace<Component>(target, std::move(*static_cast<Component*>(data)));
+			}
+		}, payload);
+	}
+}
+
+template<typename Component>
+void CommandBuffer::Remove(entt::entity entity) {
+	_commands.push_back({entity, [](entt::registry& registry, entt::entity target, void*) {
+		if (registry.valid(target)) {
+			registry.remove<Component>(target);
+		}
+	}, nullptr, nullptr});
+}
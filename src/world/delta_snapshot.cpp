@@ -0,0 +1,79 @@
+#include "delta_snapshot.hpp"
+#include <fstream>
+#include <iostream>
+
+void DeltaRecorder::Reset() {
+	for (auto& pool : _pools) {
+		pool->Reset(_registry);
+	}
+}
+
+void DeltaRecorder::Capture(std::vector<std::byte>& out, const std::vector<std::byte>* extra) {
+	_removed.clear();
+	_record.clear();
+	for (auto& pool : _pools) {
+		pool->Capture(_registry, _record, _removed);
+	}
+
+	// Entities that lost components and are gone entirely
+	std::sort(_removed.begin(), _removed.end());
+	_removed.erase(std::unique(_removed.begin(), _removed.end()), _removed.end());
+	_removed.erase(std::remove_if(_removed.begin(), _removed.end(),
+		[this](entt::entity entity) { return _registry.valid(entity); }), _removed.end());
+
+	DeltaRecordHeader header;
+	size_t extraSize = extra ? extra->size() : 0;
+	header.size = _removed.size() * sizeof(entt::entity) + _record.size() + extraSize;
+	header.poolCount = static_cast<uint32_t>(_pools.size());
+	header.destroyedCount = static_cast<uint32_t>(_removed.size());
+
+	const auto* headerBytes = reinterpret_cast<const std::byte*>(&header);
+	const auto* destroyedBytes = reinterpret_cast<const std::byte*>(_removed.data());
+	out.insert(out.end(), headerBytes, headerBytes + sizeof(header));
+	out.insert(out.end(), destroyedBytes, destroyedBytes + _removed.size() * sizeof(entt::entity));
+	out.insert(out.end(), _record.begin(), _record.end());
+	if (extraSize > 0) {
+		out.insert(out.end(), extra->begin(), extra->end());
+	}
+}
+
+bool DeltaChain::AppendDelta(const std::string& keyframePath, const std::vector<std::byte>& records) {
+	std::ofstream os(GetChainPath(keyframePath), std::ios::binary | std::ios::app);
+	if (!os.is_open()) {
+		std::cerr << "Failed to open file for writing: " << GetChainPath(keyframePath) << std::endl;
+		return false;
+	}
+	os.write(reinterpret_cast<const char*>(records.data()), static_cast<std::streamsize>(records.size()));
+	return os.good();
+}
+
+bool DeltaChain::openChain(const std::string& keyframePath, uint64_t schemaHash, MappedFile& file, Reader& records) {
+	if (!file.Open(GetChainPath(keyframePath))) {
+		return false;
+	}
+
+	records = {file.GetData(), file.GetData() + file.GetSize()};
+	DeltaChainHeader header;
+	return records.Read(&header, sizeof(header)) &&
+		std::memcmp(header.magic, Magic, sizeof(Magic)) == 0 &&
+		header.version == Version &&
+		header.schemaHash == schemaHash;
+}
+
+bool DeltaChain::nextRecord(Reader& records, DeltaRecordHeader& header, Reader& record) {
+	if (!records.Read(&header, sizeof(header)) || static_cast<uint64_t>(records.end - records.cursor) < header.size) {
+		return false;
+	}
+	record = {records.cursor, records.cursor + header.size};
+	records.cursor += header.size;
+	return true;
+}
+
+entt::entity DeltaChain::mapOrCreate(entt::registry& registry, DeltaEntityMap& entities, entt::entity saved) {
+	entt::entity entity = entities.Map(saved);
+	if (entity == entt::null || !registry.valid(entity)) {
+		entity = registry.create();
+		entities._created[saved] = entity;
+	}
+	return entity;
+}
@@ -0,0 +1,445 @@
+#pragma once
+
+#include <entt/entt.hpp>
+#include "snapshot_file.hpp"
+#include "../utils/mapped_file.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+// Incremental saves on top of SnapshotFile: a ".snap" keyframe plus a chain file of deltas (keyframe path + ".delta").
+//
+// DeltaRecorder listens to on_construct/on_destroy of every listed pool and logs the structural changes in the
+// order they happen. Values of most pools are diffed against a shadow copy of the previous capture instead of
+// relying on on_update: gameplay writes components in place through views, so on_update never fires for them.
+// The shadow costs one component plus one entity per entity index, and every capture compares the whole pool.
+// Pools whose writers all publish on_update (registry.patch/replace) can be listed as patched instead: they keep
+// only a dirty list, and a capture writes just the entities updated or constructed since the previous one.
+// A delta therefore holds only the structural operations plus the entities whose values changed.
+//
+// Replaying a delta repeats each pool's operations in order, so every pool ends up in the same storage order as
+// the recorded world and views iterate identically after a reconstruct.
+
+// Record layout in the chain file:
+//   DeltaRecordHeader, entt::entity destroyed[destroyedCount], then per pool in list order:
+//   uint32 opCount, uint32 changedCount, DeltaOp ops[opCount], entt::entity changed[changedCount],
+//   component values[changedCount] (omitted for tags),
+//   then the rest of the record is the extra block: state outside the registry, stored whole in every delta
+//   (like the keyframe's SnapshotFile extra block), possibly empty
+struct DeltaChainHeader {
+	char magic[8];       // "RTSDELT" + '\0'
+	uint32_t version;
+	uint32_t reserved;
+	uint64_t schemaHash; // SnapshotFile::SchemaHash of the keyframe's component list
+};
+
+struct DeltaRecordHeader {
+	uint64_t size;          // Bytes following this header
+	uint32_t poolCount;
+	uint32_t destroyedCount;
+};
+
+struct DeltaOp {
+	entt::entity entity;
+	uint32_t kind; // DeltaOp::Construct or DeltaOp::Destroy
+
+	static constexpr uint32_t Construct = 0;
+	static constexpr uint32_t Destroy = 1;
+};
+
+class DeltaRecorder {
+public:
+	// Connects to the registry's signals until destroyed. Call Reset() once the base state has been written.
+	// Components also listed in Patched are tracked through on_update instead of a shadow copy.
+	template<typename... Components, typename... Patched>
+	DeltaRecorder(entt::registry& registry, entt::type_list<Components...>, entt::type_list<Patched...> = {});
+
+	DeltaRecorder(const DeltaRecorder&) = delete;
+	DeltaRecorder& operator=(const DeltaRecorder&) = delete;
+
+	// Make the current state the base of the next delta
+	void Reset();
+
+	// Append one delta record (changes since the last Reset/Capture, plus extra as its extra block) to out and
+	// make the current state the new base
+	void Capture(std::vector<std::byte>& out, const std::vector<std::byte>* extra = nullptr);
+
+private:
+	// Per component pool: signal log and value shadow
+	class Pool {
+	public:
+		virtual ~Pool() = default;
+		virtual void Reset(entt::registry& registry) = 0;
+		virtual void Capture(entt::registry& registry, std::vector<std::byte>& out, std::vector<entt::entity>& removed) = 0;
+	};
+
+	template<typename Component, bool Patched>
+	class PoolFor;
+
+	template<typename Component, typename... Patched>
+	static constexpr bool IsPatched = (std::is_same_v<Component, Patched> || ...);
+
+	entt::registry& _registry;
+	std::vector<std::unique_ptr<Pool>> _pools;
+	std::vector<entt::entity> _removed; // Scratch: entities that lost a component since the last capture
+	std::vector<std::byte> _record;     // Scratch: pool section of the record being built
+};
+
+// Saved entity -> loaded entity while a keyframe and its deltas are replayed
+class DeltaEntityMap {
+public:
+	entt::entity Map(entt::entity saved) const {
+		auto it = _created.find(saved);
+		return it != _created.end() ? it->second : _keyframe.Map(saved);
+	}
+
+private:
+	friend class DeltaChain;
+
+	SnapshotEntityMap _keyframe;
+	std::unordered_map<entt::entity, entt::entity> _created; // Entities created by deltas
+};
+
+class DeltaChain {
+public:
+	static constexpr uint32_t Version = 2;
+
+	static std::string GetChainPath(const std::string& keyframePath) { return keyframePath + ".delta"; }
+
+	// Write a keyframe snapshot (with extra as its extra block) and start an empty delta chain next to it
+	template<typename... Components>
+	static bool WriteKeyframe(const entt::registry& registry, const std::string& keyframePath, entt::type_list<Components...> components,
+		const std::vector<std::byte>* extra = nullptr);
+
+	// Append delta records produced by DeltaRecorder::Capture
+	static bool AppendDelta(const std::string& keyframePath, const std::vector<std::byte>& records);
+
+	// Number of deltas in the chain, -1 if the chain is missing or does not belong to this schema
+	template<typename... Components>
+	static int GetDeltaCount(const std::string& keyframePath, entt::type_list<Components...> components);
+
+	// Load the keyframe, then apply the first deltaCount deltas (-1 for all). The registry should be empty.
+	// extra (if given) receives the extra block of the last frame applied.
+	template<typename... Components>
+	static bool Load(entt::registry& registry, const std::string& keyframePath, entt::type_list<Components...> components,
+		int deltaCount, DeltaEntityMap& entities, std::vector<std::byte>* extra = nullptr);
+
+private:
+	// Bounds-checked cursor over a mapped record
+	struct Reader {
+		const std::byte* cursor;
+		const std::byte* end;
+
+		bool Read(void* out, size_t size) {
+			if (static_cast<size_t>(end - cursor) < size) return false;
+			std::memcpy(out, cursor, size);
+			cursor += size;
+			return true;
+		}
+	};
+
+	// Map the chain and return a reader over its records (header checked), or false
+	static bool openChain(const std::string& keyframePath, uint64_t schemaHash, MappedFile& file, Reader& records);
+
+	// Split off the next record; false at the end of the chain or on a truncated record
+	static bool nextRecord(Reader& records, DeltaRecordHeader& header, Reader& record);
+
+	static entt::entity mapOrCreate(entt::registry& registry, DeltaEntityMap& entities, entt::entity saved);
+
+	template<typename Component>
+	static bool applyPool(entt::registry& registry, Reader& record, DeltaEntityMap& entities);
+
+	static constexpr char Magic[8] = {'R', 'T', 'S', 'D', 'E', 'L', 'T', '\0'};
+};
+
+// Template implementations
+
+template<typename Component, bool Patched>
+class DeltaRecorder::PoolFor : public DeltaRecorder::Pool {
+public:
+	explicit PoolFor(entt::registry& registry)
+		: _construct(registry.on_construct<Component>().template connect<&PoolFor::onConstruct>(*this))
+		, _destroy(registry.on_destroy<Component>().template connect<&PoolFor::onDestroy>(*this))
+	{
+		if constexpr (Patched) {
+			_update = registry.on_update<Component>().template connect<&PoolFor::onUpdate>(*this);
+		}
+	}
+
+	void Reset(entt::registry& registry) override {
+		_ops.clear();
+		if constexpr (Patched) {
+			clearDirty();
+		} else if constexpr (!std::is_empty_v<Component>) {
+			std::fill(_present.begin(), _present.end(), uint8_t{0});
+			auto& storage = registry.storage<Component>();
+			const entt::entity* entities = storage.data();
+			for (size_t i = 0; i < storage.size(); ++i) {
+				remember(entities[i], storage.get(entities[i]));
+			}
+		}
+	}
+
+	void Capture(entt::registry& registry, std::vector<std::byte>& out, std::vector<entt::entity>& removed) override {
+		auto& storage = registry.storage<Component>();
+		size_t sectionStart = out.size();
+		uint32_t counts[2] = {static_cast<uint32_t>(_ops.size()), 0u};
+		append(out, counts, sizeof(counts));
+		append(out, _ops.data(), _ops.size() * sizeof(DeltaOp));
+
+		for (const DeltaOp& op : _ops) {
+			if (op.kind == DeltaOp::Destroy) {
+				removed.push_back(op.entity);
+				if constexpr (!Patched && !std::is_empty_v<Component>) {
+					forget(op.entity);
+				}
+			}
+		}
+		_ops.clear();
+
+		if constexpr (!std::is_empty_v<Component>) {
+			_changed.clear();
+			if constexpr (Patched) {
+				// Entities updated or constructed since the last capture that still have the component
+				for (entt::entity entity : _dirty) {
+					if (storage.contains(entity)) {
+						_changed.push_back(entity);
+					}
+				}
+				clearDirty();
+			} else {
+				// Values that differ from the shadow (new components have no shadow yet)
+				const entt::entity* entities = storage.data();
+				for (size_t i = 0; i < storage.size(); ++i) {
+					const Component& value = storage.get(entities[i]);
+					if (remember(entities[i], value)) {
+						_changed.push_back(entities[i]);
+					}
+				}
+			}
+
+			counts[1] = static_cast<uint32_t>(_changed.size());
+			std::memcpy(out.data() + sectionStart + sizeof(uint32_t), &counts[1], sizeof(uint32_t));
+			append(out, _changed.data(), _changed.size() * sizeof(entt::entity));
+			for (entt::entity entity : _changed) {
+				append(out, &storage.get(entity), sizeof(Component));
+			}
+		}
+	}
+
+private:
+	void onConstruct(entt::registry&, entt::entity entity) {
+		_ops.push_back({entity, DeltaOp::Construct});
+		if constexpr (Patched) {
+			markDirty(entity);
+		}
+	}
+
+	void onDestroy(entt::registry&, entt::entity entity) { _ops.push_back({entity, DeltaOp::Destroy}); }
+	void onUpdate(entt::registry&, entt::entity entity) { markDirty(entity); }
+
+	static void append(std::vector<std::byte>& out, const void* data, size_t size) {
+		const auto* bytes = static_cast<const std::byte*>(data);
+		out.insert(out.end(), bytes, bytes + size);
+	}
+
+	// Store value in the shadow; true if it differs from what was there
+	bool remember(entt::entity entity, const Component& value) {
+		auto index = static_cast<size_t>(entt::to_entity(entity));
+		if (index >= _shadow.size()) {
+			_shadow.resize(index + 1);
+			_owners.resize(index + 1, entt::null);
+			_present.resize(index + 1, 0);
+		}
+		bool changed = !_present[index] || _owners[index] != entity || std::memcmp(&_shadow[index], &value, sizeof(Component)) != 0;
+		std::memcpy(&_shadow[index], &value, sizeof(Component));
+		_owners[index] = entity;
+		_present[index] = 1;
+		return changed;
+	}
+
+	void forget(entt::entity entity) {
+		auto index = static_cast<size_t>(entt::to_entity(entity));
+		if (index < _owners.size() && _owners[index] == entity) {
+			_present[index] = 0;
+		}
+	}
+
+	// Add entity to the dirty list once; a recycled index holds the newer entity, so both get listed
+	void markDirty(entt::entity entity) {
+		auto index = static_cast<size_t>(entt::to_entity(entity));
+		if (index >= _marked.size()) {
+			_marked.resize(index + 1, entt::null);
+		}
+		if (_marked[index] != entity) {
+			_marked[index] = entity;
+			_dirty.push_back(entity);
+		}
+	}
+
+	void clearDirty() {
+		for (entt::entity entity : _dirty) {
+			_marked[static_cast<size_t>(entt::to_entity(entity))] = entt::null;
+		}
+		_dirty.clear();
+	}
+
+	entt::scoped_connection _construct;
+	entt::scoped_connection _destroy;
+	entt::scoped_connection _update; // Patched pools only
+	std::vector<DeltaOp> _ops;
+
+	// Shadow of the last captured values, indexed by entity index (diffed pools only)
+	std::vector<Component> _shadow;
+	std::vector<entt::entity> _owners;
+	std::vector<uint8_t> _present;
+
+	// Entities updated or constructed since the last capture, and the entity each index was listed for (patched pools only)
+	std::vector<entt::entity> _dirty;
+	std::vector<entt::entity> _marked;
+
+	std::vector<entt::entity> _changed;
+};
+
+template<typename... Components, typename... Patched>
+DeltaRecorder::DeltaRecorder(entt::registry& registry, entt::type_list<Components...>, entt::type_list<Patched...>)
+	: _registry(registry)
+{
+	static_assert((std::is_trivially_copyable_v<Components> && ...), "Delta components are copied as raw bytes");
+	(_pools.push_back(std::make_unique<PoolFor<Components, IsPatched<Components, Patched...>>>(registry)), ...);
+}
+
+template<typename... Components>
+bool DeltaChain::WriteKeyframe(const entt::registry& registry, const std::string& keyframePath, entt::type_list<Components...> components,
+	const std::vector<std::byte>* extra) {
+	if (!SnapshotFile::Save(registry, keyframePath, components, extra)) {
+		return false;
+	}
+
+	std::ofstream os(GetChainPath(keyframePath), std::ios::binary | std::ios::trunc);
+	if (!os.is_open()) {
+		std::cerr << "Failed to open file for writing: " << GetChainPath(keyframePath) << std::endl;
+		return false;
+	}
+	DeltaChainHeader header = {};
+	std::memcpy(header.magic, Magic, sizeof(Magic));
+	header.version = Version;
+	header.schemaHash = SnapshotFile::SchemaHash(components);
+	os.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	return os.good();
+}
+
+template<typename... Components>
+int DeltaChain::GetDeltaCount(const std::string& keyframePath, entt::type_list<Components...> components) {
+	MappedFile file;
+	Reader records;
+	if (!openChain(keyframePath, SnapshotFile::SchemaHash(components), file, records)) {
+		return -1;
+	}
+
+	int count = 0;
+	DeltaRecordHeader header;
+	Reader record;
+	while (nextRecord(records, header, record)) {
+		count++;
+	}
+	return count;
+}
+
+template<typename... Components>
+bool DeltaChain::Load(entt::registry& registry, const std::string& keyframePath, entt::type_list<Components...> components,
+	int deltaCount, DeltaEntityMap& entities, std::vector<std::byte>* extra)
+{
+	entities._created.clear();
+	if (!SnapshotFile::Load(registry, keyframePath, components, entities._keyframe, extra)) {
+		return false;
+	}
+	if (deltaCount == 0) {
+		return true;
+	}
+
+	MappedFile file;
+	Reader records;
+	if (!openChain(keyframePath, SnapshotFile::SchemaHash(components), file, records)) {
+		std::cerr << "Missing or stale delta chain: " << GetChainPath(keyframePath) << std::endl;
+		return false;
+	}
+
+	DeltaRecordHeader header;
+	Reader record;
+	for (int delta = 0; deltaCount < 0 || delta < deltaCount; ++delta) {
+		if (!nextRecord(records, header, record)) {
+			if (deltaCount < 0) break; // Applied the whole chain
+			std::cerr << "Delta chain has fewer than " << deltaCount << " deltas: " << GetChainPath(keyframePath) << std::endl;
+			return false;
+		}
+
+		std::vector<entt::entity> destroyed(header.destroyedCount);
+		bool valid = header.poolCount == sizeof...(Components) &&
+			record.Read(destroyed.data(), destroyed.size() * sizeof(entt::entity)) &&
+			(applyPool<Components>(registry, record, entities) && ...);
+		if (!valid) {
+			std::cerr << "Delta " << delta << " is corrupt: " << GetChainPath(keyframePath) << std::endl;
+			return false;
+		}
+
+		for (entt::entity saved : destroyed) {
+			entt::entity entity = entities.Map(saved);
+			if (registry.valid(entity)) {
+				registry.destroy(entity);
+			}
+			entities._created.erase(saved);
+		}
+
+		if (extra) {
+			extra->assign(record.cursor, record.end);
+		}
+	}
+	return true;
+}
+
+template<typename Component>
+bool DeltaChain::applyPool(entt::registry& registry, Reader& record, DeltaEntityMap& entities) {
+	uint32_t counts[2];
+	if (!record.Read(counts, sizeof(counts))) {
+		return false;
+	}
+
+	// Structural operations in recorded order, so the storage order matches the recorded world
+	for (uint32_t i = 0; i < counts[0]; ++i) {
+		DeltaOp op;
+		if (!record.Read(&op, sizeof(op))) {
+			return false;
+		}
+		entt::entity entity = mapOrCreate(registry, entities, op.entity);
+		if (op.kind == DeltaOp::Construct) {
+			registry.emplace_or_replace<Component>(entity);
+		} else {
+			registry.remove<Component>(entity);
+		}
+	}
+
+	// Final values of the changed components
+	if constexpr (!std::is_empty_v<Component>) {
+		std::vector<entt::entity> changed(counts[1]);
+		if (!record.Read(changed.data(), changed.size() * sizeof(entt::entity))) {
+			return false;
+		}
+		for (entt::entity saved : changed) {
+			Component value;
+			if (!record.Read(&value, sizeof(Component))) {
+				return false;
+			}
+			registry.emplace_or_replace<Component>(mapOrCreate(registry, entities, saved), value);
+		}
+	}
+	return true;
+}
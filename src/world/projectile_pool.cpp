@@ -0,0 +1,229 @@
+#include "projectile_pool.hpp"
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+
+size_t ProjectilePool::Activate(const ProjectileLaunch& launch) {
+	if (_count == _originX.size()) {
+		grow();
+	}
+
+	size_t index = _count++;
+	_originX[index] = launch.position.x;
+	_originY[index] = launch.position.y;
+	_vx[index] = launch.velocity.x;
+	_vy[index] = launch.velocity.y;
+	_targetX[index] = launch.target.x;
+	_targetY[index] = launch.target.y;
+	_speed[index] = launch.speed;
+	_launchTime[index] = _time;
+	_damage[index] = launch.projectile.damage;
+	_aoeRadius[index] = launch.projectile.aoe_radius;
+	_faction[index] = launch.projectile.faction;
+	_aoe[index] = launch.projectile.is_aoe ? 1 : 0;
+
+	// Straight flight at a fixed speed: it arrives once it has covered all but ArrivalDistance
+	float distance = Vec2::distance(launch.position, launch.target);
+	float arrival = 0.0f;
+	if (launch.speed > 0.0f) {
+		_flightTime[index] = distance / launch.speed;
+		arrival = std::max(0.0f, distance - ArrivalDistance) / launch.speed;
+	} else {
+		_flightTime[index] = 0.0f;
+	}
+	_impacts.push_back({_time + arrival, _ids[index]});
+	std::push_heap(_impacts.begin(), _impacts.end(), std::greater<Impact>());
+	return index;
+}
+
+void ProjectilePool::Deactivate(size_t index) {
+	size_t last = --_count;
+	if (index == last) {
+		return;
+	}
+
+	_originX[index] = _originX[last];
+	_originY[index] = _originY[last];
+	_vx[index] = _vx[last];
+	_vy[index] = _vy[last];
+	_targetX[index] = _targetX[last];
+	_targetY[index] = _targetY[last];
+	_speed[index] = _speed[last];
+	_flightTime[index] = _flightTime[last];
+	_launchTime[index] = _launchTime[last];
+	_damage[index] = _damage[last];
+	_aoeRadius[index] = _aoeRadius[last];
+	_faction[index] = _faction[last];
+	_aoe[index] = _aoe[last];
+
+	// The freed id goes to the first inactive slot, where the next Activate picks it up
+	std::swap(_ids[index], _ids[last]);
+	_slots[_ids[index]] = static_cast<uint32_t>(index);
+	_slots[_ids[last]] = static_cast<uint32_t>(last);
+}
+
+void ProjectilePool::Clear() {
+	_count = 0;
+	_impacts.clear();
+}
+
+void ProjectilePool::Reserve(size_t capacity) {
+	while (_originX.size() < capacity) {
+		grow();
+	}
+	_impacts.reserve(_originX.size());
+}
+
+void ProjectilePool::grow() {
+	size_t old_capacity = _originX.size();
+	size_t capacity = _originX.empty() ? 256 : old_capacity * 2;
+	for (auto* column : {&_originX, &_originY, &_vx, &_vy, &_targetX, &_targetY, &_speed, &_flightTime, &_damage, &_aoeRadius}) {
+		column->resize(capacity);
+	}
+	_launchTime.resize(capacity);
+	_faction.resize(capacity);
+	_aoe.resize(capacity);
+
+	// New slots start with their own index as id
+	_ids.resize(capacity);
+	_slots.resize(capacity);
+	for (size_t i = old_capacity; i < capacity; ++i) {
+		_ids[i] = static_cast<uint32_t>(i);
+		_slots[i] = static_cast<uint32_t>(i);
+	}
+}
+
+void ProjectilePool::Advance(float dt, std::vector<uint32_t>& hits) {
+	_time += dt;
+
+	// Past its arrival time a projectile is within ArrivalDistance of the target (or on it)
+	size_t first = hits.size();
+	while (!_impacts.empty() && _impacts.front().time < _time - TimeTolerance) {
+		hits.push_back(_slots[_impacts.front().id]);
+		std::pop_heap(_impacts.begin(), _impacts.end(), std::greater<Impact>());
+		_impacts.pop_back();
+	}
+	std::sort(hits.begin() + first, hits.end());
+}
+
+Vec2 ProjectilePool::positionAt(size_t index, double time) const {
+	// Not moved yet before its launch, and stopped on the target instead of flying past it
+	double elapsed = time - _launchTime[index];
+	if (elapsed >= _flightTime[index]) {
+		return Vec2(_targetX[index], _targetY[index]);
+	}
+	float t = static_cast<float>(std::max(elapsed, 0.0));
+	return Vec2(_originX[index] + _vx[index] * t, _originY[index] + _vy[index] * t);
+}
+
+void ProjectilePool::Write(std::vector<std::byte>& out) const {
+	SectionHeader header = {SectionVersion, static_cast<uint32_t>(_count), _time, _previousTime};
+
+	// Impact times by slot, taken from the heap
+	std::vector<double> impacts(_count);
+	for (const Impact& impact : _impacts) {
+		impacts[_slots[impact.id]] = impact.time;
+	}
+
+	auto append = [&out](const void* data, size_t size) {
+		const auto* bytes = static_cast<const std::byte*>(data);
+		out.insert(out.end(), bytes, bytes + size);
+	};
+	append(&header, sizeof(header));
+	for (const auto* column : {&_originX, &_originY, &_vx, &_vy, &_targetX, &_targetY, &_speed, &_flightTime, &_damage, &_aoeRadius}) {
+		append(column->data(), _count * sizeof(float));
+	}
+	append(_launchTime.data(), _count * sizeof(double));
+	append(impacts.data(), _count * sizeof(double));
+	append(_faction.data(), _count * sizeof(int));
+	append(_aoe.data(), _count * sizeof(uint8_t));
+}
+
+bool ProjectilePool::Read(const std::byte* data, size_t size) {
+	Clear();
+	SectionHeader header;
+	if (size < sizeof(header)) {
+		return false;
+	}
+	std::memcpy(&header, data, sizeof(header));
+	size_t count = header.count;
+	size_t columns = count * (10 * sizeof(float) + 2 * sizeof(double) + sizeof(int) + sizeof(uint8_t));
+	if (header.version != SectionVersion || size - sizeof(header) != columns) {
+		return false;
+	}
+
+	Reserve(count);
+	const std::byte* cursor = data + sizeof(header);
+	auto read = [&cursor](void* out, size_t bytes) {
+		std::memcpy(out, cursor, bytes);
+		cursor += bytes;
+	};
+	for (auto* column : {&_originX, &_originY, &_vx, &_vy, &_targetX, &_targetY, &_speed, &_flightTime, &_damage, &_aoeRadius}) {
+		read(column->data(), count * sizeof(float));
+	}
+	read(_launchTime.data(), count * sizeof(double));
+	std::vector<double> impacts(count);
+	read(impacts.data(), count * sizeof(double));
+	read(_faction.data(), count * sizeof(int));
+	read(_aoe.data(), count * sizeof(uint8_t));
+
+	for (size_t i = 0; i < count; ++i) {
+		_impacts.push_back({impacts[i], _ids[i]});
+	}
+	std::make_heap(_impacts.begin(), _impacts.end(), std::greater<Impact>());
+	_count = count;
+	_time = header.time;
+	_previousTime = header.previousTime;
+	return true;
+}
+
+void ProjectilePool::ExportTo(entt::registry& registry) {
+	if (_count == 0) {
+		return;
+	}
+
+	std::vector<entt::entity> entities(_count);
+	std::vector<Position> positions;
+	std::vector<Projectile> projectiles;
+	std::vector<Movement> movements;
+	std::vector<Unit> units;
+	positions.reserve(_count);
+	projectiles.reserve(_count);
+	movements.reserve(_count);
+	units.reserve(_count);
+	for (size_t i = 0; i < _count; ++i) {
+		positions.push_back(Position{GetPosition(i)});
+		projectiles.push_back(GetProjectile(i));
+		movements.push_back(Movement{GetVelocity(i), GetTarget(i), _speed[i]});
+		units.push_back(Unit{UnitType::Footman, _faction[i]}); // Placeholder type, as for projectile entities
+	}
+	Clear();
+
+	// Components in the order update_ranged_combat creates them
+	registry.create(entities.begin(), entities.end());
+	registry.insert<Position>(entities.begin(), entities.end(), positions.begin());
+	registry.insert<Projectile>(entities.begin(), entities.end(), projectiles.begin());
+	registry.insert<Movement>(entities.begin(), entities.end(), movements.begin());
+	registry.insert<Unit>(entities.begin(), entities.end(), units.begin());
+}
+
+void ProjectilePool::AdoptFrom(entt::registry& registry) {
+	// Walk the packed array rather than a view so slots follow creation order
+	const auto& storage = registry.storage<Projectile>();
+	std::vector<entt::entity> adopted;
+	adopted.reserve(storage.size());
+	for (size_t i = 0; i < storage.size(); ++i) {
+		entt::entity entity = storage.data()[i];
+		const auto* pos = registry.try_get<Position>(entity);
+		const auto* movement = registry.try_get<Movement>(entity);
+		if (!pos || !movement) {
+			continue;
+		}
+
+		Activate({pos->value, movement->velocity, movement->target, movement->speed, storage.get(entity)});
+		adopted.push_back(entity);
+	}
+
+	registry.destroy(adopted.begin(), adopted.end());
+}
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <entt/entt.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "../components/components.hpp"
+
+// A shot fired this tick, recorded by a combat chunk and activated after the parallel loop
+struct ProjectileLaunch {
+	Vec2 position;
+	Vec2 velocity;
+	Vec2 target;
+	float speed;
+	Projectile projectile;
+};
+
+// Projectiles in flight kept outside the registry (global.projectile_pool).
+// Structure of arrays with the active projectiles packed at the front: Activate writes the slot after
+// the last active one, Deactivate moves the last active projectile into the freed slot. Slots are never
+// released, so once the pool has grown to the peak number in flight, firing and impacts neither allocate
+// nor add to or remove from any component pool.
+// Projectiles fly straight at a fixed speed, so nothing is stepped per tick: Activate computes when the
+// projectile comes within ArrivalDistance of its target and queues that time in a min-heap, positions are
+// evaluated from the launch point on demand, and Advance only pops the impacts the clock has passed.
+// A projectile never flies past its target, however long the step.
+class ProjectilePool {
+public:
+	static constexpr float ArrivalDistance = 0.5f;
+
+	// Take a slot for a new projectile launched now; returns its index
+	size_t Activate(const ProjectileLaunch& launch);
+
+	// Free a slot. The last active projectile moves into it, so indices above index are not stable.
+	void Deactivate(size_t index);
+
+	// Deactivate every projectile (keeps the slots)
+	void Clear();
+
+	// Grow the slots up front
+	void Reserve(size_t capacity);
+
+	// Move the clock forward by dt and append the indices of the projectiles that reached their target to
+	// hits (ascending). Costs one heap pop per impact, nothing per projectile in flight. Arrived projectiles
+	// stay active, at their impact point, until deactivated.
+	void Advance(float dt, std::vector<uint32_t>& hits);
+
+	// Remember the current time for GetPreviousPosition, for render interpolation (World::Step)
+	void StorePreviousPositions() { _previousTime = _time; }
+
+	size_t GetCount() const { return _count; }
+	size_t GetCapacity() const { return _originX.size(); }
+
+	Vec2 GetPosition(size_t index) const { return positionAt(index, _time); }
+	Vec2 GetPreviousPosition(size_t index) const { return positionAt(index, _previousTime); }
+	Vec2 GetVelocity(size_t index) const { return Vec2(_vx[index], _vy[index]); }
+	Vec2 GetTarget(size_t index) const { return Vec2(_targetX[index], _targetY[index]); }
+	int GetFaction(size_t index) const { return _faction[index]; }
+	Projectile GetProjectile(size_t index) const {
+		return Projectile{_damage[index], _faction[index], _aoe[index] != 0, _aoeRadius[index]};
+	}
+
+	// Save section: the clock and every column of the active slots, launch and impact times included, so a
+	// loaded pool lands each projectile on the same tick as the saved one. Write appends to out; Read replaces
+	// the pool and returns false (pool left empty) if the section is truncated or from another version.
+	void Write(std::vector<std::byte>& out) const;
+	bool Read(const std::byte* data, size_t size);
+
+	// Loading a save written in the other mode: ExportTo creates one projectile entity (Position, Projectile,
+	// Movement, Unit, like update_ranged_combat) per pooled projectile in slot order and empties the pool;
+	// AdoptFrom takes every projectile entity back in storage order, launching it again from where it is,
+	// and destroys it.
+	void ExportTo(entt::registry& registry);
+	void AdoptFrom(entt::registry& registry);
+
+private:
+	static constexpr uint32_t SectionVersion = 1;
+
+	struct SectionHeader {
+		uint32_t version;
+		uint32_t count;
+		double time;
+		double previousTime;
+	};
+
+	// Pending impact; ids stay with a projectile while Deactivate moves it between slots
+	struct Impact {
+		double time;
+		uint32_t id;
+		bool operator>(const Impact& other) const { return time > other.time; }
+	};
+
+	// Impacts due within this of now wait for the next tick: a projectile entity exactly ArrivalDistance
+	// from its target does not hit yet, and rounding in the clock must not make that case land early
+	static constexpr double TimeTolerance = 1.0e-6;
+
+	void grow();
+	Vec2 positionAt(size_t index, double time) const;
+
+	std::vector<float> _originX, _originY;
+	std::vector<float> _vx, _vy;
+	std::vector<float> _targetX, _targetY;
+	std::vector<float> _speed;
+	std::vector<float> _flightTime; // Seconds from launch to the target itself
+	std::vector<double> _launchTime;
+	std::vector<float> _damage;
+	std::vector<float> _aoeRadius;
+	std::vector<int> _faction;
+	std::vector<uint8_t> _aoe;
+	std::vector<uint32_t> _ids;   // Id of the projectile in each slot
+	std::vector<uint32_t> _slots; // Slot of each id
+	std::vector<Impact> _impacts; // Min-heap on time
+	size_t _count = 0;
+	double _time = 0.0;
+	double _previousTime = 0.0;
+};
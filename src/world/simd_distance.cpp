@@ -0,0 +1,321 @@
+#include "simd_distance.hpp"
+
+#if defined(__x86_64__) || defined(_M_X64)
+	#define RTS_SIMD_X86 1
+	#include <immintrin.h>
+	#if defined(_MSC_VER)
+		#include <intrin.h>
+	#endif
+#else
+	#define RTS_SIMD_X86 0
+#endif
+
+// GCC/Clang compile the AVX2 kernels for that target only; the rest of the binary stays baseline x86-64.
+// "fma" is deliberately not enabled so multiplies and adds are never contracted.
+#if RTS_SIMD_X86 && (defined(__GNUC__) || defined(__clang__))
+	#define RTS_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+	#define RTS_TARGET_AVX2
+#endif
+
+// ============================================================================
+// Scalar
+// ============================================================================
+
+static int findNearestScalar(const float* xs, const float* ys, uint32_t count, float px, float py, float& bestDistSq) {
+	int best = -1;
+	for (uint32_t i = 0; i < count; ++i) {
+		float dx = xs[i] - px;
+		float dy = ys[i] - py;
+		float distSq = dx * dx + dy * dy;
+		if (distSq < bestDistSq) {
+			bestDistSq = distSq;
+			best = static_cast<int>(i);
+		}
+	}
+	return best;
+}
+
+static uint32_t filterScalar(const float* xs, const float* ys, uint32_t count, float px, float py, float radiusSq,
+                             uint32_t* outIndices, float* outDistSq) {
+	uint32_t hits = 0;
+	for (uint32_t i = 0; i < count; ++i) {
+		float dx = xs[i] - px;
+		float dy = ys[i] - py;
+		float distSq = dx * dx + dy * dy;
+		if (distSq <= radiusSq) {
+			outIndices[hits] = i;
+			outDistSq[hits] = distSq;
+			hits++;
+		}
+	}
+	return hits;
+}
+
+#if RTS_SIMD_X86
+
+// Pick the minimum across lanes, preferring the lowest candidate index on ties.
+// Lanes that never improved still hold index -1.
+static int reduceLanes(const float* values, const int* indices, int laneCount, float& bestDistSq) {
+	int best = -1;
+	for (int lane = 0; lane < laneCount; ++lane) {
+		if (indices[lane] < 0) continue;
+		if (best < 0 || values[lane] < bestDistSq || (values[lane] == bestDistSq && indices[lane] < best)) {
+			bestDistSq = values[lane];
+			best = indices[lane];
+		}
+	}
+	return best;
+}
+
+// Finish the lanes' result with the scalar tail; tail indices are larger, so strict < keeps first-index ties
+static int finishNearest(int vectorBest, const float* xs, const float* ys, uint32_t start, uint32_t count,
+                         float px, float py, float& bestDistSq) {
+	int tailBest = findNearestScalar(xs + start, ys + start, count - start, px, py, bestDistSq);
+	return tailBest >= 0 ? static_cast<int>(start) + tailBest : vectorBest;
+}
+
+// ============================================================================
+// SSE2 (baseline on x86-64)
+// ============================================================================
+
+static int findNearestSSE2(const float* xs, const float* ys, uint32_t count, float px, float py, float& bestDistSq) {
+	const __m128 vpx = _mm_set1_ps(px);
+	const __m128 vpy = _mm_set1_ps(py);
+	const __m128i step = _mm_set1_epi32(4);
+	__m128 vbest = _mm_set1_ps(bestDistSq);
+	__m128i vbestIndex = _mm_set1_epi32(-1);
+	__m128i vindex = _mm_setr_epi32(0, 1, 2, 3);
+
+	uint32_t i = 0;
+	for (; i + 4 <= count; i += 4) {
+		__m128 dx = _mm_sub_ps(_mm_loadu_ps(xs + i), vpx);
+		__m128 dy = _mm_sub_ps(_mm_loadu_ps(ys + i), vpy);
+		__m128 distSq = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+
+		// Per lane: keep the earlier candidate unless strictly closer
+		__m128 closer = _mm_cmplt_ps(distSq, vbest);
+		__m128i closerMask = _mm_castps_si128(closer);
+		vbest = _mm_or_ps(_mm_and_ps(closer, distSq), _mm_andnot_ps(closer, vbest));
+		vbestIndex = _mm_or_si128(_mm_and_si128(closerMask, vindex), _mm_andnot_si128(closerMask, vbestIndex));
+		vindex = _mm_add_epi32(vindex, step);
+	}
+
+	alignas(16) float values[4];
+	alignas(16) int indices[4];
+	_mm_store_ps(values, vbest);
+	_mm_store_si128(reinterpret_cast<__m128i*>(indices), vbestIndex);
+
+	float lanesBest = bestDistSq;
+	int best = reduceLanes(values, indices, 4, lanesBest);
+	if (best >= 0) {
+		bestDistSq = lanesBest;
+	}
+	return finishNearest(best, xs, ys, i, count, px, py, bestDistSq);
+}
+
+static uint32_t filterSSE2(const float* xs, const float* ys, uint32_t count, float px, float py, float radiusSq,
+                           uint32_t* outIndices, float* outDistSq) {
+	const __m128 vpx = _mm_set1_ps(px);
+	const __m128 vpy = _mm_set1_ps(py);
+	const __m128 vradius = _mm_set1_ps(radiusSq);
+
+	uint32_t hits = 0;
+	uint32_t i = 0;
+	for (; i + 4 <= count; i += 4) {
+		__m128 dx = _mm_sub_ps(_mm_loadu_ps(xs + i), vpx);
+		__m128 dy = _mm_sub_ps(_mm_loadu_ps(ys + i), vpy);
+		__m128 distSq = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+
+		int mask = _mm_movemask_ps(_mm_cmple_ps(distSq, vradius));
+		if (mask == 0) continue;
+
+		alignas(16) float values[4];
+		_mm_store_ps(values, distSq);
+		for (int lane = 0; lane < 4; ++lane) {
+			if (mask & (1 << lane)) {
+				outIndices[hits] = i + lane;
+				outDistSq[hits] = values[lane];
+				hits++;
+			}
+		}
+	}
+
+	uint32_t tailHits = filterScalar(xs + i, ys + i, count - i, px, py, radiusSq, outIndices + hits, outDistSq + hits);
+	for (uint32_t h = hits; h < hits + tailHits; ++h) {
+		outIndices[h] += i;
+	}
+	return hits + tailHits;
+}
+
+// ============================================================================
+// AVX2
+// ============================================================================
+
+RTS_TARGET_AVX2
+static int findNearestAVX2(const float* xs, const float* ys, uint32_t count, float px, float py, float& bestDistSq) {
+	const __m256 vpx = _mm256_set1_ps(px);
+	const __m256 vpy = _mm256_set1_ps(py);
+	const __m256i step = _mm256_set1_epi32(8);
+	__m256 vbest = _mm256_set1_ps(bestDistSq);
+	__m256i vbestIndex = _mm256_set1_epi32(-1);
+	__m256i vindex = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+
+	uint32_t i = 0;
+	for (; i + 8 <= count; i += 8) {
+		__m256 dx = _mm256_sub_ps(_mm256_loadu_ps(xs + i), vpx);
+		__m256 dy = _mm256_sub_ps(_mm256_loadu_ps(ys + i), vpy);
+		__m256 distSq = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+
+		// Per lane: keep the earlier candidate unless strictly closer
+		__m256 closer = _mm256_cmp_ps(distSq, vbest, _CMP_LT_OQ);
+		vbest = _mm256_blendv_ps(vbest, distSq, closer);
+		vbestIndex = _mm256_blendv_epi8(vbestIndex, vindex, _mm256_castps_si256(closer));
+		vindex = _mm256_add_epi32(vindex, step);
+	}
+
+	alignas(32) float values[8];
+	alignas(32) int indices[8];
+	_mm256_store_ps(values, vbest);
+	_mm256_store_si256(reinterpret_cast<__m256i*>(indices), vbestIndex);
+
+	float lanesBest = bestDistSq;
+	int best = reduceLanes(values, indices, 8, lanesBest);
+	if (best >= 0) {
+		bestDistSq = lanesBest;
+	}
+	return finishNearest(best, xs, ys, i, count, px, py, bestDistSq);
+}
+
+RTS_TARGET_AVX2
+static uint32_t filterAVX2(const float* xs, const float* ys, uint32_t count, float px, float py, float radiusSq,
+                           uint32_t* outIndices, float* outDistSq) {
+	const __m256 vpx = _mm256_set1_ps(px);
+	const __m256 vpy = _mm256_set1_ps(py);
+	const __m256 vradius = _mm256_set1_ps(radiusSq);
+
+	uint32_t hits = 0;
+	uint32_t i = 0;
+	for (; i + 8 <= count; i += 8) {
+		__m256 dx = _mm256_sub_ps(_mm256_loadu_ps(xs + i), vpx);
+		__m256 dy = _mm256_sub_ps(_mm256_loadu_ps(ys + i), vpy);
+		__m256 distSq = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+
+		int mask = _mm256_movemask_ps(_mm256_cmp_ps(distSq, vradius, _CMP_LE_OQ));
+		if (mask == 0) continue;
+
+		alignas(32) float values[8];
+		_mm256_store_ps(values, distSq);
+		for (int lane = 0; lane < 8; ++lane) {
+			if (mask & (1 << lane)) {
+				outIndices[hits] = i + lane;
+				outDistSq[hits] = values[lane];
+				hits++;
+			}
+		}
+	}
+
+	uint32_t tailHits = filterScalar(xs + i, ys + i, count - i, px, py, radiusSq, outIndices + hits, outDistSq + hits);
+	for (uint32_t h = hits; h < hits + tailHits; ++h) {
+		outIndices[h] += i;
+	}
+	return hits + tailHits;
+}
+
+static bool cpuHasAvx2() {
+#if defined(_MSC_VER)
+	int info[4];
+	__cpuid(info, 0);
+	if (info[0] < 7) return false;
+
+	// AVX needs OS support for saving YMM state (OSXSAVE + XCR0 bits 1 and 2)
+	__cpuid(info, 1);
+	bool osxsave = (info[2] & (1 << 27)) != 0;
+	bool avx = (info[2] & (1 << 28)) != 0;
+	if (!osxsave || !avx) return false;
+	if ((_xgetbv(0) & 0x6) != 0x6) return false;
+
+	__cpuidex(info, 7, 0);
+	return (info[1] & (1 << 5)) != 0;
+#else
+	__builtin_cpu_init();
+	return __builtin_cpu_supports("avx2");
+#endif
+}
+
+#endif // RTS_SIMD_X86
+
+// ============================================================================
+// Dispatch
+// ============================================================================
+
+static SimdDistance::Level& activeLevel() {
+	static SimdDistance::Level level = SimdDistance::DetectLevel();
+	return level;
+}
+
+SimdDistance::Level SimdDistance::DetectLevel() {
+#if RTS_SIMD_X86
+	static const Level detected = cpuHasAvx2() ? Level::AVX2 : Level::SSE2;
+	return detected;
+#else
+	return Level::Scalar;
+#endif
+}
+
+bool SimdDistance::IsSupported(Level level) {
+	return static_cast<int>(level) <= static_cast<int>(DetectLevel());
+}
+
+SimdDistance::Level SimdDistance::GetLevel() {
+	return activeLevel();
+}
+
+SimdDistance::Level SimdDistance::SetLevel(Level level) {
+	activeLevel() = IsSupported(level) ? level : DetectLevel();
+	return activeLevel();
+}
+
+const char* SimdDistance::GetLevelName(Level level) {
+	switch (level) {
+		case Level::SSE2: return "SSE2";
+		case Level::AVX2: return "AVX2";
+		default: return "Scalar";
+	}
+}
+
+int SimdDistance::FindNearest(Level level, const float* xs, const float* ys, uint32_t count,
+                              float px, float py, float& bestDistSq) {
+#if RTS_SIMD_X86
+	switch (level) {
+		case Level::AVX2: return findNearestAVX2(xs, ys, count, px, py, bestDistSq);
+		case Level::SSE2: return findNearestSSE2(xs, ys, count, px, py, bestDistSq);
+		default: break;
+	}
+#endif
+	return findNearestScalar(xs, ys, count, px, py, bestDistSq);
+}
+
+uint32_t SimdDistance::FilterInRadius(Level level, const float* xs, const float* ys, uint32_t count,
+                                      float px, float py, float radiusSq,
+                                      uint32_t* outIndices, float* outDistSq) {
+#if RTS_SIMD_X86
+	switch (level) {
+		case Level::AVX2: return filterAVX2(xs, ys, count, px, py, radiusSq, outIndices, outDistSq);
+		case Level::SSE2: return filterSSE2(xs, ys, count, px, py, radiusSq, outIndices, outDistSq);
+		default: break;
+	}
+#endif
+	return filterScalar(xs, ys, count, px, py, radiusSq, outIndices, outDistSq);
+}
+
+int SimdDistance::FindNearest(const float* xs, const float* ys, uint32_t count,
+                              float px, float py, float& bestDistSq) {
+	return FindNearest(activeLevel(), xs, ys, count, px, py, bestDistSq);
+}
+
+uint32_t SimdDistance::FilterInRadius(const float* xs, const float* ys, uint32_t count,
+                                      float px, float py, float radiusSq,
+                                      uint32_t* outIndices, float* outDistSq) {
+	return FilterInRadius(activeLevel(), xs, ys, count, px, py, radiusSq, outIndices, outDistSq);
+}
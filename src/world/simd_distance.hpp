@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstdint>
+
+// Squared-distance kernels over packed x/y arrays, used by the packed SpatialGrid backend.
+// Every level computes dx * dx + dy * dy with separate multiplies and adds (no FMA) in candidate
+// order, so results are bit-identical to Vec2::distance_squared and to each other.
+class SimdDistance {
+public:
+	enum class Level {
+		Scalar,
+		SSE2, // 4 candidates per step
+		AVX2  // 8 candidates per step
+	};
+
+	// Spans longer than this are processed in chunks by callers that need a fixed output buffer
+	static constexpr uint32_t ChunkSize = 256;
+
+	// Best level supported by this CPU (checked once, at runtime)
+	static Level DetectLevel();
+
+	// Level used by the kernels below - defaults to DetectLevel()
+	static Level GetLevel();
+
+	// Force a level (e.g. tests comparing paths); clamped to what the CPU supports. Returns the level applied.
+	static Level SetLevel(Level level);
+
+	static bool IsSupported(Level level);
+	static const char* GetLevelName(Level level);
+
+	// Index of the first candidate with distance < bestDistSq, minimal among all candidates.
+	// Updates bestDistSq and returns the index, or -1 if nothing beat the incoming bestDistSq.
+	static int FindNearest(const float* xs, const float* ys, uint32_t count,
+	                       float px, float py, float& bestDistSq);
+
+	// Write indices (ascending) and squared distances of candidates with distance <= radiusSq.
+	// count must not exceed ChunkSize. Returns the number of hits written.
+	static uint32_t FilterInRadius(const float* xs, const float* ys, uint32_t count,
+	                               float px, float py, float radiusSq,
+	                               uint32_t* outIndices, float* outDistSq);
+
+	// Kernels for a specific level, bypassing dispatch (level must be supported)
+	static int FindNearest(Level level, const float* xs, const float* ys, uint32_t count,
+	                       float px, float py, float& bestDistSq);
+	static uint32_t FilterInRadius(Level level, const float* xs, const float* ys, uint32_t count,
+	                               float px, float py, float radiusSq,
+	                               uint32_t* outIndices, float* outDistSq);
+};
@@ -0,0 +1,205 @@
+#include "snapshot_codec.hpp"
+#include "snapshot_file.hpp"
+#include <lz4.h>
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+void SnapshotCodec::filter(const std::byte* raw, size_t size, uint32_t stride, std::byte* out) {
+	size_t words = stride / 4;
+	size_t count = size / stride;
+	size_t total = words * count;
+
+	for (size_t column = 0; column < words; ++column) {
+		uint32_t previous = 0;
+		for (size_t i = 0; i < count; ++i) {
+			uint32_t value;
+			std::memcpy(&value, raw + i * stride + column * 4, sizeof(value));
+			uint32_t delta = value - previous;
+			previous = value;
+
+			size_t k = column * count + i;
+			out[k] = static_cast<std::byte>(delta);
+			out[total + k] = static_cast<std::byte>(delta >> 8);
+			out[total * 2 + k] = static_cast<std::byte>(delta >> 16);
+			out[total * 3 + k] = static_cast<std::byte>(delta >> 24);
+		}
+	}
+}
+
+void SnapshotCodec::unfilter(const std::byte* filtered, size_t size, uint32_t stride, std::byte* out) {
+	size_t words = stride / 4;
+	size_t count = size / stride;
+	size_t total = words * count;
+
+	for (size_t column = 0; column < words; ++column) {
+		uint32_t value = 0;
+		for (size_t i = 0; i < count; ++i) {
+			size_t k = column * count + i;
+			uint32_t delta = static_cast<uint32_t>(filtered[k]) |
+				static_cast<uint32_t>(filtered[total + k]) << 8 |
+				static_cast<uint32_t>(filtered[total * 2 + k]) << 16 |
+				static_cast<uint32_t>(filtered[total * 3 + k]) << 24;
+			value += delta;
+			std::memcpy(out + i * stride + column * 4, &value, sizeof(value));
+		}
+	}
+}
+
+bool SnapshotCodec::splitImage(const std::vector<std::byte>& image, std::vector<SnapshotCodecBlock>& blocks) {
+	SnapshotHeader header;
+	if (image.size() < sizeof(header)) {
+		return false;
+	}
+	std::memcpy(&header, image.data(), sizeof(header));
+	size_t tableEnd = sizeof(header) + static_cast<size_t>(header.poolCount) * sizeof(SnapshotPool);
+	if (header.fileSize != image.size() || tableEnd > image.size()) {
+		return false;
+	}
+
+	auto addBlock = [&](uint64_t offset, uint64_t size, uint32_t stride) {
+		if (size == 0) {
+			return true;
+		}
+		if (offset > image.size() || size > image.size() - offset) {
+			return false;
+		}
+		blocks.push_back({offset, size, 0, stride % 4 == 0 ? stride : 0u, 0});
+		return true;
+	};
+
+	blocks.clear();
+	addBlock(0, tableEnd, 0);
+	for (uint32_t p = 0; p < header.poolCount; ++p) {
+		SnapshotPool pool;
+		std::memcpy(&pool, image.data() + sizeof(header) + p * sizeof(SnapshotPool), sizeof(pool));
+		if (!addBlock(pool.entityOffset, static_cast<uint64_t>(pool.count) * sizeof(entt::entity), sizeof(entt::entity)) ||
+			!addBlock(pool.dataOffset, static_cast<uint64_t>(pool.count) * pool.elementSize, pool.elementSize)) {
+			return false;
+		}
+	}
+	return addBlock(header.extraOffset, header.extraSize, 0);
+}
+
+bool SnapshotCodec::Encode(const std::vector<std::byte>& image, std::vector<std::byte>& encoded) {
+	std::vector<SnapshotCodecBlock> blocks;
+	if (!splitImage(image, blocks)) {
+		std::cerr << "Snapshot image is inconsistent, not compressing it" << std::endl;
+		return false;
+	}
+
+	size_t payloadStart = sizeof(SnapshotCodecHeader) + blocks.size() * sizeof(SnapshotCodecBlock);
+	encoded.clear();
+	encoded.reserve(payloadStart + image.size() / 2);
+	encoded.resize(payloadStart);
+
+	std::vector<std::byte> filtered;
+	for (SnapshotCodecBlock& block : blocks) {
+		const std::byte* raw = image.data() + block.imageOffset;
+		if (block.stride > 0) {
+			filtered.resize(block.rawSize);
+			filter(raw, block.rawSize, block.stride, filtered.data());
+			raw = filtered.data();
+		}
+
+		// Compress straight into the output; keep the bytes as they are if LZ4 cannot shrink them
+		size_t offset = encoded.size();
+		int compressed = 0;
+		if (block.rawSize <= LZ4_MAX_INPUT_SIZE) {
+			int rawSize = static_cast<int>(block.rawSize);
+			encoded.resize(offset + LZ4_compressBound(rawSize));
+			compressed = LZ4_compress_default(reinterpret_cast<const char*>(raw), reinterpret_cast<char*>(encoded.data() + offset),
+				rawSize, LZ4_compressBound(rawSize));
+		}
+		if (compressed > 0 && static_cast<uint64_t>(compressed) < block.rawSize) {
+			block.encodedSize = static_cast<uint64_t>(compressed);
+		} else {
+			encoded.resize(offset + block.rawSize);
+			std::memcpy(encoded.data() + offset, raw, block.rawSize);
+			block.encodedSize = block.rawSize;
+			block.flags |= Stored;
+		}
+		encoded.resize(offset + block.encodedSize);
+	}
+
+	SnapshotCodecHeader header = {};
+	std::memcpy(header.magic, Magic, sizeof(Magic));
+	header.version = Version;
+	header.blockCount = static_cast<uint32_t>(blocks.size());
+	header.imageSize = image.size();
+	std::memcpy(encoded.data(), &header, sizeof(header));
+	std::memcpy(encoded.data() + sizeof(header), blocks.data(), blocks.size() * sizeof(SnapshotCodecBlock));
+	return true;
+}
+
+bool SnapshotCodec::Decode(const std::byte* data, size_t size, std::vector<std::byte>& image, const std::string& source) {
+	SnapshotCodecHeader header;
+	if (size < sizeof(header)) {
+		std::cerr << "Compressed snapshot is truncated: " << source << std::endl;
+		return false;
+	}
+	std::memcpy(&header, data, sizeof(header));
+	if (std::memcmp(header.magic, Magic, sizeof(Magic)) != 0 || header.version != Version) {
+		std::cerr << "Not a compressed snapshot: " << source << std::endl;
+		return false;
+	}
+	if (header.blockCount > (size - sizeof(header)) / sizeof(SnapshotCodecBlock)) {
+		std::cerr << "Compressed snapshot is truncated: " << source << std::endl;
+		return false;
+	}
+
+	std::vector<SnapshotCodecBlock> blocks(header.blockCount);
+	std::memcpy(blocks.data(), data + sizeof(header), blocks.size() * sizeof(SnapshotCodecBlock));
+
+	// Validate the table before allocating anything it asks for. LZ4 never expands more than 255:1,
+	// and the image only ends with alignment padding after its last block.
+	uint64_t payload = sizeof(header) + blocks.size() * sizeof(SnapshotCodecBlock);
+	uint64_t imageEnd = 0;
+	for (const SnapshotCodecBlock& block : blocks) {
+		bool stored = (block.flags & Stored) != 0;
+		bool valid = block.encodedSize <= size - std::min<uint64_t>(payload, size) &&
+			block.rawSize <= block.encodedSize * 256 &&
+			(!stored || block.rawSize == block.encodedSize) &&
+			(stored || (block.encodedSize < block.rawSize && block.rawSize <= LZ4_MAX_INPUT_SIZE)) &&
+			block.stride % 4 == 0 && (block.stride == 0 || block.rawSize % block.stride == 0) &&
+			block.imageOffset <= header.imageSize && block.rawSize <= header.imageSize - block.imageOffset;
+		if (!valid) {
+			std::cerr << "Compressed snapshot is corrupt: " << source << std::endl;
+			return false;
+		}
+		payload += block.encodedSize;
+		imageEnd = std::max(imageEnd, block.imageOffset + block.rawSize);
+	}
+	if (payload != size || header.imageSize - imageEnd >= SnapshotFile::BlockAlignment) {
+		std::cerr << "Compressed snapshot is corrupt: " << source << std::endl;
+		return false;
+	}
+
+	image.assign(header.imageSize, std::byte{0});
+	std::vector<std::byte> filtered;
+	const std::byte* in = data + sizeof(header) + blocks.size() * sizeof(SnapshotCodecBlock);
+	for (const SnapshotCodecBlock& block : blocks) {
+		std::byte* out = image.data() + block.imageOffset;
+		if (block.stride > 0) {
+			filtered.resize(block.rawSize);
+			out = filtered.data();
+		}
+
+		if (block.flags & Stored) {
+			std::memcpy(out, in, block.rawSize);
+		} else {
+			int decoded = LZ4_decompress_safe(reinterpret_cast<const char*>(in), reinterpret_cast<char*>(out),
+				static_cast<int>(block.encodedSize), static_cast<int>(block.rawSize));
+			if (decoded < 0 || static_cast<uint64_t>(decoded) != block.rawSize) {
+				std::cerr << "Compressed snapshot is corrupt: " << source << std::endl;
+				return false;
+			}
+		}
+
+		if (block.stride > 0) {
+			unfilter(filtered.data(), block.rawSize, block.stride, image.data() + block.imageOffset);
+		}
+		in += block.encodedSize;
+	}
+	return true;
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Block compression for snapshot images (".snapz"), built on LZ4.
+// The image written by SnapshotFile::Capture is cut into blocks along its pool table: the header and
+// table, then each pool's entity and component blocks, then the extra block (unfiltered). Before LZ4, blocks of 4-byte-aligned elements
+// are filtered column by column: every 32-bit word of an element is stored as the difference from
+// the same word of the previous element, columns are laid out one after another and the result is
+// split into byte planes. Repeated stats (DirectDamage, Healer, ...) then become long zero runs and
+// sequential entity ids become runs of ones. The filter is integer arithmetic on the raw bits, so
+// floats come back bit-identical. Decoding rebuilds the exact image, which SnapshotFile::Read validates.
+
+struct SnapshotCodecHeader {
+	char magic[8];      // "RTSSNPZ" + '\0'
+	uint32_t version;
+	uint32_t blockCount;
+	uint64_t imageSize; // Decoded size
+};
+
+struct SnapshotCodecBlock {
+	uint64_t imageOffset; // Where the decoded block goes in the image
+	uint64_t rawSize;
+	uint64_t encodedSize;
+	uint32_t stride;      // Element size for the column filter, 0 when the block is not filtered
+	uint32_t flags;
+};
+
+class SnapshotCodec {
+public:
+	static constexpr uint32_t Version = 1;
+
+	// Block flags
+	static constexpr uint32_t Stored = 1; // LZ4 did not help, payload is the (filtered) bytes as is
+
+	// Compress a snapshot image. Returns false if the image's pool table is inconsistent.
+	static bool Encode(const std::vector<std::byte>& image, std::vector<std::byte>& encoded);
+
+	// Rebuild the image from Encode's output; source only names it in error messages
+	static bool Decode(const std::byte* data, size_t size, std::vector<std::byte>& image, const std::string& source);
+
+private:
+	// Column delta + byte planes, in place of raw (stride must be a multiple of 4)
+	static void filter(const std::byte* raw, size_t size, uint32_t stride, std::byte* out);
+	static void unfilter(const std::byte* filtered, size_t size, uint32_t stride, std::byte* out);
+
+	// Cut points of the image: header + pool table, then every non-empty pool block and the extra block
+	static bool splitImage(const std::vector<std::byte>& image, std::vector<SnapshotCodecBlock>& blocks);
+
+	static constexpr char Magic[8] = {'R', 'T', 'S', 'S', 'N', 'P', 'Z', '\0'};
+};
@@ -0,0 +1,94 @@
+#include "snapshot_file.hpp"
+#include <algorithm>
+
+uint64_t SnapshotFile::hashBytes(uint64_t hash, const void* data, size_t size) {
+	// FNV-1a
+	const auto* bytes = static_cast<const unsigned char*>(data);
+	for (size_t i = 0; i < size; ++i) {
+		hash ^= bytes[i];
+		hash *= 1099511628211ull;
+	}
+	return hash;
+}
+
+bool SnapshotFile::WriteImage(const std::vector<std::byte>& image, const std::string& path) {
+	std::ofstream os(path, std::ios::binary);
+	if (!os.is_open()) {
+		std::cerr << "Failed to open file for writing: " << path << std::endl;
+		return false;
+	}
+	os.write(reinterpret_cast<const char*>(image.data()), static_cast<std::streamsize>(image.size()));
+	return os.good();
+}
+
+const SnapshotPool* SnapshotFile::readPoolTable(const std::byte* data, size_t size, uint64_t schemaHash, size_t poolCount, const std::string& path) {
+	if (size < sizeof(SnapshotHeader)) {
+		std::cerr << "Snapshot is truncated: " << path << std::endl;
+		return nullptr;
+	}
+
+	SnapshotHeader header;
+	std::memcpy(&header, data, sizeof(header));
+	if (std::memcmp(header.magic, Magic, sizeof(Magic)) != 0) {
+		std::cerr << "Not a snapshot file: " << path << std::endl;
+		return nullptr;
+	}
+	if (header.version != Version || header.schemaHash != schemaHash || header.poolCount != poolCount) {
+		std::cerr << "Snapshot was written with a different component schema: " << path << std::endl;
+		return nullptr;
+	}
+	if (header.fileSize != size || size < sizeof(SnapshotHeader) + poolCount * sizeof(SnapshotPool)) {
+		std::cerr << "Snapshot is truncated: " << path << std::endl;
+		return nullptr;
+	}
+
+	return reinterpret_cast<const SnapshotPool*>(data + sizeof(SnapshotHeader));
+}
+
+bool SnapshotFile::checkPool(size_t size, const SnapshotPool& pool, uint64_t typeHash, uint32_t elementSize, size_t alignment) {
+	if (pool.typeHash != typeHash || pool.elementSize != elementSize) {
+		return false;
+	}
+
+	// A block must be aligned and lie inside the image
+	auto inside = [size](uint64_t offset, uint64_t count, uint64_t element, size_t align) {
+		return offset % align == 0 && offset <= size && count <= (size - offset) / std::max<uint64_t>(element, 1);
+	};
+	if (!inside(pool.entityOffset, pool.count, sizeof(entt::entity), alignof(entt::entity))) {
+		return false;
+	}
+	return elementSize == 0 || inside(pool.dataOffset, pool.count, elementSize, alignment);
+}
+
+void SnapshotFile::createEntities(entt::registry& registry, const std::byte* data, const SnapshotPool* pools, size_t poolCount, SnapshotEntityMap& entities) {
+	entities._saved.clear();
+	entities._loaded.clear();
+	entities._count = 0;
+
+	// Every saved entity, keyed by its index
+	for (size_t p = 0; p < poolCount; ++p) {
+		const entt::entity* saved = poolEntities(data, pools[p]);
+		for (uint32_t i = 0; i < pools[p].count; ++i) {
+			auto index = static_cast<size_t>(entt::to_entity(saved[i]));
+			if (index >= entities._saved.size()) {
+				entities._saved.resize(index + 1, entt::null);
+			}
+			if (entities._saved[index] == entt::null) {
+				entities._count++;
+			}
+			entities._saved[index] = saved[i];
+		}
+	}
+
+	// One bulk create, handed out in saved index order
+	std::vector<entt::entity> created(entities._count);
+	registry.create(created.begin(), created.end());
+
+	entities._loaded.assign(entities._saved.size(), entt::null);
+	size_t next = 0;
+	for (size_t index = 0; index < entities._saved.size(); ++index) {
+		if (entities._saved[index] != entt::null) {
+			entities._loaded[index] = created[next++];
+		}
+	}
+}
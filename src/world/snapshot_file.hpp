@@ -0,0 +1,279 @@
+#pragma once
+
+#include <entt/entt.hpp>
+#include "../utils/mapped_file.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+// Memory-mappable world snapshot (".snap").
+// Layout: SnapshotHeader, one SnapshotPool entry per component type, then one block per pool:
+// the owning entities followed by the raw components, both in storage order and aligned to
+// BlockAlignment, then an optional extra block of opaque bytes (state kept outside the registry).
+// Loading maps the file and bulk-inserts every pool; there is no per-field parsing.
+// The schema hash covers the component list (type names, sizes, alignments and order), so a file
+// written with a different list or layout is rejected instead of misread. Native endianness only.
+
+struct SnapshotHeader {
+	char magic[8];       // "RTSSNAP" + '\0'
+	uint32_t version;
+	uint32_t poolCount;
+	uint64_t schemaHash;
+	uint64_t fileSize;
+	uint64_t extraOffset; // Extra block, 0 if there is none
+	uint64_t extraSize;
+};
+
+struct SnapshotPool {
+	uint64_t typeHash;
+	uint32_t elementSize;  // 0 for empty (tag) components
+	uint32_t count;
+	uint64_t entityOffset; // entt::entity[count]
+	uint64_t dataOffset;   // Component[count], 0 for tags
+};
+
+// Saved entity -> entity created by SnapshotFile::Load
+class SnapshotEntityMap {
+public:
+	// The loaded entity for a saved one, entt::null if it was not in the file
+	entt::entity Map(entt::entity saved) const {
+		auto index = static_cast<size_t>(entt::to_entity(saved));
+		return saved != entt::null && index < _saved.size() && _saved[index] == saved ? _loaded[index] : entt::null;
+	}
+
+	size_t GetSize() const { return _count; }
+
+private:
+	friend class SnapshotFile;
+
+	// Indexed by the saved entity's index part
+	std::vector<entt::entity> _saved;
+	std::vector<entt::entity> _loaded;
+	size_t _count = 0;
+};
+
+class SnapshotFile {
+public:
+	static constexpr uint32_t Version = 2;
+	static constexpr size_t BlockAlignment = 64;
+
+	// Hash of the component list as laid out by this build
+	template<typename... Components>
+	static uint64_t SchemaHash(entt::type_list<Components...>);
+
+	// Write every pool of the listed components, and extra (if given) as the extra block
+	template<typename... Components>
+	static bool Save(const entt::registry& registry, const std::string& path, entt::type_list<Components...> components,
+		const std::vector<std::byte>* extra = nullptr);
+
+	// Build the file image in memory (one sequential pass over each pool, no encoding); image is resized to fit
+	template<typename... Components>
+	static void Capture(const entt::registry& registry, entt::type_list<Components...> components, std::vector<std::byte>& image,
+		const std::vector<std::byte>* extra = nullptr);
+
+	// Write an image built by Capture
+	static bool WriteImage(const std::vector<std::byte>& image, const std::string& path);
+
+	// Map the file, create one entity per saved entity and bulk-insert every pool.
+	// The registry should be empty. Entities owning none of the listed components are not restored.
+	// extra (if given) receives the extra block, empty if the file has none.
+	template<typename... Components>
+	static bool Load(entt::registry& registry, const std::string& path, entt::type_list<Components...> components, SnapshotEntityMap& entities,
+		std::vector<std::byte>* extra = nullptr);
+
+	// Check the header, schema, pool table and extra block of an image without touching any registry.
+	// Read does the same checks; run this first to reject a file before clearing the state it would replace.
+	template<typename... Components>
+	static bool Validate(const std::byte* data, size_t size, entt::type_list<Components...> components, const std::string& source);
+
+	// Same as Load, from an image already in memory; source only names it in error messages
+	template<typename... Components>
+	static bool Read(entt::registry& registry, const std::byte* data, size_t size, entt::type_list<Components...> components,
+		SnapshotEntityMap& entities, const std::string& source, std::vector<std::byte>* extra = nullptr);
+
+private:
+	static uint64_t hashBytes(uint64_t hash, const void* data, size_t size);
+	static size_t alignUp(size_t offset) { return (offset + BlockAlignment - 1) & ~(BlockAlignment - 1); }
+
+	template<typename Component>
+	static uint64_t typeHash() {
+		std::string_view name = entt::type_name<Component>::value();
+		uint64_t layout[3] = {sizeof(Component), alignof(Component), std::is_empty_v<Component> ? 1u : 0u};
+		return hashBytes(hashBytes(FnvOffset, name.data(), name.size()), layout, sizeof(layout));
+	}
+
+	template<typename Component>
+	static constexpr uint32_t elementSize() { return std::is_empty_v<Component> ? 0 : static_cast<uint32_t>(sizeof(Component)); }
+
+	// Check the header and return the pool table, or nullptr (reason printed)
+	static const SnapshotPool* readPoolTable(const std::byte* data, size_t size, uint64_t schemaHash, size_t poolCount, const std::string& path);
+
+	// Check that a pool matches the compiled component and lies inside the image
+	static bool checkPool(size_t size, const SnapshotPool& pool, uint64_t typeHash, uint32_t elementSize, size_t alignment);
+
+	// Create one entity per distinct saved entity (in saved index order) and fill the map
+	static void createEntities(entt::registry& registry, const std::byte* data, const SnapshotPool* pools, size_t poolCount, SnapshotEntityMap& entities);
+
+	static const entt::entity* poolEntities(const std::byte* data, const SnapshotPool& pool) {
+		return reinterpret_cast<const entt::entity*>(data + pool.entityOffset);
+	}
+
+	static constexpr uint64_t FnvOffset = 14695981039346656037ull;
+	static constexpr char Magic[8] = {'R', 'T', 'S', 'S', 'N', 'A', 'P', '\0'};
+};
+
+// Template implementations
+
+template<typename... Components>
+uint64_t SnapshotFile::SchemaHash(entt::type_list<Components...>) {
+	uint64_t hash = hashBytes(FnvOffset, &Version, sizeof(Version));
+	([&hash] {
+		uint64_t type = typeHash<Components>();
+		hash = hashBytes(hash, &type, sizeof(type));
+	}(), ...);
+	return hash;
+}
+
+template<typename... Components>
+bool SnapshotFile::Save(const entt::registry& registry, const std::string& path, entt::type_list<Components...> components,
+	const std::vector<std::byte>* extra) {
+	std::vector<std::byte> image;
+	Capture(registry, components, image, extra);
+	return WriteImage(image, path);
+}
+
+template<typename... Components>
+void SnapshotFile::Capture(const entt::registry& registry, entt::type_list<Components...> components, std::vector<std::byte>& image,
+	const std::vector<std::byte>* extra) {
+	static_assert((std::is_trivially_copyable_v<Components> && ...), "Snapshot components are copied as raw bytes");
+	constexpr size_t poolCount = sizeof...(Components);
+
+	// Lay out the blocks
+	SnapshotPool pools[poolCount];
+	size_t offset = alignUp(sizeof(SnapshotHeader) + sizeof(pools));
+	size_t index = 0;
+	([&] {
+		const auto* storage = registry.storage<Components>();
+		SnapshotPool& pool = pools[index++];
+		pool.typeHash = typeHash<Components>();
+		pool.elementSize = elementSize<Components>();
+		pool.count = storage ? static_cast<uint32_t>(storage->size()) : 0u;
+		pool.entityOffset = offset;
+		offset = alignUp(offset + pool.count * sizeof(entt::entity));
+		pool.dataOffset = pool.elementSize > 0 ? offset : 0;
+		offset = alignUp(offset + static_cast<size_t>(pool.count) * pool.elementSize);
+	}(), ...);
+
+	SnapshotHeader header = {};
+	if (extra && !extra->empty()) {
+		header.extraOffset = offset;
+		header.extraSize = extra->size();
+		offset = alignUp(offset + extra->size());
+	}
+
+	// Padding stays zero
+	image.assign(offset, std::byte{0});
+	std::memcpy(header.magic, Magic, sizeof(Magic));
+	header.version = Version;
+	header.poolCount = static_cast<uint32_t>(poolCount);
+	header.schemaHash = SchemaHash(components);
+	header.fileSize = offset;
+	std::memcpy(image.data(), &header, sizeof(header));
+	std::memcpy(image.data() + sizeof(header), pools, sizeof(pools));
+	if (header.extraSize > 0) {
+		std::memcpy(image.data() + header.extraOffset, extra->data(), extra->size());
+	}
+
+	index = 0;
+	([&] {
+		const SnapshotPool& pool = pools[index++];
+		if (pool.count == 0) return;
+		const auto* storage = registry.storage<Components>();
+		const entt::entity* entities = storage->data();
+		std::memcpy(image.data() + pool.entityOffset, entities, pool.count * sizeof(entt::entity));
+		if constexpr (!std::is_empty_v<Components>) {
+			// Reverse iterators walk the packed components in data() order, page after page, with no sparse lookups
+			std::byte* out = image.data() + pool.dataOffset;
+			for (auto it = storage->rbegin(), last = storage->rend(); it != last; ++it, out += sizeof(Components)) {
+				std::memcpy(out, &*it, sizeof(Components));
+			}
+		}
+	}(), ...);
+}
+
+template<typename... Components>
+bool SnapshotFile::Load(entt::registry& registry, const std::string& path, entt::type_list<Components...> components, SnapshotEntityMap& entities,
+	std::vector<std::byte>* extra) {
+	MappedFile file;
+	if (!file.Open(path)) {
+		std::cerr << "Failed to map snapshot: " << path << std::endl;
+		return false;
+	}
+	return Read(registry, file.GetData(), file.GetSize(), components, entities, path, extra);
+}
+
+template<typename... Components>
+bool SnapshotFile::Validate(const std::byte* data, size_t size, entt::type_list<Components...> components, const std::string& source) {
+	const SnapshotPool* pools = readPoolTable(data, size, SchemaHash(components), sizeof...(Components), source);
+	if (!pools) {
+		return false;
+	}
+
+	size_t index = 0;
+	bool valid = (checkPool(size, pools[index++], typeHash<Components>(), elementSize<Components>(), alignof(Components)) && ...);
+	SnapshotHeader header;
+	std::memcpy(&header, data, sizeof(header));
+	valid = valid && header.extraOffset <= size && header.extraSize <= size - header.extraOffset;
+	if (!valid) {
+		std::cerr << "Snapshot pool table is corrupt: " << source << std::endl;
+		return false;
+	}
+	return true;
+}
+
+template<typename... Components>
+bool SnapshotFile::Read(entt::registry& registry, const std::byte* data, size_t size, entt::type_list<Components...> components,
+	SnapshotEntityMap& entities, const std::string& source, std::vector<std::byte>* extra) {
+	static_assert((std::is_trivially_copyable_v<Components> && ...), "Snapshot components are copied as raw bytes");
+	constexpr size_t poolCount = sizeof...(Components);
+
+	if (!Validate(data, size, components, source)) {
+		return false;
+	}
+	const auto* pools = reinterpret_cast<const SnapshotPool*>(data + sizeof(SnapshotHeader));
+	SnapshotHeader header;
+	std::memcpy(&header, data, sizeof(header));
+	if (extra) {
+		extra->assign(data + header.extraOffset, data + header.extraOffset + header.extraSize);
+	}
+
+	createEntities(registry, data, pools, poolCount, entities);
+
+	// Bulk-insert each pool in saved storage order, so views iterate exactly like the saved world
+	std::vector<entt::entity> mapped;
+	size_t index = 0;
+	([&] {
+		const SnapshotPool& pool = pools[index++];
+		const entt::entity* saved = poolEntities(data, pool);
+		mapped.resize(pool.count);
+		for (uint32_t i = 0; i < pool.count; ++i) {
+			mapped[i] = entities.Map(saved[i]);
+		}
+
+		if constexpr (std::is_empty_v<Components>) {
+			registry.insert<Components>(mapped.begin(), mapped.end());
+		} else {
+			// Aligned raw components straight from the mapping
+			const auto* values = reinterpret_cast<const Components*>(data + pool.dataOffset);
+			registry.insert<Components>(mapped.begin(), mapped.end(), values);
+		}
+	}(), ...);
+
+	return true;
+}
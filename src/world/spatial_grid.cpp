@@ -1,11 +1,14 @@
 #include "spatial_grid.hpp"
 #include "../components/components.hpp"
 #include <algorithm>
+#include <tuple>
 
 // FactionGrid Implementation
 void FactionGrid::Resize(int size) {
 	_cells.resize(size, entt::null);
+	_batch_head.assign(size, -1);
 	_entity_count = 0;
+	_packed_dirty = true;
 }
 
 void FactionGrid::Insert(int cell_index, entt::entity entity, entt::registry& registry) {
@@ -22,6 +25,37 @@ void FactionGrid::Insert(int cell_index, entt::entity entity, entt::registry& re
 	// We become the new head
 	_cells[cell_index] = entity;
 	_entity_count++;
+	_packed_dirty = true;
+}
+
+void FactionGrid::InsertBatch(const std::vector<int>& cell_indices, const std::vector<entt::entity>& entities,
+	std::vector<SpatialNode>& nodes, entt::registry& registry) {
+	for (size_t i = 0; i < entities.size(); ++i) {
+		int cell_index = cell_indices[i];
+		entt::entity entity = entities[i];
+		SpatialNode& node = nodes[i];
+
+		node.next = _cells[cell_index]; // Old head becomes next
+		node.prev = entt::null;         // We are the new head, no prev
+
+		// Point the old head back at us, either in the buffer or in the registry
+		if (_batch_head[cell_index] >= 0) {
+			nodes[_batch_head[cell_index]].prev = entity;
+		} else if (node.next != entt::null) {
+			registry.get<SpatialNode>(node.next).prev = entity;
+		}
+
+		_batch_head[cell_index] = static_cast<int>(i);
+		_cells[cell_index] = entity;
+	}
+
+	// Only the touched cells, so a small batch costs nothing per grid cell
+	for (int cell_index : cell_indices) {
+		_batch_head[cell_index] = -1;
+	}
+
+	_entity_count += static_cast<int>(entities.size());
+	_packed_dirty = true;
 }
 
 void FactionGrid::Remove(int cell_index, entt::entity entity, entt::registry& registry) {
@@ -43,27 +77,100 @@ void FactionGrid::Remove(int cell_index, entt::entity entity, entt::registry& re
 	}
 
 	_entity_count--;
+	_packed_dirty = true;
 }
 
 void FactionGrid::Query(int min_x, int min_y, int max_x, int max_y, int cols, entt::registry& registry, EntityCallback callback) {
-	for (int y = min_y; y <= max_y; ++y) {
-		for (int x = min_x; x <= max_x; ++x) {
-			int cell_index = x + y * cols;
-			entt::entity curr = _cells[cell_index];
-
-			// Traverse the linked list in this cell
-			while (curr != entt::null) {
-				const auto& node = registry.get<SpatialNode>(curr);
-				callback(curr);
-				curr = node.next;
+	ForEach(min_x, min_y, max_x, max_y, cols, registry, callback);
+}
+
+void FactionGrid::RebuildPacked(entt::registry& registry) {
+	if (!_packed_dirty) return;
+	RTS_PROFILE_SCOPE("SpatialGrid::RebuildPacked");
+
+	const size_t cell_count = _cells.size();
+	_packed.cellStart.resize(cell_count + 1);
+	_packed.entities.clear();
+	_packed.xs.clear();
+	_packed.ys.clear();
+	_packed.entities.reserve(_entity_count);
+	_packed.xs.reserve(_entity_count);
+	_packed.ys.reserve(_entity_count);
+
+	// Copy each cell list in list order so packed queries visit (and tie-break) exactly like the linked lists
+	for (size_t i = 0; i < cell_count; ++i) {
+		_packed.cellStart[i] = static_cast<uint32_t>(_packed.entities.size());
+		entt::entity curr = _cells[i];
+		while (curr != entt::null) {
+			if (const auto* pos = registry.try_get<Position>(curr)) {
+				_packed.entities.push_back(curr);
+				_packed.xs.push_back(pos->value.x);
+				_packed.ys.push_back(pos->value.y);
 			}
+			curr = registry.get<SpatialNode>(curr).next;
 		}
 	}
+	_packed.cellStart[cell_count] = static_cast<uint32_t>(_packed.entities.size());
+
+	_packed_dirty = false;
 }
 
 void FactionGrid::Clear() {
 	std::fill(_cells.begin(), _cells.end(), entt::null);
 	_entity_count = 0;
+	_packed_dirty = true;
+}
+
+// CellRangeIterator Implementation
+CellRangeIterator::CellRangeIterator(const SpatialGrid* grid, const CellRect& rect)
+	: _grid(grid), _rect(rect), _faction(0), _x(rect.minX), _y(rect.minY)
+{
+	if (rect.IsEmpty()) {
+		_faction = MAX_FACTIONS;
+		return;
+	}
+
+	// Start one cell "before" the first so seekNextCell can load the first head
+	_x = rect.minX - 1;
+	seekNextCell();
+}
+
+void CellRangeIterator::seekNextCell() {
+	_current = entt::null;
+
+	while (_faction < MAX_FACTIONS) {
+		const FactionGrid& grid = _grid->_grids[_faction];
+		if (!grid.IsEmpty()) {
+			// Advance row-major through the rect
+			while (true) {
+				if (++_x > _rect.maxX) {
+					_x = _rect.minX;
+					if (++_y > _rect.maxY) break;
+				}
+				_current = grid.GetCellHead(_x + _y * _grid->_cols);
+				if (_current != entt::null) return;
+			}
+		}
+
+		// Next faction grid restarts at the first cell
+		_faction++;
+		_x = _rect.minX - 1;
+		_y = _rect.minY;
+	}
+
+	_current = entt::null;
+}
+
+CellRangeIterator& CellRangeIterator::operator++() {
+	if (_current == entt::null) {
+		return *this;
+	}
+
+	_current = _grid->_registry.get<SpatialNode>(_current).next;
+	if (_current == entt::null) {
+		seekNextCell();
+	}
+	return *this;
 }
 
 // SpatialGrid Implementation
@@ -78,6 +185,22 @@ SpatialGrid::SpatialGrid(entt::registry& registry, int width, int height, int ce
 	}
 }
 
+void SpatialGrid::PrepareConcurrentQueries() {
+	RTS_PROFILE_SCOPE("SpatialGrid::PrepareConcurrentQueries");
+	if (_backend != GridBackend::Packed) return;
+
+	for (int i = 0; i < MAX_FACTIONS; i++) {
+		_grids[i].RebuildPacked(_registry);
+	}
+}
+
+GridBackend SpatialGrid::ParseBackend(const std::string& name) {
+	if (name == "packed") {
+		return GridBackend::Packed;
+	}
+	return GridBackend::LinkedList;
+}
+
 FactionGrid& SpatialGrid::getGrid(int faction) {
 	return _grids[faction];
 }
@@ -113,6 +236,26 @@ void SpatialGrid::Insert(entt::entity entity, const Vec2& pos, int faction) {
 	grid.Insert(cell_index, entity, _registry);
 }
 
+void SpatialGrid::InsertBatch(const std::vector<entt::entity>& entities, const std::vector<Vec2>& positions, int faction) {
+	if (entities.empty() || faction < 0 || faction >= MAX_FACTIONS) {
+		return;
+	}
+
+	std::vector<int> cell_indices(entities.size());
+	std::vector<SpatialNode> nodes(entities.size());
+	for (size_t i = 0; i < entities.size(); ++i) {
+		cell_indices[i] = getCellIndex(positions[i]);
+		nodes[i].cell_index = cell_indices[i];
+		nodes[i].faction = faction;
+	}
+
+	getGrid(faction).InsertBatch(cell_indices, entities, nodes, _registry);
+
+	auto& storage = _registry.storage<SpatialNode>();
+	storage.reserve(storage.size() + nodes.size());
+	_registry.insert<SpatialNode>(entities.begin(), entities.end(), nodes.begin());
+}
+
 void SpatialGrid::Remove(entt::entity entity) {
 	if (!_registry.all_of<SpatialNode>(entity)) return;
 
@@ -156,6 +299,9 @@ void SpatialGrid::Update(entt::entity entity, const Vec2& old_pos, const Vec2& n
 	if (old_idx != new_idx || old_faction != new_faction) {
 		Remove(entity);
 		Insert(entity, new_pos, new_faction);
+	} else if (old_faction >= 0 && old_faction < MAX_FACTIONS) {
+		// Same cell, but the packed positions are now stale
+		_grids[old_faction].MarkDirty();
 	}
 }
 
@@ -165,6 +311,30 @@ void SpatialGrid::Clear() {
 	}
 }
 
+GridOccupancy SpatialGrid::GetOccupancy(std::pmr::memory_resource* scratch) const {
+	RTS_PROFILE_SCOPE("SpatialGrid::GetOccupancy");
+	GridOccupancy occupancy;
+	occupancy.cells = _cols * _rows;
+
+	std::pmr::vector<int> counts(occupancy.cells, 0, scratch);
+	for (const FactionGrid& grid : _grids) {
+		if (grid.IsEmpty()) continue;
+		for (int cell = 0; cell < occupancy.cells; ++cell) {
+			for (entt::entity curr = grid.GetCellHead(cell); curr != entt::null; curr = _registry.get<SpatialNode>(curr).next) {
+				counts[cell]++;
+			}
+		}
+	}
+
+	for (int count : counts) {
+		if (count == 0) continue;
+		occupancy.entities += count;
+		occupancy.occupiedCells++;
+		occupancy.maxPerCell = std::max(occupancy.maxPerCell, count);
+	}
+	return occupancy;
+}
+
 void SpatialGrid::getCellCoords(const Vec2& pos, int& x, int& y) const {
 	x = static_cast<int>(pos.x / _cell_size);
 	y = static_cast<int>(pos.y / _cell_size);
@@ -173,108 +343,220 @@ void SpatialGrid::getCellCoords(const Vec2& pos, int& x, int& y) const {
 	y = std::max(0, std::min(y, _rows - 1));
 }
 
-template<typename Func>
-void SpatialGrid::forEachRelevantGrid(int faction, bool same_faction, Func&& func) {
-	if (faction >= 0 && faction < MAX_FACTIONS) {
-		if (same_faction) {
-			// Query only the same faction
-			if (!_grids[faction].IsEmpty()) {
-				func(_grids[faction]);
-			}
-		} else {
-			// Query all factions except the specified one
-			for (int i = 0; i < MAX_FACTIONS; i++) {
-				if (i == faction) continue; // Skip same faction
-				if (_grids[i].IsEmpty()) continue; // Skip empty grids
-				func(_grids[i]);
-			}
-		}
-	} else {
-		// Query all factions
-		for (int i = 0; i < MAX_FACTIONS; i++) {
-			if (_grids[i].IsEmpty()) continue; // Skip empty grids
-			func(_grids[i]);
-		}
-	}
+void SpatialGrid::QueryRect(const Vec2& min, const Vec2& max, EntityCallback callback) {
+	VisitRect(min, max, callback);
 }
 
-void SpatialGrid::QueryRect(const Vec2& min, const Vec2& max, EntityCallback callback) {
-	// Calculate integer cell bounds once
-	int start_x, start_y, end_x, end_y;
-	getCellCoords(min, start_x, start_y);
-	getCellCoords(max, end_x, end_y);
+CellRect SpatialGrid::GetCellRect(const Vec2& min, const Vec2& max) const {
+	CellRect rect;
+	getCellCoords(min, rect.minX, rect.minY);
+	getCellCoords(max, rect.maxX, rect.maxY);
+	return rect;
+}
 
-	// Query all non-empty faction grids
-	for (int i = 0; i < MAX_FACTIONS; i++) {
-		if (_grids[i].IsEmpty()) continue; // Skip empty grids
-		
-		_grids[i].Query(start_x, start_y, end_x, end_y, _cols, _registry, [&](entt::entity e) {
-			// Additional position check
-			if (_registry.all_of<Position>(e)) {
-				const auto& pos = _registry.get<Position>(e);
-				if (pos.value.x >= min.x && pos.value.x <= max.x &&
-				    pos.value.y >= min.y && pos.value.y <= max.y) {
-					callback(e);
-				}
-			}
-		});
-	}
+CellRange SpatialGrid::QueryCells(const Vec2& min, const Vec2& max) const {
+	return CellRange(CellRangeIterator(this, GetCellRect(min, max)), CellRangeIterator());
 }
 
 entt::entity SpatialGrid::FindNearest(const Vec2& pos, float radius, int faction, bool same_faction) {
+	RTS_PROFILE_SCOPE("SpatialGrid::FindNearest");
 	entt::entity best_entity = entt::null;
 	float best_dist_sq = radius * radius;
-	float radius_sq = radius * radius;
 
-	Vec2 min = {pos.x - radius, pos.y - radius};
-	Vec2 max = {pos.x + radius, pos.y + radius};
+	if (_backend == GridBackend::Packed) {
+		Vec2 min = {pos.x - radius, pos.y - radius};
+		Vec2 max = {pos.x + radius, pos.y + radius};
+
+		// Calculate integer cell bounds once
+		int start_x, start_y, end_x, end_y;
+		getCellCoords(min, start_x, start_y);
+		getCellCoords(max, end_x, end_y);
+
+		// Spans are scanned in the same order as the lists, and the kernel keeps the first of equal candidates
+		forEachRelevantGrid(faction, same_faction, [&](FactionGrid& grid) {
+			grid.RebuildPacked(_registry);
+			grid.ForEachPackedRow(start_x, start_y, end_x, end_y, _cols,
+				[&](const entt::entity* entities, const float* xs, const float* ys, uint32_t count) {
+					int index = SimdDistance::FindNearest(xs, ys, count, pos.x, pos.y, best_dist_sq);
+					if (index >= 0) {
+						best_entity = entities[index];
+					}
+				});
+		});
+		return best_entity;
+	}
+
+	// The radius query already rejects anything outside the radius; strict < keeps the first of equal candidates
+	visitRadiusDistSq(pos, radius, [&](entt::entity e, float dist_sq) {
+		if (dist_sq < best_dist_sq) {
+			best_dist_sq = dist_sq;
+			best_entity = e;
+		}
+	}, faction, same_faction);
+
+	return best_entity;
+}
 
-	// Calculate integer cell bounds once
-	int start_x, start_y, end_x, end_y;
-	getCellCoords(min, start_x, start_y);
-	getCellCoords(max, end_x, end_y);
+void SpatialGrid::gatherCandidates(const CellRect& rect, int faction, bool same_faction, CandidateBuffer& out) {
+	out.entities.clear();
+	out.xs.clear();
+	out.ys.clear();
 
-	// Query relevant faction grids
 	forEachRelevantGrid(faction, same_faction, [&](FactionGrid& grid) {
-		grid.Query(start_x, start_y, end_x, end_y, _cols, _registry, [&](entt::entity e) {
-			if (!_registry.all_of<Position>(e)) return;
-			const auto& target_pos = _registry.get<Position>(e);
-			
-			float dist_sq = Vec2::distance_squared(pos, target_pos.value);
-			if (dist_sq <= radius_sq && dist_sq < best_dist_sq) {
-				best_dist_sq = dist_sq;
-				best_entity = e;
-			}
+		if (_backend == GridBackend::Packed) {
+			grid.RebuildPacked(_registry);
+			grid.ForEachPackedRow(rect.minX, rect.minY, rect.maxX, rect.maxY, _cols,
+				[&](const entt::entity* entities, const float* xs, const float* ys, uint32_t count) {
+					out.entities.insert(out.entities.end(), entities, entities + count);
+					out.xs.insert(out.xs.end(), xs, xs + count);
+					out.ys.insert(out.ys.end(), ys, ys + count);
+				});
+			return;
+		}
+
+		grid.ForEach(rect.minX, rect.minY, rect.maxX, rect.maxY, _cols, _registry, [&](entt::entity e) {
+			const auto* pos = _registry.try_get<Position>(e);
+			if (!pos) return;
+			out.entities.push_back(e);
+			out.xs.push_back(pos->value.x);
+			out.ys.push_back(pos->value.y);
 		});
 	});
+}
 
-	return best_entity;
+template<typename Func>
+void SpatialGrid::forEachQueryGroup(const std::vector<NearestQuery>& queries, std::pmr::memory_resource* scratch, Func&& func) {
+	struct KeyedQuery {
+		int cell;
+		int faction; // -1 for "all factions", whatever was passed in
+		bool same_faction;
+		CellRect rect;
+		size_t index;
+
+		auto scanKey() const { return std::tie(faction, same_faction, rect.minX, rect.minY, rect.maxX, rect.maxY); }
+	};
+
+	std::pmr::vector<KeyedQuery> order(scratch);
+	order.reserve(queries.size());
+	for (size_t i = 0; i < queries.size(); ++i) {
+		const NearestQuery& query = queries[i];
+		bool filtered = query.faction >= 0 && query.faction < MAX_FACTIONS;
+		Vec2 min = {query.pos.x - query.radius, query.pos.y - query.radius};
+		Vec2 max = {query.pos.x + query.radius, query.pos.y + query.radius};
+		order.push_back({getCellIndex(query.pos), filtered ? query.faction : -1, filtered && query.same_faction,
+		                 GetCellRect(min, max), i});
+	}
+
+	// Neighbouring shooters end up next to each other; identical scans become adjacent runs
+	std::sort(order.begin(), order.end(), [](const KeyedQuery& a, const KeyedQuery& b) {
+		if (a.cell != b.cell) return a.cell < b.cell;
+		if (a.scanKey() != b.scanKey()) return a.scanKey() < b.scanKey();
+		return a.index < b.index;
+	});
+
+	CandidateBuffer candidates(scratch);
+	size_t start = 0;
+	while (start < order.size()) {
+		size_t end = start + 1;
+		while (end < order.size() && order[end].cell == order[start].cell && order[end].scanKey() == order[start].scanKey()) {
+			end++;
+		}
+
+		gatherCandidates(order[start].rect, order[start].faction, order[start].same_faction, candidates);
+		for (size_t i = start; i < end; ++i) {
+			func(order[i].index, candidates);
+		}
+		start = end;
+	}
 }
 
-void SpatialGrid::QueryRadius(const Vec2& pos, float radius, EntityCallback callback, int faction, bool same_faction) {
+// Insert candidates closer than radius_sq into a sorted top-k list; equal distances keep arrival order
+static int selectKNearest(const entt::entity* entities, const float* xs, const float* ys, uint32_t count,
+                          const Vec2& pos, float radius_sq, int k,
+                          entt::entity* best, float* best_dist_sq) {
+	int found = 0;
+	uint32_t indices[SimdDistance::ChunkSize];
+	float dists[SimdDistance::ChunkSize];
+
+	for (uint32_t offset = 0; offset < count; offset += SimdDistance::ChunkSize) {
+		uint32_t chunk = std::min(SimdDistance::ChunkSize, count - offset);
+		uint32_t hits = SimdDistance::FilterInRadius(xs + offset, ys + offset, chunk, pos.x, pos.y, radius_sq, indices, dists);
+
+		for (uint32_t h = 0; h < hits; ++h) {
+			float dist_sq = dists[h];
+			// Strictly inside, like FindNearest
+			if (dist_sq >= radius_sq) continue;
+			if (found == k && !(dist_sq < best_dist_sq[k - 1])) continue;
+
+			int slot = found < k ? found++ : k - 1;
+			while (slot > 0 && dist_sq < best_dist_sq[slot - 1]) {
+				best[slot] = best[slot - 1];
+				best_dist_sq[slot] = best_dist_sq[slot - 1];
+				slot--;
+			}
+			best[slot] = entities[offset + indices[h]];
+			best_dist_sq[slot] = dist_sq;
+		}
+	}
+	return found;
+}
+
+int SpatialGrid::FindKNearest(const Vec2& pos, float radius, int k, std::vector<entt::entity>& results, int faction, bool same_faction,
+                              std::pmr::memory_resource* scratch) {
+	RTS_PROFILE_SCOPE("SpatialGrid::FindKNearest");
+	results.clear();
+	if (k <= 0) return 0;
+
+	// The scan of a one-query FindKNearestBatch, without the query list and padded results
+	bool filtered = faction >= 0 && faction < MAX_FACTIONS;
 	Vec2 min = {pos.x - radius, pos.y - radius};
 	Vec2 max = {pos.x + radius, pos.y + radius};
-	float radius_sq = radius * radius;
-
-	// Calculate integer cell bounds once
-	int start_x, start_y, end_x, end_y;
-	getCellCoords(min, start_x, start_y);
-	getCellCoords(max, end_x, end_y);
+	CandidateBuffer candidates(scratch);
+	gatherCandidates(GetCellRect(min, max), filtered ? faction : -1, filtered && same_faction, candidates);
+
+	std::pmr::vector<float> best_dist_sq(k, scratch);
+	results.resize(k);
+	int found = selectKNearest(candidates.entities.data(), candidates.xs.data(), candidates.ys.data(),
+		static_cast<uint32_t>(candidates.entities.size()), pos, radius * radius, k, results.data(), best_dist_sq.data());
+	results.resize(found);
+	return found;
+}
 
-	// Query relevant faction grids
-	forEachRelevantGrid(faction, same_faction, [&](FactionGrid& grid) {
-		grid.Query(start_x, start_y, end_x, end_y, _cols, _registry, [&](entt::entity e) {
-			if (!_registry.all_of<Position>(e)) return;
-			const auto& entity_pos = _registry.get<Position>(e);
+void SpatialGrid::FindNearestBatch(const std::vector<NearestQuery>& queries, std::vector<entt::entity>& results,
+                                   std::pmr::memory_resource* scratch) {
+	RTS_PROFILE_SCOPE("SpatialGrid::FindNearestBatch");
+	results.assign(queries.size(), entt::null);
+
+	forEachQueryGroup(queries, scratch, [&](size_t index, const CandidateBuffer& candidates) {
+		const NearestQuery& query = queries[index];
+		float best_dist_sq = query.radius * query.radius;
+		int best = SimdDistance::FindNearest(candidates.xs.data(), candidates.ys.data(),
+			static_cast<uint32_t>(candidates.entities.size()), query.pos.x, query.pos.y, best_dist_sq);
+		if (best >= 0) {
+			results[index] = candidates.entities[best];
+		}
+	});
+}
 
-			float dist_sq = Vec2::distance_squared(pos, entity_pos.value);
-			if (dist_sq <= radius_sq) {
-				callback(e);
-			}
-		});
+void SpatialGrid::FindKNearestBatch(const std::vector<NearestQuery>& queries, int k, std::vector<entt::entity>& results,
+                                    std::pmr::memory_resource* scratch) {
+	RTS_PROFILE_SCOPE("SpatialGrid::FindKNearestBatch");
+	results.assign(queries.size() * static_cast<size_t>(std::max(k, 0)), entt::null);
+	if (k <= 0) return;
+
+	std::pmr::vector<float> best_dist_sq(k, scratch);
+	forEachQueryGroup(queries, scratch, [&](size_t index, const CandidateBuffer& candidates) {
+		const NearestQuery& query = queries[index];
+		selectKNearest(candidates.entities.data(), candidates.xs.data(), candidates.ys.data(),
+			static_cast<uint32_t>(candidates.entities.size()), query.pos, query.radius * query.radius, k,
+			results.data() + index * k, best_dist_sq.data());
 	});
 }
 
+void SpatialGrid::QueryRadius(const Vec2& pos, float radius, EntityCallback callback, int faction, bool same_faction) {
+	VisitRadius(pos, radius, callback, faction, same_faction);
+}
+
 int SpatialGrid::getCellIndex(const Vec2& pos) const {
 	int x = static_cast<int>(pos.x / _cell_size);
 	int y = static_cast<int>(pos.y / _cell_size);
@@ -4,13 +4,112 @@
 #include "../utils/vec2.hpp"
 #include <vector>
 #include <array>
+#include <algorithm>
+#include <cstdint>
 #include <functional>
+#include <iterator>
+#include <memory_resource>
+#include <string>
 #include "../components/components.hpp"
+#include "simd_distance.hpp"
+#include "../utils/profiler.hpp"
 
 // Function types for callbacks
 using EntityCallback = std::function<void(entt::entity)>;
 using EntityFilter = std::function<bool(entt::entity)>;
 
+// Inclusive integer cell bounds - float to cell conversion is done once per query
+struct CellRect {
+	int minX, minY, maxX, maxY;
+
+	bool IsEmpty() const { return minX > maxX || minY > maxY; }
+};
+
+class SpatialGrid;
+
+// Forward iterator over every entity stored in a rect of cells, across all faction grids.
+// Walks the intrusive per-cell lists directly: no callbacks and no allocations.
+// Results are cell-granular, callers do their own exact position test if needed.
+class CellRangeIterator {
+public:
+	using iterator_category = std::forward_iterator_tag;
+	using value_type = entt::entity;
+	using difference_type = std::ptrdiff_t;
+	using pointer = const entt::entity*;
+	using reference = entt::entity;
+
+	CellRangeIterator() = default;
+
+	entt::entity operator*() const { return _current; }
+	CellRangeIterator& operator++();
+	CellRangeIterator operator++(int) { CellRangeIterator tmp = *this; ++(*this); return tmp; }
+
+	bool operator==(const CellRangeIterator& other) const { return _current == other._current && _faction == other._faction; }
+	bool operator!=(const CellRangeIterator& other) const { return !(*this == other); }
+
+private:
+	friend class SpatialGrid;
+
+	CellRangeIterator(const SpatialGrid* grid, const CellRect& rect);
+
+	// Move to the head of the next non-empty cell, or to end
+	void seekNextCell();
+
+	const SpatialGrid* _grid = nullptr;
+	CellRect _rect = {0, 0, -1, -1};
+	int _faction = MAX_FACTIONS; // MAX_FACTIONS marks the end iterator
+	int _x = 0;
+	int _y = 0;
+	entt::entity _current = entt::null;
+};
+
+// Range over the entities in a rect of cells, usable in range-for loops
+class CellRange {
+public:
+	CellRange(CellRangeIterator first, CellRangeIterator last) : _begin(first), _end(last) {}
+
+	CellRangeIterator begin() const { return _begin; }
+	CellRangeIterator end() const { return _end; }
+
+private:
+	CellRangeIterator _begin;
+	CellRangeIterator _end;
+};
+
+// One request of a batched nearest query - same arguments as FindNearest
+struct NearestQuery {
+	Vec2 pos;
+	float radius = 0.0f;
+	int faction = -1;
+	bool same_faction = false;
+};
+
+// How entities are spread over the cells, all factions combined
+struct GridOccupancy {
+	int entities = 0;
+	int cells = 0;          // Cells in the grid
+	int occupiedCells = 0;  // Cells holding at least one entity
+	int maxPerCell = 0;
+
+	float GetMeanPerOccupiedCell() const { return occupiedCells > 0 ? static_cast<float>(entities) / occupiedCells : 0.0f; }
+};
+
+// Storage used to answer VisitRect/VisitRadius/FindNearest
+enum class GridBackend {
+	LinkedList, // Walk the intrusive SpatialNode lists, reading Position from the registry
+	Packed      // Scan contiguous per-cell (entity, x, y) arrays rebuilt from the lists when dirty
+};
+
+// Packed mirror of a faction grid's cell lists (CSR layout).
+// Cell i owns [cellStart[i], cellStart[i + 1]) in the entity/xs/ys arrays, cells stored row-major,
+// so a row of cells in a query rect is one contiguous span.
+struct PackedCells {
+	std::vector<uint32_t> cellStart;
+	std::vector<entt::entity> entities;
+	std::vector<float> xs;
+	std::vector<float> ys;
+};
+
 // Internal per-faction grid - stores cells for a single faction
 class FactionGrid {
 public:
@@ -22,9 +121,62 @@ public:
 	// Insert entity into a specific cell
 	void Insert(int cell_index, entt::entity entity, entt::registry& registry);
 
+	// Link new entities into their cells as if Insert was called for each in order.
+	// nodes[i] receives the links of entities[i]; the caller adds them to the registry afterwards.
+	void InsertBatch(const std::vector<int>& cell_indices, const std::vector<entt::entity>& entities,
+		std::vector<SpatialNode>& nodes, entt::registry& registry);
+
 	// Remove entity from a specific cell
 	void Remove(int cell_index, entt::entity entity, entt::registry& registry);
 
+	// Visit entities in a cell rect (integer coords). The visitor is inlined at the call site.
+	// The next link is read before visiting, so the visitor may remove the current entity.
+	template<typename Visitor>
+	void ForEach(int min_x, int min_y, int max_x, int max_y, int cols, entt::registry& registry, Visitor&& visitor) const {
+		for (int y = min_y; y <= max_y; ++y) {
+			for (int x = min_x; x <= max_x; ++x) {
+				entt::entity curr = _cells[x + y * cols];
+
+				// Traverse the linked list in this cell
+				while (curr != entt::null) {
+					entt::entity next = registry.get<SpatialNode>(curr).next;
+					visitor(curr);
+					curr = next;
+				}
+			}
+		}
+	}
+
+	// Visit each row of a cell rect as one contiguous packed span: visitor(entities, xs, ys, count).
+	// Call RebuildPacked first. Positions are a snapshot from the last rebuild.
+	template<typename Visitor>
+	void ForEachPackedRow(int min_x, int min_y, int max_x, int max_y, int cols, Visitor&& visitor) const {
+		if (min_x > max_x) return;
+		for (int y = min_y; y <= max_y; ++y) {
+			uint32_t begin = _packed.cellStart[min_x + y * cols];
+			uint32_t end = _packed.cellStart[max_x + y * cols + 1];
+			if (begin == end) continue;
+			visitor(_packed.entities.data() + begin, _packed.xs.data() + begin, _packed.ys.data() + begin, end - begin);
+		}
+	}
+
+	// Visit packed (entity, x, y) entries in a cell rect, in the same order as ForEach. Call RebuildPacked first.
+	template<typename Visitor>
+	void ForEachPacked(int min_x, int min_y, int max_x, int max_y, int cols, Visitor&& visitor) const {
+		ForEachPackedRow(min_x, min_y, max_x, max_y, cols,
+			[&](const entt::entity* entities, const float* xs, const float* ys, uint32_t count) {
+				for (uint32_t i = 0; i < count; ++i) {
+					visitor(entities[i], xs[i], ys[i]);
+				}
+			});
+	}
+
+	// Rebuild the packed arrays from the cell lists if anything changed since the last rebuild
+	void RebuildPacked(entt::registry& registry);
+
+	// Flag the packed arrays as stale (positions changed without a cell change)
+	void MarkDirty() { _packed_dirty = true; }
+
 	// Query entities in a cell rect (integer coords)
 	void Query(int min_x, int min_y, int max_x, int max_y, int cols, entt::registry& registry, EntityCallback callback);
 
@@ -37,10 +189,21 @@ public:
 	// Get entity count
 	int GetEntityCount() const { return _entity_count; }
 
+	// First entity of a cell's list (entt::null if empty)
+	entt::entity GetCellHead(int cell_index) const { return _cells[cell_index]; }
+
 private:
 	// The grid only stores the "Head" of the list for that cell
 	std::vector<entt::entity> _cells;
 	int _entity_count = 0;
+
+	// InsertBatch scratch, one per cell: batch index of the cell's head, -1 while the head is not from the
+	// current batch. Sized with the cells and put back to -1 for the touched cells after each batch.
+	std::vector<int> _batch_head;
+
+	// Packed backend data, only built when the packed backend is queried
+	PackedCells _packed;
+	bool _packed_dirty = true;
 };
 
 class SpatialGrid {
@@ -50,6 +213,10 @@ public:
 	// O(1) - No Allocations
 	void Insert(entt::entity entity, const Vec2& pos, int faction = -1);
 
+	// Insert entities that have no SpatialNode yet, all of one faction. Leaves the same cell lists as
+	// calling Insert for each entity in order, but the nodes are linked in a buffer and emplaced as one range.
+	void InsertBatch(const std::vector<entt::entity>& entities, const std::vector<Vec2>& positions, int faction);
+
 	// O(1) - No Allocations
 	void Remove(entt::entity entity);
 
@@ -59,20 +226,66 @@ public:
 	// Just clears vector of entities
 	void Clear();
 
+	// Select the storage used by queries. The linked lists are always maintained, so switching is free.
+	void SetBackend(GridBackend backend) { _backend = backend; }
+	GridBackend GetBackend() const { return _backend; }
+
+	// Bring lazily built data up to date so queries can then run concurrently from several threads.
+	// Queries are read-only afterwards until the next Insert/Remove/Update.
+	void PrepareConcurrentQueries();
+
+	// Parse a "global.grid_backend" config value ("linked_list" or "packed"), defaults to LinkedList
+	static GridBackend ParseBackend(const std::string& name);
+
+	// Visit all entities within a rectangle - templated, no std::function overhead
+	template<typename Visitor>
+	void VisitRect(const Vec2& min, const Vec2& max, Visitor&& visitor);
+
+	// Visit all entities within a radius (with optional faction filter) - templated, no std::function overhead
+	template<typename Visitor>
+	void VisitRadius(const Vec2& pos, float radius, Visitor&& visitor, int faction = -1, bool same_faction = false);
+
 	// Query all entities within a rectangle
 	void QueryRect(const Vec2& min, const Vec2& max, EntityCallback callback);
 
 	// Find nearest entity to a given position within a radius (with optional faction filter)
 	entt::entity FindNearest(const Vec2& pos, float radius, int faction = -1, bool same_faction = false);
 
+	// Up to k nearest entities strictly inside the radius, closest first (ties keep visit order like FindNearest).
+	// Replaces the contents of results and returns how many were found. Candidates are gathered into scratch.
+	int FindKNearest(const Vec2& pos, float radius, int k, std::vector<entt::entity>& results, int faction = -1, bool same_faction = false,
+		std::pmr::memory_resource* scratch = std::pmr::get_default_resource());
+
+	// Batched FindNearest: results[i] is FindNearest(queries[i]). Queries are processed sorted by cell,
+	// and queries with the same cell rect and faction filter share a single candidate scan.
+	// Sort keys and candidate buffers are allocated from scratch (pass a FrameArena to keep the heap out of it).
+	void FindNearestBatch(const std::vector<NearestQuery>& queries, std::vector<entt::entity>& results,
+		std::pmr::memory_resource* scratch = std::pmr::get_default_resource());
+
+	// Batched FindKNearest: results[i * k + j] is the j-th nearest for queries[i], padded with entt::null
+	void FindKNearestBatch(const std::vector<NearestQuery>& queries, int k, std::vector<entt::entity>& results,
+		std::pmr::memory_resource* scratch = std::pmr::get_default_resource());
+
 	// Find all entities within a radius (with optional faction filter)
 	void QueryRadius(const Vec2& pos, float radius, EntityCallback callback, int faction = -1, bool same_faction = false);
 
+	// Iterate entities of all factions in the cells overlapping a rectangle (cell-granular, no position test)
+	CellRange QueryCells(const Vec2& min, const Vec2& max) const;
+
+	// Convert a float rectangle to clamped cell bounds
+	CellRect GetCellRect(const Vec2& min, const Vec2& max) const;
+
+	// Walk every cell list and summarise occupancy (O(cells + entities), meant for debug displays).
+	// The per-cell counters are allocated from scratch.
+	GridOccupancy GetOccupancy(std::pmr::memory_resource* scratch = std::pmr::get_default_resource()) const;
+
 	// Get world dimensions
 	int GetWidth() const { return _width; }
 	int GetHeight() const { return _height; }
 
 private:
+	friend class CellRangeIterator;
+
 	// Get or create a faction grid
 	FactionGrid& getGrid(int faction);
 
@@ -86,6 +299,26 @@ private:
 	template<typename Func>
 	void forEachRelevantGrid(int faction, bool same_faction, Func&& func);
 
+	// Radius query core - visitor(entity, dist_sq), so callers never re-fetch Position
+	template<typename Visitor>
+	void visitRadiusDistSq(const Vec2& pos, float radius, Visitor&& visitor, int faction, bool same_faction);
+
+	// Candidates of one cell rect + faction filter, in the order FindNearest would visit them
+	struct CandidateBuffer {
+		explicit CandidateBuffer(std::pmr::memory_resource* memory) : entities(memory), xs(memory), ys(memory) {}
+
+		std::pmr::vector<entt::entity> entities;
+		std::pmr::vector<float> xs;
+		std::pmr::vector<float> ys;
+	};
+
+	// Copy every candidate of a cell rect into a packed buffer (from the packed arrays or the lists)
+	void gatherCandidates(const CellRect& rect, int faction, bool same_faction, CandidateBuffer& out);
+
+	// Sort queries by cell, gather candidates once per group of identical scans, call func(query_index, candidates)
+	template<typename Func>
+	void forEachQueryGroup(const std::vector<NearestQuery>& queries, std::pmr::memory_resource* scratch, Func&& func);
+
 	entt::registry& _registry;
 	int _width, _height;
 	int _cell_size;
@@ -93,4 +326,119 @@ private:
 
 	// Per-faction grids (fixed array for optimization)
 	std::array<FactionGrid, MAX_FACTIONS> _grids;
+
+	GridBackend _backend = GridBackend::LinkedList;
 };
+
+// Template implementations
+
+template<typename Func>
+void SpatialGrid::forEachRelevantGrid(int faction, bool same_faction, Func&& func) {
+	if (faction >= 0 && faction < MAX_FACTIONS) {
+		if (same_faction) {
+			// Query only the same faction
+			if (!_grids[faction].IsEmpty()) {
+				func(_grids[faction]);
+			}
+		} else {
+			// Query all factions except the specified one
+			for (int i = 0; i < MAX_FACTIONS; i++) {
+				if (i == faction) continue; // Skip same faction
+				if (_grids[i].IsEmpty()) continue; // Skip empty grids
+				func(_grids[i]);
+			}
+		}
+	} else {
+		// Query all factions
+		for (int i = 0; i < MAX_FACTIONS; i++) {
+			if (_grids[i].IsEmpty()) continue; // Skip empty grids
+			func(_grids[i]);
+		}
+	}
+}
+
+template<typename Visitor>
+void SpatialGrid::VisitRect(const Vec2& min, const Vec2& max, Visitor&& visitor) {
+	RTS_PROFILE_SCOPE("SpatialGrid::VisitRect");
+	// Calculate integer cell bounds once
+	int start_x, start_y, end_x, end_y;
+	getCellCoords(min, start_x, start_y);
+	getCellCoords(max, end_x, end_y);
+
+	// Query all non-empty faction grids
+	for (int i = 0; i < MAX_FACTIONS; i++) {
+		if (_grids[i].IsEmpty()) continue; // Skip empty grids
+
+		if (_backend == GridBackend::Packed) {
+			_grids[i].RebuildPacked(_registry);
+			_grids[i].ForEachPacked(start_x, start_y, end_x, end_y, _cols, [&](entt::entity e, float x, float y) {
+				if (x >= min.x && x <= max.x && y >= min.y && y <= max.y) {
+					visitor(e);
+				}
+			});
+			continue;
+		}
+
+		_grids[i].ForEach(start_x, start_y, end_x, end_y, _cols, _registry, [&](entt::entity e) {
+			// Additional position check
+			const auto* pos = _registry.try_get<Position>(e);
+			if (pos &&
+			    pos->value.x >= min.x && pos->value.x <= max.x &&
+			    pos->value.y >= min.y && pos->value.y <= max.y) {
+				visitor(e);
+			}
+		});
+	}
+}
+
+template<typename Visitor>
+void SpatialGrid::VisitRadius(const Vec2& pos, float radius, Visitor&& visitor, int faction, bool same_faction) {
+	RTS_PROFILE_SCOPE("SpatialGrid::VisitRadius");
+	visitRadiusDistSq(pos, radius, [&](entt::entity e, float) {
+		visitor(e);
+	}, faction, same_faction);
+}
+
+template<typename Visitor>
+void SpatialGrid::visitRadiusDistSq(const Vec2& pos, float radius, Visitor&& visitor, int faction, bool same_faction) {
+	Vec2 min = {pos.x - radius, pos.y - radius};
+	Vec2 max = {pos.x + radius, pos.y + radius};
+	float radius_sq = radius * radius;
+
+	// Calculate integer cell bounds once
+	int start_x, start_y, end_x, end_y;
+	getCellCoords(min, start_x, start_y);
+	getCellCoords(max, end_x, end_y);
+
+	// Query relevant faction grids
+	forEachRelevantGrid(faction, same_faction, [&](FactionGrid& grid) {
+		if (_backend == GridBackend::Packed) {
+			grid.RebuildPacked(_registry);
+			grid.ForEachPackedRow(start_x, start_y, end_x, end_y, _cols,
+				[&](const entt::entity* entities, const float* xs, const float* ys, uint32_t count) {
+					// Vectorized filter, then visit hits in span order
+					uint32_t indices[SimdDistance::ChunkSize];
+					float dists[SimdDistance::ChunkSize];
+					for (uint32_t offset = 0; offset < count; offset += SimdDistance::ChunkSize) {
+						uint32_t chunk = std::min(SimdDistance::ChunkSize, count - offset);
+						uint32_t hits = SimdDistance::FilterInRadius(xs + offset, ys + offset, chunk,
+							pos.x, pos.y, radius_sq, indices, dists);
+						for (uint32_t h = 0; h < hits; ++h) {
+							visitor(entities[offset + indices[h]], dists[h]);
+						}
+					}
+				});
+			return;
+		}
+
+		grid.ForEach(start_x, start_y, end_x, end_y, _cols, _registry, [&](entt::entity e) {
+			const auto* entity_pos = _registry.try_get<Position>(e);
+			if (!entity_pos) return;
+
+			float dist_sq = Vec2::distance_squared(pos, entity_pos->value);
+			if (dist_sq <= radius_sq) {
+				visitor(e, dist_sq);
+			}
+		});
+	});
+}
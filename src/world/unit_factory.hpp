@@ -2,11 +2,34 @@
 
 #include <entt/entt.hpp>
 #include <nlohmann/json.hpp>
+#include <array>
+#include <optional>
+#include <vector>
 #include "../components/components.hpp"
 
+// Component values for one unit type, read from the config once.
+// Spawning copies these instead of looking fields up in the JSON.
+struct UnitArchetype {
+	bool configured = false; // The config has an entry for this type; otherwise only Position/Unit/Faction are added
+	float speed = 10.0f;
+	Health health{100.0f, 100.0f, 0.0f};
+
+	// Type-specific components (timers start at 0)
+	std::optional<DirectDamage> directDamage;
+	std::optional<ProjectileEmitter> projectileEmitter;
+	std::optional<Healer> healer;
+	bool hasAttackTarget = false;
+};
+
 class UnitFactory {
 public:
-	UnitFactory(const nlohmann::json& config) : _config(config) {}
+	static constexpr int TypeCount = 4;
+
+	UnitFactory(const nlohmann::json& config) {
+		for (int type_idx = 0; type_idx < TypeCount; ++type_idx) {
+			_archetypes[type_idx] = compile(config, static_cast<UnitType>(type_idx));
+		}
+	}
 
 	// Spawn a unit of given type at position
 	entt::entity spawn_unit(entt::registry& registry, UnitType type, int faction, const Vec2& position) {
@@ -17,32 +40,130 @@ public:
 		registry.emplace<Unit>(entity, type, faction);
 		registry.emplace<Faction>(entity, faction);
 
-		// Get unit config data
 		int type_idx = static_cast<int>(type);
-		if (type_idx < 0 || type_idx >= _config["units"].size()) {
+		if (type_idx < 0 || type_idx >= TypeCount || !_archetypes[type_idx].configured) {
 			return entity; // Return basic entity if config missing
 		}
+		const UnitArchetype& archetype = _archetypes[type_idx];
+
+		// Same component order as always, so storage (and simulation) order does not change
+		registry.emplace<Movement>(entity, Vec2{0.0f, 0.0f}, position, archetype.speed);
+		registry.emplace<Health>(entity, archetype.health);
+		if (archetype.directDamage) {
+			registry.emplace<DirectDamage>(entity, *archetype.directDamage);
+		}
+		if (archetype.projectileEmitter) {
+			registry.emplace<ProjectileEmitter>(entity, *archetype.projectileEmitter);
+		}
+		if (archetype.healer) {
+			registry.emplace<Healer>(entity, *archetype.healer);
+		}
+		if (archetype.hasAttackTarget) {
+			registry.emplace<AttackTarget>(entity, entt::null);
+		}
+
+		return entity;
+	}
+
+	// Spawn one unit of given type per position. entities receives the new entities in position order.
+	// Equivalent to calling spawn_unit for each position in turn (same entities, same storage order),
+	// but entities are created with one call and each component pool is reserved and filled as a range.
+	void spawn_units(entt::registry& registry, UnitType type, int faction, const std::vector<Vec2>& positions, std::vector<entt::entity>& entities) {
+		entities.resize(positions.size());
+		if (positions.empty()) {
+			return;
+		}
+		registry.create(entities.begin(), entities.end());
+		auto first = entities.begin();
+		auto last = entities.end();
+
+		// Add common components
+		std::vector<Position> stamped;
+		stamped.reserve(positions.size());
+		for (const Vec2& position : positions) {
+			stamped.push_back(Position{position});
+		}
+		reserve<Position>(registry, positions.size());
+		registry.insert<Position>(first, last, stamped.begin());
+		reserve<Unit>(registry, positions.size());
+		registry.insert<Unit>(first, last, Unit{type, faction});
+		reserve<Faction>(registry, positions.size());
+		registry.insert<Faction>(first, last, Faction{faction});
+
+		int type_idx = static_cast<int>(type);
+		if (type_idx < 0 || type_idx >= TypeCount || !_archetypes[type_idx].configured) {
+			return; // Basic entities if config missing
+		}
+		const UnitArchetype& archetype = _archetypes[type_idx];
 
-		const auto& unit_config = _config["units"][type_idx];
-		
-		// Add Movement component with speed from config
-		float speed = unit_config.value("speed", 10.0f);
-		registry.emplace<Movement>(entity, Vec2{0.0f, 0.0f}, position, speed);
+		// Pools in the same order as spawn_unit
+		std::vector<Movement> movements;
+		movements.reserve(positions.size());
+		for (const Vec2& position : positions) {
+			movements.push_back(Movement{Vec2{0.0f, 0.0f}, position, archetype.speed});
+		}
+		reserve<Movement>(registry, positions.size());
+		registry.insert<Movement>(first, last, movements.begin());
+		reserve<Health>(registry, positions.size());
+		registry.insert<Health>(first, last, archetype.health);
+		if (archetype.directDamage) {
+			reserve<DirectDamage>(registry, positions.size());
+			registry.insert<DirectDamage>(first, last, *archetype.directDamage);
+		}
+		if (archetype.projectileEmitter) {
+			reserve<ProjectileEmitter>(registry, positions.size());
+			registry.insert<ProjectileEmitter>(first, last, *archetype.projectileEmitter);
+		}
+		if (archetype.healer) {
+			reserve<Healer>(registry, positions.size());
+			registry.insert<Healer>(first, last, *archetype.healer);
+		}
+		if (archetype.hasAttackTarget) {
+			reserve<AttackTarget>(registry, positions.size());
+			registry.insert<AttackTarget>(first, last, AttackTarget{entt::null});
+		}
+	}
 
-		// Add Health component (all units have health)
+	// Prebuilt values for a type (unconfigured archetype for unknown types)
+	const UnitArchetype& GetArchetype(UnitType type) const {
+		static const UnitArchetype missing;
+		int type_idx = static_cast<int>(type);
+		return type_idx >= 0 && type_idx < TypeCount ? _archetypes[type_idx] : missing;
+	}
+
+private:
+	// Grow a pool once for a whole batch instead of letting the range insert reallocate
+	template<typename Component>
+	static void reserve(entt::registry& registry, size_t count) {
+		auto& storage = registry.storage<Component>();
+		storage.reserve(storage.size() + count);
+	}
+
+	// Read one "units" entry with the same defaults spawning has always used
+	static UnitArchetype compile(const nlohmann::json& config, UnitType type) {
+		UnitArchetype archetype;
+		int type_idx = static_cast<int>(type);
+		if (!config.contains("units") || type_idx >= static_cast<int>(config["units"].size())) {
+			return archetype;
+		}
+
+		const auto& unit_config = config["units"][type_idx];
+		archetype.configured = true;
+		archetype.speed = unit_config.value("speed", 10.0f);
+
+		// All units have health
 		float max_hp = unit_config.value("hp", 100.0f);
 		float shield = unit_config.value("shield", 0.0f);
-		registry.emplace<Health>(entity, max_hp, max_hp, shield);
+		archetype.health = Health{max_hp, max_hp, shield};
 
-		// Add type-specific components
 		switch (type) {
 			case UnitType::Footman: {
 				// Melee unit - DirectDamage
 				float damage = unit_config.value("damage", 10.0f);
 				float range = unit_config.value("range", 1.5f);
 				float cooldown = unit_config.value("attack_cooldown", 1.0f);
-				registry.emplace<DirectDamage>(entity, damage, range, cooldown, 0.0f);
-				registry.emplace<AttackTarget>(entity, entt::null);
+				archetype.directDamage = DirectDamage{damage, range, cooldown, 0.0f};
+				archetype.hasAttackTarget = true;
 				break;
 			}
 			case UnitType::Archer: {
@@ -51,8 +172,8 @@ public:
 				float range = unit_config.value("range", 10.0f);
 				float cooldown = unit_config.value("attack_cooldown", 2.0f);
 				float projectile_speed = unit_config.value("projectile_speed", 15.0f);
-				registry.emplace<ProjectileEmitter>(entity, damage, range, cooldown, 0.0f, projectile_speed, 0, 0.0f);
-				registry.emplace<AttackTarget>(entity, entt::null);
+				archetype.projectileEmitter = ProjectileEmitter{damage, range, cooldown, 0.0f, projectile_speed, 0, 0.0f};
+				archetype.hasAttackTarget = true;
 				break;
 			}
 			case UnitType::Ballista: {
@@ -62,8 +183,8 @@ public:
 				float cooldown = unit_config.value("attack_cooldown", 5.0f);
 				float aoe_radius = unit_config.value("damage_radius", 3.0f);
 				float projectile_speed = unit_config.value("projectile_speed", 15.0f);
-				registry.emplace<ProjectileEmitter>(entity, damage, range, cooldown, 0.0f, projectile_speed, 1, aoe_radius);
-				registry.emplace<AttackTarget>(entity, entt::null);
+				archetype.projectileEmitter = ProjectileEmitter{damage, range, cooldown, 0.0f, projectile_speed, 1, aoe_radius};
+				archetype.hasAttackTarget = true;
 				break;
 			}
 			case UnitType::Healer: {
@@ -71,15 +192,12 @@ public:
 				float heal_amount = unit_config.value("heal_amount", 10.0f);
 				float heal_range = unit_config.value("heal_range", 5.0f);
 				float cooldown = unit_config.value("heal_cooldown", 2.0f);
-				registry.emplace<Healer>(entity, heal_amount, heal_range, cooldown, 0.0f);
+				archetype.healer = Healer{heal_amount, heal_range, cooldown, 0.0f};
 				break;
 			}
 		}
-
-		return entity;
+		return archetype;
 	}
 
-private:
-	const nlohmann::json& _config;
+	std::array<UnitArchetype, TypeCount> _archetypes;
 };
-
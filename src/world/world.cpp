@@ -1,7 +1,15 @@
 #include "world.hpp"
 #include "../utils/resource_loader.hpp"
+#include "../utils/profiler.hpp"
+#include "snapshot_file.hpp"
+#include "snapshot_codec.hpp"
+#include <cereal/archives/binary.hpp>
 #include <cereal/archives/json.hpp>
 #include <cereal/types/map.hpp>
+#include <cereal/types/vector.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
 #include <fstream>
 #include <filesystem>
 #include <iostream>
@@ -16,6 +24,10 @@ World::World()
 {
 }
 
+World::~World() {
+	WaitForSave();
+}
+
 bool World::Initialize(const nlohmann::json& config, bool enableRender) {
 	// Get terrain texture dimensions to calculate world bounds
 	int terrain_width = 0, terrain_height = 0;
@@ -35,7 +47,13 @@ bool World::Initialize(const nlohmann::json& config, bool enableRender) {
 
 	// Create systems
 	_spatialGrid = new SpatialGrid(_registry, world_width, world_height, cell_size);
+	_spatialGrid->SetBackend(SpatialGrid::ParseBackend(config["global"].value("grid_backend", "linked_list")));
 	_gameplaySystem = new GameplaySystem(*_spatialGrid);
+
+	// Worker threads for gameplay (0 = one per core). Results are identical for any count.
+	_jobSystem = std::make_unique<JobSystem>(config["global"].value("worker_threads", 1));
+	_gameplaySystem->SetJobSystem(_jobSystem.get());
+	_gameplaySystem->EnableProjectilePool(config["global"].value("projectile_pool", false));
 	_unitFactory = new UnitFactory(config);
 
 	// Initialize render system
@@ -43,6 +61,16 @@ bool World::Initialize(const nlohmann::json& config, bool enableRender) {
 		_renderSystem = new RenderSystem();
 		_renderSystem->init(config);
 		_renderSystem->SetWorldBounds(world_width, world_height);
+		_renderSystem->SetSpatialGrid(_spatialGrid);
+		_renderSystem->SetProjectilePool(&_gameplaySystem->GetProjectilePool());
+		_interpolate = config["global"].value("render_interpolation", true);
+
+		// Nothing moves faster than the fastest unit or projectile, used to cull interpolated sprites
+		if (config.contains("units")) {
+			for (const auto& unit : config["units"]) {
+				_maxSpeed = std::max({_maxSpeed, unit.value("speed", 0.0f), unit.value("projectile_speed", 0.0f)});
+			}
+		}
 	}
 
 	// Create camera entity
@@ -50,15 +78,106 @@ bool World::Initialize(const nlohmann::json& config, bool enableRender) {
 	_registry.emplace<Camera>(_cameraEntity, Vec2{0.0f, 0.0f}, 1.0f);
 	_registry.emplace<MainCamera>(_cameraEntity);
 
+	// Autosave: a keyframe, then deltas every interval until the next keyframe
+	_autosavePath = config["global"].value("autosave_path", "data/saves/autosave.snap");
+	_autosaveInterval = config["global"].value("autosave_interval", 0.0f);
+	_autosaveKeyframeEvery = std::max(1, config["global"].value("autosave_keyframe_every", 30));
+
 	return true;
 }
 
 void World::Update(float dt) {
+	_gameplaySystem->ResetTimings();
+	tick(dt);
+}
+
+void World::tick(float dt) {
+	RTS_PROFILE_SCOPE("World::Update");
+	_frameArena.Reset();
 	_gameplaySystem->update(_registry, dt);
+
+	if (_autosaveInterval > 0.0f) {
+		_autosaveTimer += dt;
+		if (_autosaveTimer >= _autosaveInterval) {
+			_autosaveTimer = 0.0f;
+			autosave();
+		}
+	}
+}
+
+void World::Step(int ticks, float step) {
+	_gameplaySystem->ResetTimings();
+	_tickStep = step;
+	if (ticks == 0) {
+		_frameArena.Reset();
+	}
+	for (int i = 0; i < ticks; ++i) {
+		if (_interpolate && i == ticks - 1) {
+			storePreviousPositions();
+		}
+		tick(step);
+	}
+}
+
+BattleResult World::RunUntilResolved(float dt, int maxTicks) {
+	RTS_PROFILE_SCOPE("World::RunUntilResolved");
+	BattleResult result;
+	auto start = std::chrono::steady_clock::now();
+	while (result.ticks < maxTicks && !isResolved()) {
+		Update(dt);
+		result.ticks++;
+	}
+	result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	int factionsLeft = 0;
+	auto unitView = _registry.view<Unit, Health>();
+	for (auto entity : unitView) {
+		int faction = unitView.get<Unit>(entity).faction;
+		if (faction >= 0 && faction < 8 && result.aliveCount[faction]++ == 0) {
+			factionsLeft++;
+			result.winner = faction;
+		}
+	}
+	result.resolved = factionsLeft <= 1;
+	if (factionsLeft != 1) {
+		result.winner = -1;
+	}
+	return result;
+}
+
+bool World::isResolved() const {
+	// Stops at the first unit of a second faction instead of counting every unit
+	int firstFaction = -1;
+	auto unitView = _registry.view<Unit, Health>();
+	for (auto entity : unitView) {
+		int faction = unitView.get<Unit>(entity).faction;
+		if (firstFaction == -1) {
+			firstFaction = faction;
+		} else if (faction != firstFaction) {
+			return false;
+		}
+	}
+	return true;
+}
+
+void World::storePreviousPositions() {
+	RTS_PROFILE_SCOPE("World::storePreviousPositions");
+	auto& previous = _registry.storage<PreviousPosition>();
+	auto positionView = _registry.view<Position>();
+	for (auto [entity, pos] : positionView.each()) {
+		if (previous.contains(entity)) {
+			previous.get(entity).value = pos.value;
+		} else {
+			previous.emplace(entity, PreviousPosition{pos.value});
+		}
+	}
+	_gameplaySystem->GetProjectilePool().StorePreviousPositions();
 }
 
 void World::Render() {
 	if (_renderSystem) {
+		_renderSystem->SetInterpolationAlpha(_interpolate ? _interpolationAlpha : 1.0f);
+		_renderSystem->SetMaxTickMovement(_maxSpeed * _tickStep);
 		_renderSystem->update(_registry);
 	}
 }
@@ -84,6 +203,28 @@ entt::entity World::SpawnUnit(UnitType type, int faction, const Vec2& position)
 	return entity;
 }
 
+std::vector<entt::entity> World::SpawnUnits(UnitType type, int faction, const std::vector<Vec2>& positions) {
+	RTS_PROFILE_SCOPE("World::SpawnUnits");
+
+	// Drop positions outside the world borders, like SpawnUnit
+	std::vector<Vec2> inside;
+	inside.reserve(positions.size());
+	for (const Vec2& position : positions) {
+		if (!_spatialGrid || (position.x >= 0 && position.x < _spatialGrid->GetWidth() &&
+			position.y >= 0 && position.y < _spatialGrid->GetHeight())) {
+			inside.push_back(position);
+		}
+	}
+
+	std::vector<entt::entity> entities;
+	_unitFactory->spawn_units(_registry, type, faction, inside, entities);
+
+	if (_spatialGrid) {
+		_spatialGrid->InsertBatch(entities, inside, faction);
+	}
+	return entities;
+}
+
 Camera* World::GetCamera() {
 	if (_cameraEntity == entt::null) {
 		return nullptr;
@@ -101,7 +242,6 @@ UnitCountData World::GetUnitCounts() const {
 		
 		// Skip projectiles (they have Unit component but shouldn't be counted)
 		if (_registry.all_of<Projectile>(entity)) {
-			counts.projectileCount++;
 			continue;
 		}
 		
@@ -120,6 +260,12 @@ UnitCountData World::GetUnitCounts() const {
 		}
 	}
 
+	// Projectile entities have no Faction, so count them from their own pool, plus the pooled ones
+	if (const auto* projectiles = _registry.storage<Projectile>()) {
+		counts.projectileCount += static_cast<int>(projectiles->size());
+	}
+	counts.projectileCount += static_cast<int>(_gameplaySystem->GetProjectilePool().GetCount());
+
 	return counts;
 }
 
@@ -131,7 +277,155 @@ const std::vector<Color>& World::GetFactionColors() const {
 	return empty_colors;
 }
 
+World::SaveFormat World::GetSaveFormat(const std::string& filepath) {
+	std::filesystem::path extension = std::filesystem::path(filepath).extension();
+	if (extension == ".bin") {
+		return SaveFormat::Binary;
+	}
+	if (extension == ".snap") {
+		return SaveFormat::Snapshot;
+	}
+	if (extension == ".snapz") {
+		return SaveFormat::CompressedSnapshot;
+	}
+	return SaveFormat::Json;
+}
+
+// Serialize each component pool in list order
+template<typename Archive, typename... Components>
+static void saveComponents(entt::snapshot& snapshot, Archive& archive, entt::type_list<Components...>) {
+	(snapshot.get<Components>(archive), ...);
+}
+
+template<typename Archive, typename... Components>
+static void loadComponents(entt::continuous_loader& loader, Archive& archive, entt::type_list<Components...>) {
+	(loader.get<Components>(archive), ...);
+}
+
+template<typename Archive>
+void World::saveSnapshot(const entt::registry& registry, Archive& archive) {
+	// Create snapshot and serialize all entities and components using EnTT's .get() API
+	entt::snapshot snapshot{ registry };
+	snapshot.get<entt::entity>(archive);
+	saveComponents(snapshot, archive, PersistedComponents{});
+}
+
+template<typename Archive>
+void World::loadSnapshot(Archive& archive) {
+	// Create continuous loader for entity remapping
+	entt::continuous_loader loader{_registry};
+
+	// Load entities and all components using EnTT's .get() API (same order as saveSnapshot)
+	loader.get<entt::entity>(archive);
+	loadComponents(loader, archive, PersistedComponents{});
+
+	// Post-process: Fix entity references in AttackTarget components
+	// The continuous_loader automatically handles entity remapping internally,
+	// but AttackTarget stores an entity that needs manual remapping
+	remapAttackTargets(_registry, [&loader](entt::entity saved) {
+		return loader.contains(saved) ? loader.map(saved) : entt::null;
+	});
+
+	// Clean up orphaned entities
+	loader.orphans();
+}
+
+template<typename Map>
+void World::remapAttackTargets(entt::registry& registry, Map&& map) {
+	auto attackTargetView = registry.view<AttackTarget>();
+	for (auto entity : attackTargetView) {
+		auto& at = attackTargetView.get<AttackTarget>(entity);
+		if (at.target != entt::null) {
+			at.target = map(at.target); // entt::null if the reference died or is invalid
+		}
+	}
+}
+
+void World::clearForLoad() {
+	// The recorder would log every removal, and its shadow no longer matches anything after a load
+	_deltaRecorder.reset();
+	_deltaChainPath.clear();
+
+	_registry.clear();
+	_spatialGrid->Clear();
+	_gameplaySystem->GetProjectilePool().Clear();
+	_cameraEntity = entt::null;
+}
+
+bool World::finishLoad(const std::vector<std::byte>& projectiles) {
+	// Find the camera entity (should have MainCamera tag)
+	auto cameraView = _registry.view<MainCamera>();
+	if (!cameraView.empty()) {
+		_cameraEntity = *cameraView.begin();
+	}
+
+	// Pooled projectiles come back from their section as they were saved. A save written in the other mode
+	// is converted: pooled projectiles become entities, or projectile entities are launched into the pool.
+	ProjectilePool& pool = _gameplaySystem->GetProjectilePool();
+	if (!projectiles.empty() && !pool.Read(projectiles.data(), projectiles.size())) {
+		std::cerr << "Pooled projectiles in the save are corrupt" << std::endl;
+		return false;
+	}
+	if (_gameplaySystem->IsProjectilePoolEnabled()) {
+		pool.AdoptFrom(_registry);
+	} else {
+		pool.ExportTo(_registry);
+	}
+
+	// Insert all loaded entities with Position into spatial grid
+	if (_spatialGrid) {
+		auto positionView = _registry.view<Position>();
+		for (auto entity : positionView) {
+			const auto& pos = positionView.get<Position>(entity);
+			_spatialGrid->Insert(entity, pos.value);
+		}
+	}
+	return true;
+}
+
+// cereal saves carry the pooled projectile section as a byte array after the registry, when there is one
+template<typename Archive>
+static void saveProjectileSection(Archive& archive, const std::vector<std::byte>& section) {
+	if (section.empty()) {
+		return;
+	}
+	const auto* bytes = reinterpret_cast<const uint8_t*>(section.data());
+	std::vector<uint8_t> data(bytes, bytes + section.size());
+	archive(cereal::make_nvp("projectile_pool", data));
+}
+
+template<typename Archive>
+static void readProjectileSection(Archive& archive, std::vector<std::byte>& section) {
+	std::vector<uint8_t> data;
+	archive(cereal::make_nvp("projectile_pool", data));
+	const auto* bytes = reinterpret_cast<const std::byte*>(data.data());
+	section.assign(bytes, bytes + data.size());
+}
+
+// Older saves and saves written without the pool end after the registry
+static void loadProjectileSection(cereal::JSONInputArchive& archive, std::istream&, std::vector<std::byte>& section) {
+	const char* name = archive.getNodeName();
+	if (name && std::strcmp(name, "projectile_pool") == 0) {
+		readProjectileSection(archive, section);
+	}
+}
+
+static void loadProjectileSection(cereal::BinaryInputArchive& archive, std::istream& is, std::vector<std::byte>& section) {
+	if (is.peek() != std::char_traits<char>::eof()) {
+		readProjectileSection(archive, section);
+	}
+}
+
+std::vector<std::byte> World::projectileSection() const {
+	std::vector<std::byte> section;
+	if (_gameplaySystem->IsProjectilePoolEnabled()) {
+		_gameplaySystem->GetProjectilePool().Write(section);
+	}
+	return section;
+}
+
 bool World::SaveGame(const std::string& filepath) {
+	RTS_PROFILE_SCOPE("World::SaveGame");
 	try {
 		// Create directory if it doesn't exist
 		std::filesystem::path path(filepath);
@@ -140,34 +434,33 @@ bool World::SaveGame(const std::string& filepath) {
 			std::filesystem::create_directories(dir);
 		}
 
+		SaveFormat format = GetSaveFormat(filepath);
+		std::vector<std::byte> projectiles = projectileSection();
+		if (format == SaveFormat::Snapshot) {
+			return SnapshotFile::Save(_registry, filepath, PersistedComponents{}, &projectiles);
+		}
+		if (format == SaveFormat::CompressedSnapshot) {
+			std::vector<std::byte> image;
+			SnapshotFile::Capture(_registry, PersistedComponents{}, image, &projectiles);
+			return writeImage(image, filepath);
+		}
+
 		// Open file for writing
-		std::ofstream os(filepath);
+		std::ofstream os(filepath, format == SaveFormat::Binary ? std::ios::binary : std::ios::out);
 		if (!os.is_open()) {
 			std::cerr << "Failed to open file for writing: " << filepath << std::endl;
 			return false;
 		}
 
-		// Create JSON output archive
-		{
+		// The archive flushes when it goes out of scope
+		if (format == SaveFormat::Binary) {
+			cereal::BinaryOutputArchive archive(os);
+			saveSnapshot(_registry, archive);
+			saveProjectileSection(archive, projectiles);
+		} else {
 			cereal::JSONOutputArchive archive(os);
-
-			// Create snapshot and serialize all entities and components using EnTT's .get() API
-			entt::snapshot snapshot{ _registry };
-			snapshot.get<entt::entity>(archive)
-				.get<Position>(archive)
-				.get<Movement>(archive)
-				.get<Color>(archive)
-				.get<Unit>(archive)
-				.get<Camera>(archive)
-				.get<MainCamera>(archive)
-				.get<Faction>(archive)
-				.get<Health>(archive)
-				.get<DirectDamage>(archive)
-				.get<ProjectileEmitter>(archive)
-				.get<Healer>(archive)
-				.get<AttackTarget>(archive)
-				.get<Projectile>(archive)
-				.get<StateAttackingTag>(archive);
+			saveSnapshot(_registry, archive);
+			saveProjectileSection(archive, projectiles);
 		}
 
 		os.close();
@@ -179,6 +472,7 @@ bool World::SaveGame(const std::string& filepath) {
 }
 
 bool World::LoadGame(const std::string& filepath) {
+	RTS_PROFILE_SCOPE("World::LoadGame");
 	try {
 		// Check if file exists
 		if (!std::filesystem::exists(filepath)) {
@@ -186,77 +480,276 @@ bool World::LoadGame(const std::string& filepath) {
 			return false;
 		}
 
+		SaveFormat format = GetSaveFormat(filepath);
+		if (format == SaveFormat::Snapshot) {
+			// Mapped and bulk-inserted, no stream. A stale or corrupt file is rejected before the world is cleared.
+			MappedFile file;
+			if (!file.Open(filepath)) {
+				std::cerr << "Failed to map snapshot: " << filepath << std::endl;
+				return false;
+			}
+			if (!SnapshotFile::Validate(file.GetData(), file.GetSize(), PersistedComponents{}, filepath)) {
+				return false;
+			}
+			clearForLoad();
+
+			SnapshotEntityMap entities;
+			std::vector<std::byte> projectiles;
+			if (!SnapshotFile::Read(_registry, file.GetData(), file.GetSize(), PersistedComponents{}, entities, filepath, &projectiles)) {
+				return false;
+			}
+			remapAttackTargets(_registry, [&entities](entt::entity saved) { return entities.Map(saved); });
+			return finishLoad(projectiles);
+		}
+		if (format == SaveFormat::CompressedSnapshot) {
+			// Decoded into memory, then the same bulk insert as a mapped snapshot
+			MappedFile file;
+			std::vector<std::byte> image;
+			if (!file.Open(filepath) || !SnapshotCodec::Decode(file.GetData(), file.GetSize(), image, filepath)) {
+				return false;
+			}
+			file.Close();
+			if (!SnapshotFile::Validate(image.data(), image.size(), PersistedComponents{}, filepath)) {
+				return false;
+			}
+			clearForLoad();
+
+			SnapshotEntityMap entities;
+			std::vector<std::byte> projectiles;
+			if (!SnapshotFile::Read(_registry, image.data(), image.size(), PersistedComponents{}, entities, filepath, &projectiles)) {
+				return false;
+			}
+			remapAttackTargets(_registry, [&entities](entt::entity saved) { return entities.Map(saved); });
+			return finishLoad(projectiles);
+		}
+
 		// Open file for reading
-		std::ifstream is(filepath);
+		std::ifstream is(filepath, format == SaveFormat::Binary ? std::ios::binary : std::ios::in);
 		if (!is.is_open()) {
 			std::cerr << "Failed to open file for reading: " << filepath << std::endl;
 			return false;
 		}
 
 		// Clear current registry
-		_registry.clear();
-		_spatialGrid->Clear();
-		_cameraEntity = entt::null;
-
-		// Create JSON input archive
-		cereal::JSONInputArchive archive(is);
-
-		// Create continuous loader for entity remapping
-		entt::continuous_loader loader{_registry};
-
-		// Load entities and all components using EnTT's .get() API
-		loader.get<entt::entity>(archive)
-			.get<Position>(archive)
-			.get<Movement>(archive)
-			.get<Color>(archive)
-			.get<Unit>(archive)
-			.get<Camera>(archive)
-			.get<MainCamera>(archive)
-			.get<Faction>(archive)
-			.get<Health>(archive)
-			.get<DirectDamage>(archive)
-			.get<ProjectileEmitter>(archive)
-			.get<Healer>(archive)
-			.get<AttackTarget>(archive)
-			.get<Projectile>(archive)
-			.get<StateAttackingTag>(archive);
-
-		// Post-process: Fix entity references in AttackTarget components
-		// The continuous_loader automatically handles entity remapping internally,
-		// but AttackTarget stores an entity that needs manual remapping
-		auto attackTargetView = _registry.view<AttackTarget>();
-		for (auto entity : attackTargetView) {
-			auto& at = attackTargetView.get<AttackTarget>(entity);
-			if (at.target != entt::null && loader.contains(at.target)) {
-				at.target = loader.map(at.target);
-			} else {
-				at.target = entt::null; // Reference died or invalid
-			}
+		clearForLoad();
+
+		std::vector<std::byte> projectiles;
+		if (format == SaveFormat::Binary) {
+			cereal::BinaryInputArchive archive(is);
+			loadSnapshot(archive);
+			loadProjectileSection(archive, is, projectiles);
+		} else {
+			cereal::JSONInputArchive archive(is);
+			loadSnapshot(archive);
+			loadProjectileSection(archive, is, projectiles);
 		}
 
-		// Find the camera entity (should have MainCamera tag)
-		auto cameraView = _registry.view<MainCamera>();
-		if (!cameraView.empty()) {
-			_cameraEntity = *cameraView.begin();
+		is.close();
+		return finishLoad(projectiles);
+	} catch (const std::exception& e) {
+		std::cerr << "Error loading game: " << e.what() << std::endl;
+		return false;
+	}
+}
+
+bool World::SaveGameAsync(const std::string& filepath) {
+	RTS_PROFILE_SCOPE("World::SaveGameAsync");
+	if (_saveThread.joinable()) {
+		PollSave();
+		if (_saveThread.joinable()) {
+			std::cerr << "A save is already running: " << _saveStatus.path << std::endl;
+			return false;
 		}
+	}
 
-		// Insert all loaded entities with Position into spatial grid
-		if (_spatialGrid) {
-			auto positionView = _registry.view<Position>();
-			for (auto entity : positionView) {
-				const auto& pos = positionView.get<Position>(entity);
-				_spatialGrid->Insert(entity, pos.value);
-			}
+	try {
+		std::filesystem::path dir = std::filesystem::path(filepath).parent_path();
+		if (!dir.empty() && !std::filesystem::exists(dir)) {
+			std::filesystem::create_directories(dir);
 		}
+	} catch (const std::exception& e) {
+		std::cerr << "Error saving game: " << e.what() << std::endl;
+		return false;
+	}
 
-		// Clean up orphaned entities
-		loader.orphans();
+	// The pause: raw copies of every persisted pool
+	auto captureStart = std::chrono::steady_clock::now();
+	std::vector<std::byte> image;
+	std::vector<std::byte> projectiles = projectileSection();
+	SnapshotFile::Capture(_registry, PersistedComponents{}, image, &projectiles);
+
+	_saveStatus = SaveStatus{};
+	_saveStatus.state = SaveStatus::State::Saving;
+	_saveStatus.path = filepath;
+	_saveStatus.captureMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - captureStart).count();
+	_saveDone.store(false);
+
+	// Everything the thread reads is its own copy; it publishes _saveSucceeded and _saveWriteMs through _saveDone
+	_saveThread = std::thread([this, image = std::move(image), filepath]() {
+		RTS_PROFILE_THREAD("Save");
+		auto writeStart = std::chrono::steady_clock::now();
+		_saveSucceeded = writeImage(image, filepath);
+		_saveWriteMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - writeStart).count();
+		_saveDone.store(true, std::memory_order_release);
+	});
+	return true;
+}
 
-		is.close();
+const SaveStatus& World::PollSave() {
+	if (_saveThread.joinable() && _saveDone.load(std::memory_order_acquire)) {
+		finishSave();
+	}
+	return _saveStatus;
+}
+
+void World::WaitForSave() {
+	if (_saveThread.joinable()) {
+		finishSave();
+	}
+}
+
+void World::finishSave() {
+	_saveThread.join();
+	_saveStatus.state = _saveSucceeded ? SaveStatus::State::Saved : SaveStatus::State::Failed;
+	_saveStatus.writeMs = _saveWriteMs;
+}
+
+bool World::writeImage(const std::vector<std::byte>& image, const std::string& filepath) {
+	RTS_PROFILE_SCOPE("World::writeImage");
+	try {
+		SaveFormat format = GetSaveFormat(filepath);
+		if (format == SaveFormat::Snapshot) {
+			return SnapshotFile::WriteImage(image, filepath);
+		}
+		if (format == SaveFormat::CompressedSnapshot) {
+			std::vector<std::byte> encoded;
+			return SnapshotCodec::Encode(image, encoded) && SnapshotFile::WriteImage(encoded, filepath);
+		}
+
+		// Rebuild the pools in a private registry and serialize that. Entity ids come out compacted,
+		// which the continuous loader on the other end does not care about.
+		entt::registry registry;
+		SnapshotEntityMap entities;
+		std::vector<std::byte> projectiles;
+		if (!SnapshotFile::Read(registry, image.data(), image.size(), PersistedComponents{}, entities, filepath, &projectiles)) {
+			return false;
+		}
+		remapAttackTargets(registry, [&entities](entt::entity saved) { return entities.Map(saved); });
+
+		std::ofstream os(filepath, format == SaveFormat::Binary ? std::ios::binary : std::ios::out);
+		if (!os.is_open()) {
+			std::cerr << "Failed to open file for writing: " << filepath << std::endl;
+			return false;
+		}
+		if (format == SaveFormat::Binary) {
+			cereal::BinaryOutputArchive archive(os);
+			saveSnapshot(registry, archive);
+			saveProjectileSection(archive, projectiles);
+		} else {
+			cereal::JSONOutputArchive archive(os);
+			saveSnapshot(registry, archive);
+			saveProjectileSection(archive, projectiles);
+		}
 		return true;
 	} catch (const std::exception& e) {
-		std::cerr << "Error loading game: " << e.what() << std::endl;
+		std::cerr << "Error saving game: " << e.what() << std::endl;
 		return false;
 	}
 }
 
+bool World::WriteKeyframe(const std::string& filepath) {
+	RTS_PROFILE_SCOPE("World::WriteKeyframe");
+	try {
+		std::filesystem::path dir = std::filesystem::path(filepath).parent_path();
+		if (!dir.empty() && !std::filesystem::exists(dir)) {
+			std::filesystem::create_directories(dir);
+		}
+	} catch (const std::exception& e) {
+		std::cerr << "Error saving game: " << e.what() << std::endl;
+		_deltaChainPath.clear();
+		return false;
+	}
+
+	if (!_deltaRecorder) {
+		_deltaRecorder = std::make_unique<DeltaRecorder>(_registry, PersistedComponents{}, PatchedComponents{});
+	}
+	std::vector<std::byte> projectiles = projectileSection();
+	if (!DeltaChain::WriteKeyframe(_registry, filepath, PersistedComponents{}, &projectiles)) {
+		_deltaChainPath.clear();
+		return false;
+	}
+
+	_deltaRecorder->Reset();
+	_deltaChainPath = filepath;
+	_deltaCount = 0;
+	return true;
+}
+
+bool World::WriteDelta() {
+	RTS_PROFILE_SCOPE("World::WriteDelta");
+	if (!_deltaRecorder || _deltaChainPath.empty()) {
+		std::cerr << "WriteDelta needs a keyframe first" << std::endl;
+		return false;
+	}
+
+	_deltaBuffer.clear();
+	std::vector<std::byte> projectiles = projectileSection();
+	_deltaRecorder->Capture(_deltaBuffer, &projectiles);
+	if (!DeltaChain::AppendDelta(_deltaChainPath, _deltaBuffer)) {
+		return false;
+	}
+	_deltaCount++;
+	return true;
+}
+
+bool World::LoadFrame(const std::string& filepath, int deltaCount) {
+	RTS_PROFILE_SCOPE("World::LoadFrame");
+	// Reject a bad keyframe or a short chain while the running game is still intact
+	{
+		MappedFile keyframe;
+		if (!keyframe.Open(filepath)) {
+			std::cerr << "Failed to map snapshot: " << filepath << std::endl;
+			return false;
+		}
+		if (!SnapshotFile::Validate(keyframe.GetData(), keyframe.GetSize(), PersistedComponents{}, filepath)) {
+			return false;
+		}
+	}
+	if (deltaCount != 0) {
+		int available = GetDeltaCount(filepath);
+		if (available < 0) {
+			std::cerr << "Missing or stale delta chain: " << DeltaChain::GetChainPath(filepath) << std::endl;
+			return false;
+		}
+		if (deltaCount > available) {
+			std::cerr << "Delta chain has fewer than " << deltaCount << " deltas: " << DeltaChain::GetChainPath(filepath) << std::endl;
+			return false;
+		}
+	}
+	clearForLoad();
+
+	DeltaEntityMap entities;
+	std::vector<std::byte> projectiles;
+	if (!DeltaChain::Load(_registry, filepath, PersistedComponents{}, deltaCount, entities, &projectiles)) {
+		return false;
+	}
+
+	// References to entities destroyed along the chain map to dead entities
+	remapAttackTargets(_registry, [this, &entities](entt::entity saved) {
+		entt::entity entity = entities.Map(saved);
+		return _registry.valid(entity) ? entity : entt::null;
+	});
+	return finishLoad(projectiles);
+}
+
+int World::GetDeltaCount(const std::string& filepath) {
+	return DeltaChain::GetDeltaCount(filepath, PersistedComponents{});
+}
+
+void World::autosave() {
+	if (_deltaChainPath != _autosavePath || _deltaCount >= _autosaveKeyframeEvery) {
+		WriteKeyframe(_autosavePath);
+	} else {
+		WriteDelta();
+	}
+}
@@ -8,6 +8,23 @@
 #include "../systems/gameplay_system.hpp"
 #include "../systems/render_system.hpp"
 #include "unit_factory.hpp"
+#include "delta_snapshot.hpp"
+#include "../utils/job_system.hpp"
+#include "../utils/frame_arena.hpp"
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+// Progress of the last World::SaveGameAsync
+struct SaveStatus {
+	enum class State { Idle, Saving, Saved, Failed };
+
+	State state = State::Idle;
+	std::string path;
+	double captureMs = 0.0; // Main-thread pause while the pools were copied
+	double writeMs = 0.0;   // Worker time spent encoding and writing the file
+};
 
 struct UnitCountData {
 	int footmanCount[8] = {0};
@@ -18,40 +35,154 @@ struct UnitCountData {
 	int projectileCount = 0;
 };
 
+// Outcome of World::RunUntilResolved
+struct BattleResult {
+	int ticks = 0;
+	bool resolved = false;      // At most one faction has units left
+	int winner = -1;            // Last faction standing, -1 for a draw (nobody left) or an unresolved battle
+	int aliveCount[8] = {0};    // Units left per faction (projectiles excluded)
+	double seconds = 0.0;       // Wall-clock time spent simulating
+};
+
 class World {
 public:
 	World();
-	~World() = default;
+	~World(); // Waits for a background save to finish
 
 	// Initialize world with configuration
 	bool Initialize(const nlohmann::json& config, bool enableRender = true);
 
-	// Update gameplay systems
+	// Update gameplay systems (resets the frame arena first). The gameplay timings cover this update only.
 	void Update(float dt);
 
+	// Fixed-step frame: ticks updates of step seconds each. With interpolation on, positions before
+	// the last tick are kept so Render can draw between the last two ticks (SetInterpolationAlpha).
+	// A frame with no tick (paused, or faster than the simulation rate) still resets the frame arena.
+	// The gameplay timings are summed over the frame's ticks (all zero for a frame with none).
+	void Step(int ticks, float step);
+
+	// Fast-forward for headless batch runs: tick at dt as fast as possible until at most one faction
+	// has units left or maxTicks have run
+	BattleResult RunUntilResolved(float dt, int maxTicks);
+
+	// Blend factor between the previous and the current tick for rendering (1 = current positions)
+	void SetInterpolationAlpha(float alpha) { _interpolationAlpha = alpha; }
+
 	// Render the world
 	void Render();
 
 	// Spawn a unit at the specified position
 	entt::entity SpawnUnit(UnitType type, int faction, const Vec2& position);
 
+	// Spawn one unit per position (positions outside the world are skipped) and return the new entities.
+	// Same result as calling SpawnUnit for each position in order, with components and grid links added in bulk.
+	std::vector<entt::entity> SpawnUnits(UnitType type, int faction, const std::vector<Vec2>& positions);
+
 	// Accessors
 	entt::registry& GetRegistry() { return _registry; }
 	SpatialGrid& GetSpatialGrid() { return *_spatialGrid; }
+	GameplaySystem& GetGameplaySystem() { return *_gameplaySystem; }
 	entt::entity GetCameraEntity() const { return _cameraEntity; }
 	Camera* GetCamera();
 
+	// Scratch memory for per-frame temporaries (input, UI). Everything in it is released at the next Update or Step.
+	FrameArena& GetFrameArena() { return _frameArena; }
+
 	// Get unit statistics
 	UnitCountData GetUnitCounts() const;
 
 	// Get faction colors
 	const std::vector<Color>& GetFactionColors() const;
 
-	// Save/Load game state
+	// Components written by SaveGame, in archive order. Changing the list changes the ".snap" schema hash.
+	using PersistedComponents = entt::type_list<Position, Movement, Color, Unit, Camera, MainCamera, Faction, Health,
+		DirectDamage, ProjectileEmitter, Healer, AttackTarget, Projectile, StateAttackingTag>;
+
+	// Persisted components whose in-place writers publish on_update (the gameplay system does for the cooldown
+	// timers). The delta recorder tracks them with a dirty list instead of diffing a shadow copy.
+	using PatchedComponents = entt::type_list<Unit, Faction, DirectDamage, ProjectileEmitter, Healer>;
+
+	// On-disk save formats, picked from the file extension
+	enum class SaveFormat {
+		Json,    // Human-readable, used by the regression fixtures (default for any other extension)
+		Binary,  // ".bin": cereal binary archive, compact and fast but tied to this build's layout and endianness
+		Snapshot,          // ".snap": memory-mapped pool blocks bulk-inserted on load (SnapshotFile), same caveats as Binary
+		CompressedSnapshot // ".snapz": the ".snap" image compressed per pool block (SnapshotCodec), decoded into memory on load
+	};
+
+	static SaveFormat GetSaveFormat(const std::string& filepath);
+
+	// Save/Load game state (format from the file extension). With the projectile pool on, every format also
+	// carries the pool's own section (ProjectilePool::Write); the registry is not touched to save it.
 	bool SaveGame(const std::string& filepath);
 	bool LoadGame(const std::string& filepath);
 
+	// Copy the persisted pools (the only pause: one memcpy of the entities and one sequential pass over the
+	// components per pool) and encode and write them on a worker thread; the world can keep simulating
+	// meanwhile. False if a save is already running.
+	bool SaveGameAsync(const std::string& filepath);
+
+	// Collect a finished background save and return its status
+	const SaveStatus& PollSave();
+
+	// Block until the background save (if any) has finished
+	void WaitForSave();
+
+	// Incremental saves for autosave and rewind: a ".snap" keyframe plus a chain of deltas next to it (DeltaChain).
+	// WriteKeyframe starts a new chain; WriteDelta appends what changed since the previous keyframe or delta.
+	// While a chain is open the recorder keeps a shadow copy of every diffed pool (one component plus one entity
+	// per entity index, about 85 bytes per unit) and WriteDelta compares those pools in full; the
+	// PatchedComponents pools only cost a dirty list of the entities written since the last delta.
+	bool WriteKeyframe(const std::string& filepath);
+	bool WriteDelta();
+
+	// Rebuild the world from a keyframe and its first deltaCount deltas (-1 for the whole chain)
+	bool LoadFrame(const std::string& filepath, int deltaCount = -1);
+
+	// Deltas written after a keyframe, -1 if it has no chain
+	static int GetDeltaCount(const std::string& filepath);
+
 private:
+	// Serialize every persisted component through an EnTT snapshot; the archive type picks the format
+	template<typename Archive>
+	static void saveSnapshot(const entt::registry& registry, Archive& archive);
+
+	// Load through a continuous loader, remap AttackTarget references and drop orphans
+	template<typename Archive>
+	void loadSnapshot(Archive& archive);
+
+	// Point AttackTarget at the loaded entities; map(saved) returns entt::null for references that were not saved
+	template<typename Map>
+	static void remapAttackTargets(entt::registry& registry, Map&& map);
+
+	// Write a save from an in-memory snapshot image (SnapshotFile::Capture); runs on the save thread
+	static bool writeImage(const std::vector<std::byte>& image, const std::string& filepath);
+
+	// Join the save thread and publish its result in _saveStatus
+	void finishSave();
+
+	// Put the loaded world back together: find the camera, restore the projectile pool from its save section
+	// (empty if the save has none) and fill the spatial grid. False if the section is corrupt.
+	bool finishLoad(const std::vector<std::byte>& projectiles);
+
+	// The projectile pool's save section, empty when the pool is off
+	std::vector<std::byte> projectileSection() const;
+
+	// Drop the registry contents and the delta recorder before loading
+	void clearForLoad();
+
+	// One gameplay tick and the autosave timer; adds to the gameplay timings
+	void tick(float dt);
+
+	// Keyframe or delta, whichever the autosave settings call for
+	void autosave();
+
+	// Copy every Position into PreviousPosition
+	void storePreviousPositions();
+
+	// True while units of fewer than two factions are left
+	bool isResolved() const;
+
 	entt::registry _registry;
 	entt::entity _cameraEntity;
 
@@ -60,5 +191,35 @@ private:
 	GameplaySystem* _gameplaySystem;
 	RenderSystem* _renderSystem;
 	UnitFactory* _unitFactory;
+
+	// Worker pool for the parallel gameplay passes (joins its threads when the world goes away)
+	std::unique_ptr<JobSystem> _jobSystem;
+
+	FrameArena _frameArena;
+
+	// Render interpolation for fixed-step frames ("global.render_interpolation")
+	bool _interpolate = false;
+	float _interpolationAlpha = 1.0f;
+	float _maxSpeed = 0.0f; // Fastest unit or projectile in the config
+	float _tickStep = 0.0f; // Step of the last fixed-step frame
+
+	// Delta chain being written (recorder exists only after WriteKeyframe)
+	std::unique_ptr<DeltaRecorder> _deltaRecorder;
+	std::vector<std::byte> _deltaBuffer;
+	std::string _deltaChainPath;
+	int _deltaCount = 0;
+
+	// Background save: the thread owns the captured image; the status is published through _saveDone
+	std::thread _saveThread;
+	std::atomic<bool> _saveDone{false};
+	bool _saveSucceeded = false;
+	double _saveWriteMs = 0.0;
+	SaveStatus _saveStatus;
+
+	// Autosave ("global.autosave_*" in the config, off when the interval is 0)
+	std::string _autosavePath;
+	float _autosaveInterval = 0.0f;  // Seconds of game time between saves
+	int _autosaveKeyframeEvery = 30; // Deltas before a fresh keyframe
+	float _autosaveTimer = 0.0f;
 };
 
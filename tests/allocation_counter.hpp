@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstddef>
+#include "../src/utils/allocation_stats.hpp"
+
+// Counts global operator new calls (see AllocationStats).
+// Tests that assert on it skip when IsEnabled() is false (Release or RTS_COUNT_ALLOCATIONS=OFF).
+// Construct one before the code under test; GetCount() returns the allocations made since then, on any thread.
+class AllocationCounter {
+public:
+	AllocationCounter() : _start(GetTotal()) {}
+
+	size_t GetCount() const { return GetTotal() - _start; }
+
+	static bool IsEnabled() { return AllocationStats::IsEnabled(); }
+
+	// Allocations since the process started
+	static size_t GetTotal() { return AllocationStats::GetTotal(); }
+
+private:
+	size_t _start;
+};
@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+#include "../src/world/command_buffer.hpp"
+#include "../src/components/components.hpp"
+#include <string>
+#include <vector>
+
+class CommandBufferTest : public ::testing::Test {
+protected:
+	entt::entity createUnit(Vec2 pos) {
+		auto entity = registry.create();
+		registry.emplace<Position>(entity, Position{pos});
+		registry.emplace<Health>(entity, Health{100.0f, 100.0f, 0.0f});
+		return entity;
+	}
+
+	entt::registry registry;
+	CommandBuffer commands;
+};
+
+TEST_F(CommandBufferTest, Create_IsDeferredUntilFlush) {
+	commands.Create(Position{Vec2(1.0f, 2.0f)}, Projectile{10.0f, 1, false, 0.0f});
+
+	EXPECT_EQ(registry.view<Projectile>().size(), 0u);
+	EXPECT_EQ(commands.GetCommandCount(), 1u);
+
+	commands.Flush(registry);
+
+	auto view = registry.view<Position, Projectile>();
+	ASSERT_EQ(view.size_hint(), 1u);
+	for (auto entity : view) {
+		EXPECT_FLOAT_EQ(view.get<Position>(entity).value.x, 1.0f);
+		EXPECT_FLOAT_EQ(view.get<Position>(entity).value.y, 2.0f);
+		EXPECT_FLOAT_EQ(view.get<Projectile>(entity).damage, 10.0f);
+		EXPECT_EQ(view.get<Projectile>(entity).faction, 1);
+	}
+	EXPECT_TRUE(commands.IsEmpty());
+}
+
+TEST_F(CommandBufferTest, Create_MatchesImmediateEntityIds) {
+	// Recycled ids must come out the same as creating directly, so deferred spawns stay deterministic
+	entt::registry direct;
+	std::vector<entt::entity> expected;
+	for (int i = 0; i < 5; ++i) {
+		direct.create();
+		registry.create();
+	}
+	for (int i = 0; i < 3; ++i) {
+		expected.push_back(direct.create());
+		commands.Create(Position{Vec2(static_cast<float>(i), 0.0f)});
+	}
+
+	commands.Flush(registry);
+
+	for (int i = 0; i < 3; ++i) {
+		ASSERT_TRUE(registry.valid(expected[i]));
+		EXPECT_FLOAT_EQ(registry.get<Position>(expected[i]).value.x, static_cast<float>(i));
+	}
+}
+
+TEST_F(CommandBufferTest, EmplaceAndRemoveTag_AppliedInRecordOrder) {
+	auto a = createUnit(Vec2(0.0f, 0.0f));
+	auto b = createUnit(Vec2(1.0f, 0.0f));
+	registry.emplace<StateAttackingTag>(b);
+
+	commands.Emplace<StateAttackingTag>(a);
+	commands.Remove<StateAttackingTag>(b);
+	commands.Emplace<StateAttackingTag>(a); // Already queued: adding twice is harmless
+
+	EXPECT_FALSE(registry.all_of<StateAttackingTag>(a));
+	EXPECT_TRUE(registry.all_of<StateAttackingTag>(b));
+
+	commands.Flush(registry);
+
+	EXPECT_TRUE(registry.all_of<StateAttackingTag>(a));
+	EXPECT_FALSE(registry.all_of<StateAttackingTag>(b));
+}
+
+TEST_F(CommandBufferTest, Emplace_ReplacesExistingComponent) {
+	auto entity = createUnit(Vec2(0.0f, 0.0f));
+
+	commands.Emplace<Position>(entity, Vec2(5.0f, 6.0f));
+	commands.Flush(registry);
+
+	EXPECT_FLOAT_EQ(registry.get<Position>(entity).value.x, 5.0f);
+	EXPECT_FLOAT_EQ(registry.get<Position>(entity).value.y, 6.0f);
+}
+
+TEST_F(CommandBufferTest, Destroy_SkipsEntitiesAlreadyGone) {
+	auto a = createUnit(Vec2(0.0f, 0.0f));
+	auto b = createUnit(Vec2(1.0f, 0.0f));
+	auto c = createUnit(Vec2(2.0f, 0.0f));
+
+	commands.Destroy(a);
+	commands.Destroy(b);
+	commands.Emplace<StateAttackingTag>(b); // Targets a destroyed entity, skipped
+	commands.Destroy(c);
+	registry.destroy(c);
+
+	commands.Flush(registry);
+
+	EXPECT_FALSE(registry.valid(a));
+	EXPECT_FALSE(registry.valid(b));
+	EXPECT_FALSE(registry.valid(c));
+	EXPECT_EQ(registry.view<Health>().size(), 0u);
+}
+
+TEST_F(CommandBufferTest, Clear_DropsCommandsAndReleasesPayloads) {
+	// Non-trivial payloads must be destroyed whether or not they were applied
+	commands.Create(Position{Vec2(0.0f, 0.0f)}, std::string(256, 'x'));
+	commands.Clear();
+	commands.Flush(registry);
+
+	EXPECT_EQ(registry.view<Position>().size(), 0u);
+	EXPECT_TRUE(commands.IsEmpty());
+}
+
+TEST_F(CommandBufferTest, Flush_ReusesStorageAcrossFrames) {
+	// Record more than one arena block worth of commands every frame
+	for (int frame = 0; frame < 4; ++frame) {
+		for (int i = 0; i < 500; ++i) {
+			commands.Create(Position{Vec2(static_cast<float>(i), 0.0f)}, Projectile{1.0f, 0, false, 0.0f});
+		}
+		commands.Flush(registry);
+
+		for (auto entity : registry.view<Projectile>()) {
+			commands.Destroy(entity);
+		}
+		commands.Flush(registry);
+		EXPECT_EQ(registry.view<Projectile>().size(), 0u);
+	}
+}
@@ -0,0 +1,54 @@
+#include "fake_gpu_buffer_backend.hpp"
+
+FakeGpuBufferBackend::FakeGpuBufferBackend(bool persistent)
+	: _persistent(persistent)
+{
+}
+
+bool FakeGpuBufferBackend::Create(size_t size) {
+	_memory.assign(size, 0);
+	_bufferId = static_cast<unsigned int>(++_createCount);
+	return true;
+}
+
+void FakeGpuBufferBackend::Destroy() {
+	_memory.clear();
+	_bufferId = 0;
+	_mapped = false;
+}
+
+void* FakeGpuBufferBackend::Map(size_t offset, size_t size) {
+	if (offset + size > _memory.size()) {
+		return nullptr;
+	}
+	_mapCount++;
+	_mapped = true;
+	return _memory.data() + offset;
+}
+
+void FakeGpuBufferBackend::Unmap() {
+	_unmapCount++;
+	_mapped = false;
+}
+
+void FakeGpuBufferBackend::Draw() {
+	if (_mapped && !_persistent) {
+		_mappedUseCount++;
+	}
+}
+
+GpuFence FakeGpuBufferBackend::InsertFence() {
+	if (_mapped && !_persistent) {
+		_mappedUseCount++;
+	}
+	return _nextFence++;
+}
+
+void FakeGpuBufferBackend::WaitAndDeleteFence(GpuFence fence) {
+	_waitedFences.push_back(fence);
+	if (fence > _signaled) {
+		// A real backend would block here until the GPU catches up
+		_stallCount++;
+		_signaled = fence;
+	}
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <vector>
+#include "utils/gpu_buffer_backend.hpp"
+
+// CPU-only GpuBufferBackend for testing RingBuffer without a GL context.
+// Fences are sequential ids; a fence counts as "signaled" once the test calls SignalUpTo().
+// Waiting on an unsignaled fence is recorded as a stall. Draw() stands in for a draw call reading the buffer;
+// draws and fences issued while a non-persistent mapping is open are counted, since GL rejects those draws.
+class FakeGpuBufferBackend : public GpuBufferBackend {
+public:
+	FakeGpuBufferBackend(bool persistent = true);
+
+	bool Create(size_t size) override;
+	void Destroy() override;
+
+	bool IsPersistent() const override { return _persistent; }
+
+	void* Map(size_t offset, size_t size) override;
+	void Unmap() override;
+
+	GpuFence InsertFence() override;
+	void WaitAndDeleteFence(GpuFence fence) override;
+
+	unsigned int GetBufferId() const override { return _bufferId; }
+
+	// Simulate a draw call that reads the buffer
+	void Draw();
+
+	// Simulate GPU progress: every fence up to and including `fence` is complete
+	void SignalUpTo(GpuFence fence) { _signaled = fence; }
+
+	// Inspection helpers
+	size_t GetSize() const { return _memory.size(); }
+	int GetCreateCount() const { return _createCount; }
+	int GetMapCount() const { return _mapCount; }
+	int GetUnmapCount() const { return _unmapCount; }
+	int GetStallCount() const { return _stallCount; }
+	bool IsMapped() const { return _mapped; }
+	int GetMappedUseCount() const { return _mappedUseCount; }
+	const std::vector<GpuFence>& GetWaitedFences() const { return _waitedFences; }
+	GpuFence GetLastFence() const { return _nextFence - 1; }
+
+private:
+	bool _persistent;
+	std::vector<char> _memory;
+	unsigned int _bufferId = 0;
+	bool _mapped = false;
+
+	GpuFence _nextFence = 1;
+	GpuFence _signaled = 0;
+	std::vector<GpuFence> _waitedFences;
+
+	int _createCount = 0;
+	int _mapCount = 0;
+	int _unmapCount = 0;
+	int _stallCount = 0;
+	int _mappedUseCount = 0; // Draws and fences while a non-persistent mapping was open
+};
@@ -0,0 +1,139 @@
+#include <gtest/gtest.h>
+#include "allocation_counter.hpp"
+#include "../src/utils/frame_arena.hpp"
+#include "../src/utils/job_system.hpp"
+#include "../src/systems/gameplay_system.hpp"
+#include "../src/world/spatial_grid.hpp"
+#include "../src/components/components.hpp"
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+TEST(FrameArenaTest, Allocate_RespectsAlignment) {
+	FrameArena arena(256);
+
+	for (size_t alignment : {1u, 2u, 4u, 8u, 16u, 32u, 64u}) {
+		arena.Allocate(3, 1); // Knock the head off alignment
+		void* memory = arena.Allocate(24, alignment);
+		EXPECT_EQ(reinterpret_cast<uintptr_t>(memory) % alignment, 0u) << "alignment " << alignment;
+	}
+}
+
+TEST(FrameArenaTest, Reset_FoldsOverflowIntoOneBlock) {
+	FrameArena arena(256);
+
+	// Three times the block size forces chained blocks
+	for (int i = 0; i < 12; ++i) {
+		arena.Allocate(64);
+	}
+	EXPECT_GT(arena.GetCapacity(), 256u);
+	size_t peak = arena.GetCapacity();
+
+	arena.Reset();
+	EXPECT_EQ(arena.GetUsed(), 0u);
+	EXPECT_EQ(arena.GetCapacity(), peak);
+
+	// The same frame again fits in the folded block without asking the heap for more
+	size_t blocks = arena.GetBlockAllocations();
+	for (int frame = 0; frame < 5; ++frame) {
+		for (int i = 0; i < 12; ++i) {
+			arena.Allocate(64);
+		}
+		arena.Reset();
+	}
+	EXPECT_EQ(arena.GetBlockAllocations(), blocks);
+}
+
+TEST(FrameArenaTest, PmrContainers_DoNotTouchTheHeapAfterWarmUp) {
+	if (!AllocationCounter::IsEnabled()) {
+		GTEST_SKIP() << "Allocation counting is not built in";
+	}
+	FrameArena arena;
+
+	auto frame = [&arena]() {
+		{
+			std::pmr::vector<int> values(&arena);
+			for (int i = 0; i < 1000; ++i) {
+				values.push_back(i);
+			}
+			std::pmr::string text(&arena);
+			text.assign(200, 'x');
+		}
+		arena.Reset();
+	};
+
+	frame(); // Warm-up: the arena grows to the frame's peak
+
+	AllocationCounter allocations;
+	for (int i = 0; i < 10; ++i) {
+		frame();
+	}
+	EXPECT_EQ(allocations.GetCount(), 0u);
+}
+
+// A small battle that reaches a steady state: shooters and melee units trade hits on targets too
+// healthy to die, healers top them up, and every shot lands and is destroyed before the next one.
+class GameplayAllocationTest : public ::testing::TestWithParam<int> {
+protected:
+	void SetUp() override {
+		grid = std::make_unique<SpatialGrid>(registry, 512, 512, 16);
+		gameplay = std::make_unique<GameplaySystem>(*grid);
+		if (GetParam() > 1) {
+			jobs = std::make_unique<JobSystem>(GetParam());
+			gameplay->SetJobSystem(jobs.get());
+		}
+
+		for (int row = 0; row < 40; ++row) {
+			float y = 20.0f + row * 8.0f;
+			// Projectile step is speed * Dt = 1, so shots travel exactly 5 units in 5 ticks and land
+			entt::entity archer = createUnit(Vec2(100.0f, y), 0);
+			registry.emplace<ProjectileEmitter>(archer, 1.0f, 6.0f, 1.0f, 0.0f, 10.0f, row % 4 == 0 ? 1 : 0, 2.0f);
+			registry.emplace<AttackTarget>(archer, entt::null);
+
+			entt::entity footman = createUnit(Vec2(105.0f, y), 1);
+			registry.emplace<DirectDamage>(footman, 1.0f, 6.0f, 0.5f, 0.0f);
+			registry.emplace<AttackTarget>(footman, entt::null);
+
+			entt::entity healer = createUnit(Vec2(107.0f, y), 1);
+			registry.emplace<Healer>(healer, 1.0f, 3.0f, 0.5f, 0.0f);
+		}
+	}
+
+	entt::entity createUnit(Vec2 pos, int faction) {
+		auto entity = registry.create();
+		registry.emplace<Position>(entity, Position{pos});
+		registry.emplace<Unit>(entity, UnitType::Footman, faction);
+		registry.emplace<Faction>(entity, Faction{faction});
+		registry.emplace<Movement>(entity, Vec2{0.0f, 0.0f}, pos, 0.0f);
+		registry.emplace<Health>(entity, Health{1.0e6f, 1.0e6f, 0.0f});
+		grid->Insert(entity, pos, faction);
+		return entity;
+	}
+
+	static constexpr float Dt = 0.1f;
+
+	entt::registry registry;
+	std::unique_ptr<SpatialGrid> grid;
+	std::unique_ptr<GameplaySystem> gameplay;
+	std::unique_ptr<JobSystem> jobs;
+};
+
+TEST_P(GameplayAllocationTest, SteadyStateTicksDoNotAllocate) {
+	if (!AllocationCounter::IsEnabled()) {
+		GTEST_SKIP() << "Allocation counting is not built in";
+	}
+	// Warm-up: several targeting rounds and volleys grow every pool and buffer to its peak
+	for (int tick = 0; tick < 100; ++tick) {
+		gameplay->update(registry, Dt);
+	}
+	ASSERT_GT(registry.view<StateAttackingTag>().size(), 0u);
+
+	AllocationCounter allocations;
+	for (int tick = 0; tick < 100; ++tick) {
+		gameplay->update(registry, Dt);
+	}
+	EXPECT_EQ(allocations.GetCount(), 0u);
+}
+
+INSTANTIATE_TEST_SUITE_P(ThreadCounts, GameplayAllocationTest, ::testing::Values(1, 4));
@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+#include "../src/utils/job_system.hpp"
+#include <atomic>
+#include <algorithm>
+#include <vector>
+
+class JobSystemTest : public ::testing::TestWithParam<int> {};
+
+TEST(JobSystemChunkTest, GetChunkCount_RoundsUp) {
+	EXPECT_EQ(JobSystem::GetChunkCount(0, 64), 0u);
+	EXPECT_EQ(JobSystem::GetChunkCount(1, 64), 1u);
+	EXPECT_EQ(JobSystem::GetChunkCount(64, 64), 1u);
+	EXPECT_EQ(JobSystem::GetChunkCount(65, 64), 2u);
+	EXPECT_EQ(JobSystem::GetChunkCount(10, 0), 10u); // Chunk size clamps to 1
+}
+
+TEST_P(JobSystemTest, ParallelFor_VisitsEveryIndexExactlyOnce) {
+	JobSystem jobs(GetParam());
+	std::vector<std::atomic<int>> visits(10007);
+
+	jobs.ParallelFor(visits.size(), 64, [&](size_t begin, size_t end, size_t) {
+		for (size_t i = begin; i < end; ++i) {
+			visits[i]++;
+		}
+	});
+
+	for (size_t i = 0; i < visits.size(); ++i) {
+		ASSERT_EQ(visits[i].load(), 1) << "index " << i;
+	}
+}
+
+TEST_P(JobSystemTest, ParallelFor_ChunkBoundariesIgnoreThreadCount) {
+	JobSystem jobs(GetParam());
+	const size_t count = 1000;
+	const size_t chunkSize = 96;
+	std::vector<std::pair<size_t, size_t>> ranges(JobSystem::GetChunkCount(count, chunkSize));
+
+	jobs.ParallelFor(count, chunkSize, [&](size_t begin, size_t end, size_t chunk) {
+		ranges[chunk] = {begin, end};
+	});
+
+	for (size_t chunk = 0; chunk < ranges.size(); ++chunk) {
+		EXPECT_EQ(ranges[chunk].first, chunk * chunkSize);
+		EXPECT_EQ(ranges[chunk].second, std::min(count, (chunk + 1) * chunkSize));
+	}
+}
+
+TEST_P(JobSystemTest, ParallelFor_PerChunkResultsMergeDeterministically) {
+	JobSystem jobs(GetParam());
+
+	// Many small jobs back to back, like one per gameplay pass
+	for (int round = 0; round < 200; ++round) {
+		std::vector<std::vector<int>> perChunk(JobSystem::GetChunkCount(500, 7));
+		jobs.ParallelFor(500, 7, [&](size_t begin, size_t end, size_t chunk) {
+			for (size_t i = begin; i < end; ++i) {
+				if (i % 3 == 0) perChunk[chunk].push_back(static_cast<int>(i));
+			}
+		});
+
+		std::vector<int> merged;
+		for (const auto& values : perChunk) {
+			merged.insert(merged.end(), values.begin(), values.end());
+		}
+		ASSERT_EQ(merged.size(), 167u);
+		ASSERT_TRUE(std::is_sorted(merged.begin(), merged.end()));
+	}
+}
+
+TEST_P(JobSystemTest, ParallelFor_NestedCallsRunInline) {
+	JobSystem jobs(GetParam());
+	std::atomic<int> inner{0};
+
+	jobs.ParallelFor(16, 1, [&](size_t, size_t, size_t) {
+		jobs.ParallelFor(8, 2, [&](size_t begin, size_t end, size_t) {
+			inner += static_cast<int>(end - begin);
+		});
+	});
+
+	EXPECT_EQ(inner.load(), 16 * 8);
+}
+
+TEST_P(JobSystemTest, ParallelFor_ZeroCountDoesNothing) {
+	JobSystem jobs(GetParam());
+	bool called = false;
+
+	jobs.ParallelFor(0, 16, [&](size_t, size_t, size_t) {
+		called = true;
+	});
+
+	EXPECT_FALSE(called);
+}
+
+INSTANTIATE_TEST_SUITE_P(ThreadCounts, JobSystemTest, ::testing::Values(1, 2, 4, 8));
@@ -1 +1,379 @@
+#include <gtest/gtest.h>
+#include "json_comparator.hpp"
+#include "../src/world/world.hpp"
+#include "../src/world/snapshot_file.hpp"
+#include "../src/world/snapshot_codec.hpp"
+#include "../src/utils/resource_loader.hpp"
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
 
+class PersistenceTest : public ::testing::Test {
+protected:
+	std::unique_ptr<World> createWorld() {
+		nlohmann::json config;
+		EXPECT_TRUE(ResourceLoader::load_config("data/test_config.json", config));
+		auto world = std::make_unique<World>();
+		EXPECT_TRUE(world->Initialize(config, false));
+		return world;
+	}
+
+	static nlohmann::json readJson(const std::string& path) {
+		nlohmann::json json;
+		std::ifstream file(path);
+		file >> json;
+		return json;
+	}
+
+	void TearDown() override {
+		for (const std::string& path : _files) {
+			std::filesystem::remove(path);
+		}
+	}
+
+	// Temp file removed after the test
+	std::string tempFile(const std::string& name) {
+		_files.push_back("test_output_persistence_" + name);
+		return _files.back();
+	}
+
+private:
+	std::vector<std::string> _files;
+};
+
+// Same helpers, run once per regression fixture input
+class PersistenceFixtureTest : public PersistenceTest, public ::testing::WithParamInterface<std::string> {};
+
+TEST(SaveFormatTest, PickedFromExtension) {
+	EXPECT_EQ(World::GetSaveFormat("data/saves/game.json"), World::SaveFormat::Json);
+	EXPECT_EQ(World::GetSaveFormat("data/saves/game.bin"), World::SaveFormat::Binary);
+	EXPECT_EQ(World::GetSaveFormat("data/saves/game.snap"), World::SaveFormat::Snapshot);
+	EXPECT_EQ(World::GetSaveFormat("data/saves/game.snapz"), World::SaveFormat::CompressedSnapshot);
+	EXPECT_EQ(World::GetSaveFormat("data/saves/game"), World::SaveFormat::Json);
+	EXPECT_EQ(World::GetSaveFormat("data/saves.bin/game.json"), World::SaveFormat::Json);
+}
+
+// A fixture loaded from JSON, saved as binary and loaded back must hold the same state,
+// and must simulate exactly like the world that never went through the binary file
+TEST_P(PersistenceFixtureTest, BinaryRoundTrip_MatchesJson) {
+	std::string input = GetParam() + "/input.json";
+	std::string name = std::filesystem::path(GetParam()).filename().string();
+	std::string binaryPath = tempFile(name + ".bin");
+	std::string fromJsonPath = tempFile(name + "_from_json.json");
+	std::string fromBinaryPath = tempFile(name + "_from_binary.json");
+
+	auto fromJson = createWorld();
+	ASSERT_TRUE(fromJson->LoadGame(input));
+	ASSERT_TRUE(fromJson->SaveGame(binaryPath));
+
+	auto fromBinary = createWorld();
+	ASSERT_TRUE(fromBinary->LoadGame(binaryPath));
+
+	for (int tick = 0; tick < 200; ++tick) {
+		fromJson->Update(0.01f);
+		fromBinary->Update(0.01f);
+	}
+
+	ASSERT_TRUE(fromJson->SaveGame(fromJsonPath));
+	ASSERT_TRUE(fromBinary->SaveGame(fromBinaryPath));
+
+	JsonComparator comparator;
+	EXPECT_TRUE(comparator.Compare(readJson(fromBinaryPath), readJson(fromJsonPath))) << comparator.GetLastError();
+}
+
+TEST_P(PersistenceFixtureTest, BinarySave_IsSmallerThanJson) {
+	std::string name = std::filesystem::path(GetParam()).filename().string();
+	std::string jsonPath = tempFile(name + "_size.json");
+	std::string binaryPath = tempFile(name + "_size.bin");
+
+	auto world = createWorld();
+	ASSERT_TRUE(world->LoadGame(GetParam() + "/input.json"));
+	ASSERT_TRUE(world->SaveGame(jsonPath));
+	ASSERT_TRUE(world->SaveGame(binaryPath));
+
+	EXPECT_LT(std::filesystem::file_size(binaryPath), std::filesystem::file_size(jsonPath) / 2);
+}
+
+// Units in view order: position and health
+static std::vector<float> unitState(World& world) {
+	std::vector<float> state;
+	auto view = world.GetRegistry().view<Unit, Position, Health>();
+	for (auto entity : view) {
+		const auto& pos = view.get<Position>(entity);
+		const auto& health = view.get<Health>(entity);
+		state.insert(state.end(), {pos.value.x, pos.value.y, health.current, static_cast<float>(view.get<Unit>(entity).faction)});
+	}
+	return state;
+}
+
+// The mapped snapshot restores every pool in storage order, so views iterate and simulate exactly like the saved world
+TEST_P(PersistenceFixtureTest, SnapshotRoundTrip_MatchesJson) {
+	std::string name = std::filesystem::path(GetParam()).filename().string();
+	std::string snapshotPath = tempFile(name + ".snap");
+
+	auto fromJson = createWorld();
+	ASSERT_TRUE(fromJson->LoadGame(GetParam() + "/input.json"));
+	ASSERT_TRUE(fromJson->SaveGame(snapshotPath));
+
+	auto fromSnapshot = createWorld();
+	ASSERT_TRUE(fromSnapshot->LoadGame(snapshotPath));
+	EXPECT_NE(fromSnapshot->GetCamera(), nullptr);
+	EXPECT_EQ(unitState(*fromSnapshot), unitState(*fromJson));
+
+	// Attack targets point at the same units after remapping
+	auto& jsonTargets = fromJson->GetRegistry().storage<AttackTarget>();
+	auto& snapshotTargets = fromSnapshot->GetRegistry().storage<AttackTarget>();
+	ASSERT_EQ(snapshotTargets.size(), jsonTargets.size());
+	for (size_t i = 0; i < jsonTargets.size(); ++i) {
+		entt::entity jsonTarget = jsonTargets.get(jsonTargets.data()[i]).target;
+		entt::entity snapshotTarget = snapshotTargets.get(snapshotTargets.data()[i]).target;
+		ASSERT_EQ(jsonTarget == entt::null, snapshotTarget == entt::null);
+		if (jsonTarget != entt::null) {
+			EXPECT_EQ(fromSnapshot->GetRegistry().get<Position>(snapshotTarget).value.x, fromJson->GetRegistry().get<Position>(jsonTarget).value.x);
+			EXPECT_EQ(fromSnapshot->GetRegistry().get<Position>(snapshotTarget).value.y, fromJson->GetRegistry().get<Position>(jsonTarget).value.y);
+		}
+	}
+
+	for (int tick = 0; tick < 200; ++tick) {
+		fromJson->Update(0.01f);
+		fromSnapshot->Update(0.01f);
+	}
+	EXPECT_EQ(unitState(*fromSnapshot), unitState(*fromJson));
+}
+
+// A compressed snapshot decodes to the same image, so it loads exactly like the mapped one
+TEST_P(PersistenceFixtureTest, CompressedSnapshotRoundTrip_MatchesSnapshot) {
+	std::string name = std::filesystem::path(GetParam()).filename().string();
+	std::string snapshotPath = tempFile(name + ".snap");
+	std::string compressedPath = tempFile(name + ".snapz");
+
+	auto world = createWorld();
+	ASSERT_TRUE(world->LoadGame(GetParam() + "/input.json"));
+	ASSERT_TRUE(world->SaveGame(snapshotPath));
+	ASSERT_TRUE(world->SaveGame(compressedPath));
+
+	auto fromSnapshot = createWorld();
+	auto fromCompressed = createWorld();
+	ASSERT_TRUE(fromSnapshot->LoadGame(snapshotPath));
+	ASSERT_TRUE(fromCompressed->LoadGame(compressedPath));
+	EXPECT_NE(fromCompressed->GetCamera(), nullptr);
+
+	for (int tick = 0; tick < 200; ++tick) {
+		fromSnapshot->Update(0.01f);
+		fromCompressed->Update(0.01f);
+	}
+	EXPECT_EQ(unitState(*fromCompressed), unitState(*fromSnapshot));
+}
+
+TEST_F(PersistenceTest, LoadGame_RejectsSnapshotWithDifferentSchema) {
+	std::string snapshotPath = tempFile("stale.snap");
+
+	// Same file format, but written with a shorter component list
+	auto world = createWorld();
+	world->SpawnUnit(UnitType::Footman, 0, Vec2(10.0f, 10.0f));
+	ASSERT_TRUE(SnapshotFile::Save(world->GetRegistry(), snapshotPath, entt::type_list<Position, Movement>{}));
+
+	// The running world is left alone
+	auto loaded = createWorld();
+	loaded->SpawnUnit(UnitType::Archer, 1, Vec2(20.0f, 20.0f));
+	EXPECT_FALSE(loaded->LoadGame(snapshotPath));
+	EXPECT_EQ(loaded->GetRegistry().view<Unit>().size(), 1u);
+}
+
+TEST_F(PersistenceTest, LoadGame_RejectsTruncatedSnapshot) {
+	std::string snapshotPath = tempFile("truncated.snap");
+	auto world = createWorld();
+	for (int i = 0; i < 100; ++i) {
+		world->SpawnUnit(static_cast<UnitType>(i % 4), i % 2, Vec2(10.0f + i, 10.0f));
+	}
+	ASSERT_TRUE(world->SaveGame(snapshotPath));
+	std::filesystem::resize_file(snapshotPath, std::filesystem::file_size(snapshotPath) - 64);
+
+	auto loaded = createWorld();
+	loaded->SpawnUnit(UnitType::Archer, 1, Vec2(20.0f, 20.0f));
+	EXPECT_FALSE(loaded->LoadGame(snapshotPath));
+	EXPECT_EQ(loaded->GetRegistry().view<Unit>().size(), 1u);
+}
+
+TEST_F(PersistenceTest, LoadGame_RejectsCompressedSnapshotWithDifferentSchema) {
+	std::string compressedPath = tempFile("stale.snapz");
+	auto world = createWorld();
+	world->SpawnUnit(UnitType::Footman, 0, Vec2(10.0f, 10.0f));
+	std::vector<std::byte> image, encoded;
+	SnapshotFile::Capture(world->GetRegistry(), entt::type_list<Position, Movement>{}, image);
+	ASSERT_TRUE(SnapshotCodec::Encode(image, encoded));
+	{
+		std::ofstream file(compressedPath, std::ios::binary);
+		file.write(reinterpret_cast<const char*>(encoded.data()), static_cast<std::streamsize>(encoded.size()));
+	}
+
+	auto loaded = createWorld();
+	loaded->SpawnUnit(UnitType::Archer, 1, Vec2(20.0f, 20.0f));
+	EXPECT_FALSE(loaded->LoadGame(compressedPath));
+	EXPECT_EQ(loaded->GetRegistry().view<Unit>().size(), 1u);
+}
+
+// A background save holds the world as it was when the save started, in every format,
+// even though the simulation keeps running while the file is written
+TEST_P(PersistenceFixtureTest, SaveGameAsync_MatchesSaveAtCapture) {
+	std::string name = std::filesystem::path(GetParam()).filename().string();
+
+	for (const char* extension : {".json", ".bin", ".snap"}) {
+		std::string syncPath = tempFile(name + "_sync" + extension);
+		std::string asyncPath = tempFile(name + "_async" + extension);
+
+		auto world = createWorld();
+		ASSERT_TRUE(world->LoadGame(GetParam() + "/input.json"));
+		ASSERT_TRUE(world->SaveGame(syncPath));
+		ASSERT_TRUE(world->SaveGameAsync(asyncPath)) << extension;
+		for (int tick = 0; tick < 50; ++tick) {
+			world->Update(0.01f);
+		}
+		world->WaitForSave();
+		ASSERT_EQ(world->PollSave().state, SaveStatus::State::Saved) << extension;
+		EXPECT_EQ(world->PollSave().path, asyncPath);
+
+		auto fromSync = createWorld();
+		auto fromAsync = createWorld();
+		ASSERT_TRUE(fromSync->LoadGame(syncPath)) << extension;
+		ASSERT_TRUE(fromAsync->LoadGame(asyncPath)) << extension;
+		EXPECT_NE(fromAsync->GetCamera(), nullptr);
+		EXPECT_EQ(unitState(*fromAsync), unitState(*fromSync)) << extension;
+	}
+}
+
+// Every frame of a keyframe + delta chain reconstructs the state the world had when it was written
+TEST_P(PersistenceFixtureTest, DeltaChain_ReconstructsEveryFrame) {
+	std::string name = std::filesystem::path(GetParam()).filename().string();
+	std::string keyframePath = tempFile(name + "_chain.snap");
+	tempFile(name + "_chain.snap.delta");
+
+	auto world = createWorld();
+	ASSERT_TRUE(world->LoadGame(GetParam() + "/input.json"));
+	ASSERT_TRUE(world->WriteKeyframe(keyframePath));
+
+	std::vector<std::vector<float>> frames = {unitState(*world)};
+	for (int delta = 0; delta < 10; ++delta) {
+		for (int tick = 0; tick < 20; ++tick) {
+			world->Update(0.01f);
+		}
+		ASSERT_TRUE(world->WriteDelta());
+		frames.push_back(unitState(*world));
+	}
+	ASSERT_EQ(World::GetDeltaCount(keyframePath), 10);
+
+	for (int frame = 0; frame <= 10; ++frame) {
+		auto rewound = createWorld();
+		ASSERT_TRUE(rewound->LoadFrame(keyframePath, frame)) << "frame " << frame;
+		EXPECT_EQ(unitState(*rewound), frames[frame]) << "frame " << frame;
+	}
+}
+
+// Cooldowns and other timers are not part of unitState, so a rewound frame must keep simulating like the original
+TEST_P(PersistenceFixtureTest, DeltaChain_RewoundFrameKeepsSimulating) {
+	std::string name = std::filesystem::path(GetParam()).filename().string();
+	std::string keyframePath = tempFile(name + "_resume.snap");
+	tempFile(name + "_resume.snap.delta");
+
+	auto world = createWorld();
+	ASSERT_TRUE(world->LoadGame(GetParam() + "/input.json"));
+	ASSERT_TRUE(world->WriteKeyframe(keyframePath));
+	for (int delta = 0; delta < 3; ++delta) {
+		for (int tick = 0; tick < 17; ++tick) {
+			world->Update(0.01f);
+		}
+		ASSERT_TRUE(world->WriteDelta());
+	}
+
+	auto rewound = createWorld();
+	ASSERT_TRUE(rewound->LoadFrame(keyframePath, 3));
+	for (int tick = 0; tick < 100; ++tick) {
+		world->Update(0.01f);
+		rewound->Update(0.01f);
+		ASSERT_EQ(unitState(*rewound), unitState(*world)) << "tick " << tick;
+	}
+}
+
+TEST_F(PersistenceTest, WriteDelta_OnlyRecordsChanges) {
+	std::string keyframePath = tempFile("quiet.snap");
+	std::string chainPath = tempFile("quiet.snap.delta");
+
+	auto world = createWorld();
+	std::vector<entt::entity> units;
+	for (int i = 0; i < 2000; ++i) {
+		units.push_back(world->SpawnUnit(UnitType::Footman, 0, Vec2(10.0f + i % 100, 10.0f + i / 100)));
+	}
+	EXPECT_FALSE(world->WriteDelta()); // No keyframe yet
+	ASSERT_TRUE(world->WriteKeyframe(keyframePath));
+	uintmax_t emptyChain = std::filesystem::file_size(chainPath);
+
+	// Move five units and remove one
+	for (int i = 0; i < 5; ++i) {
+		world->GetRegistry().get<Position>(units[i]).value.x += 1.0f;
+	}
+	world->GetRegistry().destroy(units[10]);
+	ASSERT_TRUE(world->WriteDelta());
+
+	uintmax_t delta = std::filesystem::file_size(chainPath) - emptyChain;
+	EXPECT_LT(delta, std::filesystem::file_size(keyframePath) / 100);
+
+	auto rewound = createWorld();
+	ASSERT_TRUE(rewound->LoadFrame(keyframePath));
+	EXPECT_EQ(unitState(*rewound), unitState(*world));
+}
+
+TEST_F(PersistenceTest, LoadFrame_RejectsABadChainBeforeClearing) {
+	std::string keyframePath = tempFile("short.snap");
+	std::string chainPath = tempFile("short.snap.delta");
+
+	auto world = createWorld();
+	world->SpawnUnit(UnitType::Footman, 0, Vec2(10.0f, 10.0f));
+	ASSERT_TRUE(world->WriteKeyframe(keyframePath));
+	ASSERT_TRUE(world->WriteDelta());
+
+	auto running = createWorld();
+	running->SpawnUnit(UnitType::Archer, 1, Vec2(20.0f, 20.0f));
+	running->SpawnUnit(UnitType::Archer, 1, Vec2(22.0f, 20.0f));
+	EXPECT_FALSE(running->LoadFrame(keyframePath, 2)); // Only one delta
+	EXPECT_EQ(running->GetRegistry().view<Unit>().size(), 2u);
+
+	std::filesystem::remove(chainPath);
+	EXPECT_FALSE(running->LoadFrame(keyframePath, 1));
+	EXPECT_EQ(running->GetRegistry().view<Unit>().size(), 2u);
+
+	// The keyframe alone needs no chain
+	EXPECT_TRUE(running->LoadFrame(keyframePath, 0));
+	EXPECT_EQ(running->GetRegistry().view<Unit>().size(), 1u);
+}
+
+TEST_F(PersistenceTest, WriteKeyframe_FailsWhenTheDirectoryCannotBeCreated) {
+	// A regular file where the save directory should be
+	std::string blocker = tempFile("not_a_directory");
+	{
+		std::ofstream file(blocker);
+		file << "x";
+	}
+
+	auto world = createWorld();
+	EXPECT_FALSE(world->WriteKeyframe(blocker + "/saves/autosave.snap"));
+	EXPECT_FALSE(world->WriteDelta());
+}
+
+TEST_F(PersistenceTest, LoadGame_RejectsTruncatedBinary) {
+	std::string binaryPath = tempFile("truncated.bin");
+	{
+		std::ofstream file(binaryPath, std::ios::binary);
+		file << "abc";
+	}
+
+	auto world = createWorld();
+	EXPECT_FALSE(world->LoadGame(binaryPath));
+}
+
+INSTANTIATE_TEST_SUITE_P(Fixtures, PersistenceFixtureTest,
+	::testing::Values("data/tests/3units", "data/tests/ballista", "data/tests/move_and_fight"),
+	[](const ::testing::TestParamInfo<std::string>& info) {
+		return std::filesystem::path(info.param).filename().string();
+	});
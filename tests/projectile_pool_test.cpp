@@ -0,0 +1,235 @@
+#include <gtest/gtest.h>
+#include "../src/world/projectile_pool.hpp"
+#include "../src/world/world.hpp"
+#include "../src/utils/resource_loader.hpp"
+#include <filesystem>
+#include <memory>
+
+static ProjectileLaunch launchAt(float x, int faction) {
+	return {Vec2(x, 0.0f), Vec2(10.0f, 0.0f), Vec2(x + 20.0f, 0.0f), 10.0f, Projectile{5.0f, faction, false, 0.0f}};
+}
+
+TEST(ProjectilePoolTest, Deactivate_MovesTheLastProjectileIntoTheSlot) {
+	ProjectilePool pool;
+	for (int i = 0; i < 3; ++i) {
+		pool.Activate(launchAt(static_cast<float>(i), i));
+	}
+	size_t capacity = pool.GetCapacity();
+
+	pool.Deactivate(0);
+	ASSERT_EQ(pool.GetCount(), 2u);
+	EXPECT_EQ(pool.GetFaction(0), 2);
+	EXPECT_EQ(pool.GetFaction(1), 1);
+
+	// Slots are reused, not released
+	pool.Activate(launchAt(5.0f, 0));
+	pool.Deactivate(2);
+	pool.Deactivate(1);
+	EXPECT_EQ(pool.GetCount(), 1u);
+	EXPECT_EQ(pool.GetCapacity(), capacity);
+}
+
+TEST(ProjectilePoolTest, Advance_ReportsProjectilesOnTheirTarget) {
+	ProjectilePool pool;
+	pool.Activate(launchAt(0.0f, 0));
+	std::vector<uint32_t> hits;
+
+	pool.Advance(1.0f, hits);
+	EXPECT_TRUE(hits.empty());
+	EXPECT_FLOAT_EQ(pool.GetPosition(0).x, 10.0f);
+
+	// Launched a second later, so still in flight when the first one lands
+	pool.Activate(launchAt(5.0f, 1));
+	pool.Advance(1.0f, hits);
+	ASSERT_EQ(hits.size(), 1u);
+	EXPECT_EQ(hits[0], 0u);
+	EXPECT_EQ(pool.GetTarget(0), pool.GetPosition(0));
+	EXPECT_FLOAT_EQ(pool.GetPosition(1).x, 15.0f);
+}
+
+TEST(ProjectilePoolTest, Advance_LongStepStopsOnTheTarget) {
+	ProjectilePool pool;
+	pool.Activate(launchAt(0.0f, 0));
+	std::vector<uint32_t> hits;
+
+	// Ten times the flight time in one step still hits, at the target rather than past it
+	pool.Advance(20.0f, hits);
+	ASSERT_EQ(hits.size(), 1u);
+	EXPECT_EQ(pool.GetPosition(0), pool.GetTarget(0));
+}
+
+TEST(ProjectilePoolTest, Deactivate_KeepsPendingImpactsWithTheirProjectile) {
+	ProjectilePool pool;
+	pool.Activate({Vec2(0.0f, 0.0f), Vec2(10.0f, 0.0f), Vec2(10.0f, 0.0f), 10.0f, Projectile{5.0f, 0, false, 0.0f}});
+	pool.Activate(launchAt(0.0f, 1));
+	pool.Activate(launchAt(0.0f, 2));
+	std::vector<uint32_t> hits;
+
+	pool.Advance(1.0f, hits);
+	ASSERT_EQ(hits.size(), 1u);
+	pool.Deactivate(hits[0]);
+
+	// The last projectile took slot 0; its impact follows it there
+	hits.clear();
+	pool.Advance(1.0f, hits);
+	ASSERT_EQ(hits.size(), 2u);
+	EXPECT_EQ(hits[0], 0u);
+	EXPECT_EQ(pool.GetFaction(0), 2);
+	EXPECT_EQ(hits[1], 1u);
+}
+
+TEST(ProjectilePoolTest, ExportThenAdopt_RestoresTheSlots) {
+	ProjectilePool pool;
+	for (int i = 0; i < 4; ++i) {
+		pool.Activate(launchAt(static_cast<float>(i), i % 2));
+	}
+	std::vector<uint32_t> hits;
+	pool.Advance(0.5f, hits);
+
+	entt::registry registry;
+	pool.ExportTo(registry);
+	EXPECT_EQ(pool.GetCount(), 0u);
+	EXPECT_EQ(registry.storage<Projectile>().size(), 4u);
+
+	pool.AdoptFrom(registry);
+	ASSERT_EQ(pool.GetCount(), 4u);
+	EXPECT_EQ(registry.storage<Projectile>().size(), 0u);
+	for (size_t i = 0; i < 4; ++i) {
+		EXPECT_EQ(pool.GetPosition(i), Vec2(i + 5.0f, 0.0f));
+		EXPECT_EQ(pool.GetFaction(i), static_cast<int>(i % 2));
+	}
+}
+
+TEST(ProjectilePoolTest, WriteThenRead_KeepsTheImpactTimes) {
+	ProjectilePool pool;
+	pool.Activate(launchAt(0.0f, 0));
+	std::vector<uint32_t> hits;
+	pool.Advance(1.0f, hits);
+	pool.Activate(launchAt(3.0f, 1));
+
+	std::vector<std::byte> section;
+	pool.Write(section);
+	ProjectilePool loaded;
+	ASSERT_TRUE(loaded.Read(section.data(), section.size()));
+	ASSERT_EQ(loaded.GetCount(), 2u);
+	EXPECT_EQ(loaded.GetPosition(0), pool.GetPosition(0));
+
+	std::vector<uint32_t> loadedHits;
+	pool.Advance(1.0f, hits);
+	loaded.Advance(1.0f, loadedHits);
+	EXPECT_EQ(loadedHits, hits);
+	EXPECT_EQ(loaded.GetPosition(1), pool.GetPosition(1));
+
+	// A truncated section leaves the pool empty
+	EXPECT_FALSE(loaded.Read(section.data(), section.size() - 1));
+	EXPECT_EQ(loaded.GetCount(), 0u);
+}
+
+class PooledWorldTest : public ::testing::Test {
+protected:
+	std::unique_ptr<World> createWorld(bool pooled) {
+		nlohmann::json config;
+		EXPECT_TRUE(ResourceLoader::load_config("data/test_config.json", config));
+		config["global"]["projectile_pool"] = pooled;
+		auto world = std::make_unique<World>();
+		EXPECT_TRUE(world->Initialize(config, false));
+
+		// Archers and a ballista shooting at a footman line
+		for (int i = 0; i < 3; ++i) {
+			world->SpawnUnit(UnitType::Archer, 0, Vec2(100.0f, 100.0f + i * 2.0f));
+			world->SpawnUnit(UnitType::Footman, 1, Vec2(112.0f, 100.0f + i * 2.0f));
+		}
+		world->SpawnUnit(UnitType::Ballista, 0, Vec2(95.0f, 102.0f));
+		return world;
+	}
+};
+
+TEST_F(PooledWorldTest, Pool_DealsTheSameDamageAsProjectileEntities) {
+	auto entities = createWorld(false);
+	auto pooled = createWorld(true);
+
+	bool fired = false;
+	for (int tick = 0; tick < 600; ++tick) {
+		entities->Update(0.01f);
+		pooled->Update(0.01f);
+
+		EXPECT_EQ(pooled->GetRegistry().storage<Projectile>().size(), 0u);
+		UnitCountData expected = entities->GetUnitCounts();
+		UnitCountData actual = pooled->GetUnitCounts();
+		ASSERT_EQ(actual.projectileCount, expected.projectileCount) << "tick " << tick;
+		fired = fired || actual.projectileCount > 0;
+
+		auto view = entities->GetRegistry().view<Health>();
+		for (auto entity : view) {
+			ASSERT_TRUE(pooled->GetRegistry().valid(entity));
+			ASSERT_FLOAT_EQ(pooled->GetRegistry().get<Health>(entity).current, view.get<Health>(entity).current) << "tick " << tick;
+		}
+	}
+	EXPECT_TRUE(fired);
+}
+
+// Saving leaves the world alone, and every format brings the pool back with the same impact ticks
+TEST_F(PooledWorldTest, SaveAndLoad_KeepsPooledProjectilesInFlight) {
+	for (const char* extension : {".snap", ".snapz", ".bin", ".json"}) {
+		auto world = createWorld(true);
+		auto unsaved = createWorld(true);
+		ProjectilePool& pool = world->GetGameplaySystem().GetProjectilePool();
+		for (int tick = 0; tick < 600 && pool.GetCount() == 0; ++tick) {
+			world->Update(0.01f);
+			unsaved->Update(0.01f);
+		}
+		ASSERT_GT(pool.GetCount(), 0u);
+
+		std::string path = (std::filesystem::temp_directory_path() / (std::string("rts_pooled_projectiles") + extension)).string();
+		ASSERT_TRUE(world->SaveGame(path)) << extension;
+		EXPECT_EQ(world->GetRegistry().storage<Projectile>().size(), 0u);
+
+		auto loaded = createWorld(true);
+		ASSERT_TRUE(loaded->LoadGame(path)) << extension;
+		const ProjectilePool& loadedPool = loaded->GetGameplaySystem().GetProjectilePool();
+		ASSERT_EQ(loadedPool.GetCount(), pool.GetCount()) << extension;
+		for (size_t i = 0; i < pool.GetCount(); ++i) {
+			EXPECT_EQ(loadedPool.GetPosition(i), pool.GetPosition(i));
+			EXPECT_EQ(loadedPool.GetVelocity(i), pool.GetVelocity(i));
+		}
+
+		for (int tick = 0; tick < 300; ++tick) {
+			world->Update(0.01f);
+			unsaved->Update(0.01f);
+			loaded->Update(0.01f);
+			ASSERT_EQ(loadedPool.GetCount(), pool.GetCount()) << extension << " tick " << tick;
+			ASSERT_EQ(unsaved->GetGameplaySystem().GetProjectilePool().GetCount(), pool.GetCount()) << extension << " tick " << tick;
+		}
+
+		// No entities were created or destroyed to write the save
+		EXPECT_EQ(world->SpawnUnit(UnitType::Footman, 1, Vec2(50.0f, 50.0f)), unsaved->SpawnUnit(UnitType::Footman, 1, Vec2(50.0f, 50.0f)));
+		std::filesystem::remove(path);
+	}
+}
+
+TEST_F(PooledWorldTest, DeltaChain_KeepsPooledProjectilesInFlight) {
+	auto world = createWorld(true);
+	ProjectilePool& pool = world->GetGameplaySystem().GetProjectilePool();
+	for (int tick = 0; tick < 600 && pool.GetCount() == 0; ++tick) {
+		world->Update(0.01f);
+	}
+	ASSERT_GT(pool.GetCount(), 0u);
+
+	std::string path = (std::filesystem::temp_directory_path() / "rts_pooled_projectiles_chain.snap").string();
+	ASSERT_TRUE(world->WriteKeyframe(path));
+	for (int tick = 0; tick < 50; ++tick) {
+		world->Update(0.01f);
+	}
+	ASSERT_TRUE(world->WriteDelta());
+
+	auto loaded = createWorld(true);
+	ASSERT_TRUE(loaded->LoadFrame(path));
+	const ProjectilePool& loadedPool = loaded->GetGameplaySystem().GetProjectilePool();
+	for (int tick = 0; tick < 300; ++tick) {
+		ASSERT_EQ(loadedPool.GetCount(), pool.GetCount()) << "tick " << tick;
+		world->Update(0.01f);
+		loaded->Update(0.01f);
+	}
+	std::filesystem::remove(path);
+	std::filesystem::remove(path + ".delta");
+}
@@ -9,6 +9,8 @@
 RegressionTestRunner::RegressionTestRunner(const std::string& testDir)
 	: _testDir(testDir)
 	, _testRun(false)
+	, _generateMode(false)
+	, _workerThreads(0)
 {
 }
 
@@ -64,6 +66,9 @@ bool RegressionTestRunner::RunTest() {
 	if (!loadWorldConfig(worldConfig)) {
 		return false;
 	}
+	if (_workerThreads > 0) {
+		worldConfig["global"]["worker_threads"] = _workerThreads;
+	}
 	
 	// Create and initialize world
 	World world;
@@ -85,7 +90,7 @@ bool RegressionTestRunner::RunTest() {
 	}
 	
 	// Determine output path
-	if (IsGenerateMode()) {
+	if (IsGenerateMode() && _workerThreads <= 0) {
 		// In generate mode, save to expected file location
 		_outputPath = _testDir + "/" + _params.expectedFile;
 	} else {
@@ -93,6 +98,9 @@ bool RegressionTestRunner::RunTest() {
 		// Use a unique temp filename based on test directory name
 		std::filesystem::path testPath(_testDir);
 		std::string testName = testPath.filename().string();
+		if (_workerThreads > 0) {
+			testName += "_threads" + std::to_string(_workerThreads);
+		}
 		_outputPath = "test_output_" + testName + ".json";
 	}
 	
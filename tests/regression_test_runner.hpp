@@ -29,6 +29,10 @@ public:
 	
 	// Check if we're in generation mode
 	bool IsGenerateMode();
+
+	// Override "global.worker_threads" from test_config.json (<= 0 keeps the config value).
+	// Runs with an override never write expected files, they only compare against them.
+	void SetWorkerThreads(int threads) { _workerThreads = threads; }
 	
 	// Get last error message
 	const std::string& GetLastError() const { return _lastError; }
@@ -40,6 +44,7 @@ private:
 	std::string _lastError;
 	std::string _outputPath;
 	bool _generateMode;
+	int _workerThreads;
 	
 	bool loadWorldConfig(nlohmann::json& config);
 };
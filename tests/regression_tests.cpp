@@ -38,6 +38,24 @@ TEST_P(RegressionTest, RunRegressionTest) {
 	}
 }
 
+// Same scenarios with gameplay spread over several worker threads - must match the same expected.json
+TEST_P(RegressionTest, RunRegressionTestMultithreaded) {
+	const std::string& testDir = GetParam();
+	RegressionTestRunner runner(testDir);
+	runner.SetWorkerThreads(4);
+
+	ASSERT_TRUE(runner.LoadTestConfig())
+		<< "Failed to load test config for " << testDir << ": " << runner.GetLastError();
+	ASSERT_TRUE(runner.RunTest())
+		<< "Failed to run test for " << testDir << ": " << runner.GetLastError();
+
+	if (runner.IsGenerateMode()) {
+		GTEST_SKIP() << "Expected files are generated by the single-threaded run";
+	}
+	ASSERT_TRUE(runner.CompareResults())
+		<< "Multithreaded test failed for " << testDir << ": " << runner.GetLastError();
+}
+
 // Helper function to discover test directories
 std::vector<std::string> DiscoverTestDirectories(const std::string& baseDir) {
 	std::vector<std::string> testDirs;
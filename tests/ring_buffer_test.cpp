@@ -0,0 +1,237 @@
+#include <gtest/gtest.h>
+#include "utils/ring_buffer.hpp"
+#include "fake_gpu_buffer_backend.hpp"
+#include <cstdint>
+
+class RingBufferTest : public ::testing::Test {
+protected:
+	static constexpr size_t SegmentSize = 1024;
+};
+
+// ============================================================================
+// Allocation Tests
+// ============================================================================
+
+TEST_F(RingBufferTest, Allocate_FailsOutsideFrame) {
+	FakeGpuBufferBackend backend;
+	RingBuffer ring(backend, SegmentSize);
+
+	auto allocation = ring.Allocate(16);
+
+	EXPECT_FALSE(allocation.IsValid());
+}
+
+TEST_F(RingBufferTest, Allocate_IsSequentialAndAligned) {
+	FakeGpuBufferBackend backend;
+	RingBuffer ring(backend, SegmentSize);
+
+	ring.BeginFrame();
+	auto a = ring.Allocate(10, 16);
+	auto b = ring.Allocate(20, 16);
+	auto c = ring.Allocate(4, 4);
+	ring.EndFrame();
+
+	ASSERT_TRUE(a.IsValid());
+	ASSERT_TRUE(b.IsValid());
+	ASSERT_TRUE(c.IsValid());
+	EXPECT_EQ(a.offset, 0u);
+	EXPECT_EQ(b.offset, 16u);
+	EXPECT_EQ(c.offset, 36u);
+	EXPECT_EQ(reinterpret_cast<uintptr_t>(b.data) - reinterpret_cast<uintptr_t>(a.data), 16u);
+}
+
+TEST_F(RingBufferTest, Allocate_FailsWhenSegmentIsFull) {
+	FakeGpuBufferBackend backend;
+	RingBuffer ring(backend, SegmentSize);
+
+	ring.BeginFrame();
+	auto a = ring.Allocate(SegmentSize - 16);
+	auto b = ring.Allocate(32);
+	auto c = ring.Allocate(16);
+	ring.EndFrame();
+
+	EXPECT_TRUE(a.IsValid());
+	EXPECT_FALSE(b.IsValid());
+	EXPECT_TRUE(c.IsValid());
+}
+
+TEST_F(RingBufferTest, GetAvailable_ReportsRemainingBytes) {
+	FakeGpuBufferBackend backend;
+	RingBuffer ring(backend, SegmentSize);
+
+	EXPECT_EQ(ring.GetAvailable(), 0u);
+
+	ring.BeginFrame();
+	EXPECT_EQ(ring.GetAvailable(), SegmentSize);
+	ring.Allocate(100, 4);
+	EXPECT_EQ(ring.GetAvailable(4), SegmentSize - 100);
+	EXPECT_EQ(ring.GetAvailable(16), SegmentSize - 112);
+	ring.EndFrame();
+}
+
+// ============================================================================
+// Segment Rotation / Fence Tests
+// ============================================================================
+
+TEST_F(RingBufferTest, Frames_RotateThroughSegments) {
+	FakeGpuBufferBackend backend;
+	RingBuffer ring(backend, SegmentSize);
+
+	for (int frame = 0; frame < 6; ++frame) {
+		ring.BeginFrame();
+		auto allocation = ring.Allocate(8);
+		ring.EndFrame();
+
+		ASSERT_TRUE(allocation.IsValid());
+		EXPECT_EQ(ring.GetCurrentSegment(), frame % 3);
+		EXPECT_EQ(allocation.offset, static_cast<size_t>(frame % 3) * SegmentSize);
+	}
+}
+
+TEST_F(RingBufferTest, BeginFrame_WaitsOnlyForSegmentBeingReused) {
+	FakeGpuBufferBackend backend;
+	RingBuffer ring(backend, SegmentSize);
+
+	// First lap: no segment has been used yet, so nothing to wait for
+	for (int frame = 0; frame < 3; ++frame) {
+		ring.BeginFrame();
+		ring.EndFrame();
+	}
+	EXPECT_TRUE(backend.GetWaitedFences().empty());
+
+	// Frame 3 reuses segment 0 and must wait for frame 0's fence only
+	ring.BeginFrame();
+	ring.EndFrame();
+	ASSERT_EQ(backend.GetWaitedFences().size(), 1u);
+	EXPECT_EQ(backend.GetWaitedFences()[0], 1u);
+}
+
+TEST_F(RingBufferTest, BeginFrame_NoStallWhenGpuKeepsUp) {
+	FakeGpuBufferBackend backend;
+	RingBuffer ring(backend, SegmentSize);
+
+	for (int frame = 0; frame < 10; ++frame) {
+		ring.BeginFrame();
+		ring.Allocate(64);
+		ring.EndFrame();
+
+		// GPU is one frame behind the CPU
+		if (backend.GetLastFence() > 1) {
+			backend.SignalUpTo(backend.GetLastFence() - 1);
+		}
+	}
+
+	EXPECT_EQ(backend.GetStallCount(), 0);
+}
+
+TEST_F(RingBufferTest, BeginFrame_StallsWhenGpuFallsBehind) {
+	FakeGpuBufferBackend backend;
+	RingBuffer ring(backend, SegmentSize);
+
+	// GPU never signals - the 4th frame has to wait for the 1st
+	for (int frame = 0; frame < 4; ++frame) {
+		ring.BeginFrame();
+		ring.EndFrame();
+	}
+
+	EXPECT_EQ(backend.GetStallCount(), 1);
+}
+
+// ============================================================================
+// Mapping / Growth Tests
+// ============================================================================
+
+TEST_F(RingBufferTest, PersistentBackend_NeverUnmaps) {
+	FakeGpuBufferBackend backend(true);
+	RingBuffer ring(backend, SegmentSize);
+
+	for (int frame = 0; frame < 3; ++frame) {
+		ring.BeginFrame();
+		ring.EndFrame();
+	}
+
+	EXPECT_EQ(backend.GetUnmapCount(), 0);
+}
+
+TEST_F(RingBufferTest, NonPersistentBackend_MapsAndUnmapsEachFrame) {
+	FakeGpuBufferBackend backend(false);
+	RingBuffer ring(backend, SegmentSize);
+
+	for (int frame = 0; frame < 3; ++frame) {
+		ring.BeginFrame();
+		EXPECT_TRUE(backend.IsMapped());
+		ring.EndFrame();
+		EXPECT_FALSE(backend.IsMapped());
+	}
+
+	EXPECT_EQ(backend.GetMapCount(), 3);
+	EXPECT_EQ(backend.GetUnmapCount(), 3);
+}
+
+TEST_F(RingBufferTest, NonPersistentBackend_DrawsAndFencesOnlyUnmapped) {
+	FakeGpuBufferBackend backend(false);
+	RingBuffer ring(backend, SegmentSize);
+
+	for (int frame = 0; frame < 3; ++frame) {
+		ring.BeginFrame();
+		EXPECT_TRUE(ring.Allocate(64).IsValid());
+		ring.FinishWrites();
+		EXPECT_FALSE(backend.IsMapped());
+		EXPECT_FALSE(ring.Allocate(64).IsValid());
+		backend.Draw();
+		ring.EndFrame();
+	}
+
+	EXPECT_EQ(backend.GetMappedUseCount(), 0);
+	EXPECT_EQ(backend.GetUnmapCount(), 3);
+	EXPECT_EQ(backend.GetLastFence(), 3u);
+}
+
+TEST_F(RingBufferTest, EndFrame_UnmapsBeforeTheFence) {
+	FakeGpuBufferBackend backend(false);
+	RingBuffer ring(backend, SegmentSize);
+
+	ring.BeginFrame();
+	ring.Allocate(64);
+	ring.EndFrame();
+
+	EXPECT_EQ(backend.GetMappedUseCount(), 0);
+	EXPECT_EQ(backend.GetUnmapCount(), 1);
+}
+
+TEST_F(RingBufferTest, Overflow_GrowsSegmentOnNextFrame) {
+	FakeGpuBufferBackend backend;
+	RingBuffer ring(backend, SegmentSize);
+
+	ring.BeginFrame();
+	auto tooBig = ring.Allocate(SegmentSize * 3);
+	ring.EndFrame();
+	EXPECT_FALSE(tooBig.IsValid());
+
+	ring.BeginFrame();
+	auto fits = ring.Allocate(SegmentSize * 3);
+	ring.EndFrame();
+
+	EXPECT_TRUE(fits.IsValid());
+	EXPECT_GE(ring.GetSegmentSize(), SegmentSize * 3);
+	EXPECT_EQ(backend.GetSize(), ring.GetSegmentSize() * ring.GetSegmentCount());
+	EXPECT_EQ(backend.GetCreateCount(), 2);
+}
+
+TEST_F(RingBufferTest, WrittenData_LandsInBackendMemory) {
+	FakeGpuBufferBackend backend;
+	RingBuffer ring(backend, SegmentSize);
+
+	ring.BeginFrame();
+	ring.BeginFrame(); // Nested begin is ignored
+	auto allocation = ring.Allocate(sizeof(float) * 4, alignof(float));
+	ASSERT_TRUE(allocation.IsValid());
+	float* values = static_cast<float*>(allocation.data);
+	for (int i = 0; i < 4; ++i) {
+		values[i] = static_cast<float>(i);
+	}
+	ring.EndFrame();
+
+	EXPECT_EQ(ring.GetCurrentSegment(), 0);
+	EXPECT_FLOAT_EQ(values[3], 3.0f);
+}
@@ -0,0 +1,56 @@
+#include <gtest/gtest.h>
+#include "../src/world/world.hpp"
+#include "../src/utils/resource_loader.hpp"
+#include <memory>
+
+class RunUntilResolvedTest : public ::testing::Test {
+protected:
+	void SetUp() override {
+		nlohmann::json config;
+		ASSERT_TRUE(ResourceLoader::load_config("data/test_config.json", config));
+		world = std::make_unique<World>();
+		ASSERT_TRUE(world->Initialize(config, false));
+	}
+
+	std::unique_ptr<World> world;
+};
+
+TEST_F(RunUntilResolvedTest, OneFactionLeft_StopsBeforeTheFirstTick) {
+	world->SpawnUnit(UnitType::Footman, 1, Vec2(10.0f, 10.0f));
+	world->SpawnUnit(UnitType::Archer, 1, Vec2(12.0f, 10.0f));
+
+	BattleResult result = world->RunUntilResolved(0.01f, 100);
+	EXPECT_EQ(result.ticks, 0);
+	EXPECT_TRUE(result.resolved);
+	EXPECT_EQ(result.winner, 1);
+	EXPECT_EQ(result.aliveCount[1], 2);
+}
+
+TEST_F(RunUntilResolvedTest, Melee_RunsUntilTheOutnumberedSideDies) {
+	world->SpawnUnit(UnitType::Footman, 0, Vec2(100.0f, 100.0f));
+	world->SpawnUnit(UnitType::Footman, 0, Vec2(100.0f, 102.0f));
+	world->SpawnUnit(UnitType::Footman, 1, Vec2(102.0f, 101.0f));
+
+	BattleResult result = world->RunUntilResolved(0.01f, 10000);
+	EXPECT_TRUE(result.resolved);
+	EXPECT_EQ(result.winner, 0);
+	EXPECT_GT(result.ticks, 0);
+	EXPECT_LT(result.ticks, 10000);
+	EXPECT_EQ(result.aliveCount[1], 0);
+	EXPECT_GE(result.aliveCount[0], 1);
+
+	// Resolved worlds stay resolved
+	EXPECT_EQ(world->RunUntilResolved(0.01f, 100).ticks, 0);
+}
+
+TEST_F(RunUntilResolvedTest, TickLimit_LeavesTheBattleUnresolved) {
+	world->SpawnUnit(UnitType::Footman, 0, Vec2(50.0f, 50.0f));
+	world->SpawnUnit(UnitType::Footman, 1, Vec2(450.0f, 450.0f));
+
+	BattleResult result = world->RunUntilResolved(0.01f, 50);
+	EXPECT_EQ(result.ticks, 50);
+	EXPECT_FALSE(result.resolved);
+	EXPECT_EQ(result.winner, -1);
+	EXPECT_EQ(result.aliveCount[0], 1);
+	EXPECT_EQ(result.aliveCount[1], 1);
+}
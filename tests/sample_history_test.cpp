@@ -0,0 +1,44 @@
+#include <gtest/gtest.h>
+#include "../src/utils/sample_history.hpp"
+
+TEST(SampleHistoryTest, Empty) {
+	SampleHistory history(4);
+	EXPECT_EQ(history.GetCount(), 0);
+	EXPECT_EQ(history.GetMaxIndex(), -1);
+	EXPECT_FLOAT_EQ(history.GetLatest(), 0.0f);
+	EXPECT_FLOAT_EQ(history.GetAverage(), 0.0f);
+}
+
+TEST(SampleHistoryTest, KeepsTheLatestSamplesInAgeOrder) {
+	SampleHistory history(4);
+	for (int i = 1; i <= 6; ++i) {
+		history.Push(static_cast<float>(i));
+	}
+
+	// 1 and 2 were overwritten
+	ASSERT_EQ(history.GetCount(), 4);
+	for (int i = 0; i < 4; ++i) {
+		EXPECT_FLOAT_EQ(history.Get(i), static_cast<float>(i + 3));
+	}
+	EXPECT_FLOAT_EQ(history.GetLatest(), 6.0f);
+	EXPECT_FLOAT_EQ(history.GetAverage(), 4.5f);
+
+	// Ring storage read from the offset gives the same order (ImGui::PlotLines layout)
+	for (int i = 0; i < 4; ++i) {
+		EXPECT_FLOAT_EQ(history.GetData()[(history.GetOffset() + i) % history.GetCapacity()], history.Get(i));
+	}
+}
+
+TEST(SampleHistoryTest, MaxIndexFollowsTheSpike) {
+	SampleHistory history(8);
+	for (float value : {1.0f, 2.0f, 9.0f, 3.0f}) {
+		history.Push(value);
+	}
+	EXPECT_EQ(history.GetMaxIndex(), 2);
+	EXPECT_FLOAT_EQ(history.GetMax(), 9.0f);
+
+	history.Clear();
+	history.Push(5.0f);
+	EXPECT_EQ(history.GetCount(), 1);
+	EXPECT_FLOAT_EQ(history.GetMax(), 5.0f);
+}
@@ -0,0 +1,148 @@
+#include <gtest/gtest.h>
+#include "../src/world/simd_distance.hpp"
+#include "../src/utils/vec2.hpp"
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+// Compares every vector level against the scalar kernel on the same inputs
+class SimdDistanceTest : public ::testing::TestWithParam<SimdDistance::Level> {
+protected:
+	void SetUp() override {
+		if (!SimdDistance::IsSupported(GetParam())) {
+			GTEST_SKIP() << SimdDistance::GetLevelName(GetParam()) << " not supported on this CPU";
+		}
+	}
+
+	// Coarse coordinates so equal distances (ties) are common
+	void makeCandidates(std::mt19937& rng, uint32_t count) {
+		std::uniform_int_distribution<int> coord(0, 40);
+		xs.resize(count);
+		ys.resize(count);
+		for (uint32_t i = 0; i < count; ++i) {
+			xs[i] = coord(rng) * 0.5f;
+			ys[i] = coord(rng) * 0.25f + 0.1f;
+		}
+	}
+
+	static bool sameBits(float a, float b) {
+		return std::memcmp(&a, &b, sizeof(float)) == 0;
+	}
+
+	std::vector<float> xs;
+	std::vector<float> ys;
+};
+
+TEST_P(SimdDistanceTest, FindNearest_MatchesScalarBitForBit) {
+	std::mt19937 rng(1234);
+	std::uniform_int_distribution<int> coord(0, 40);
+
+	for (int trial = 0; trial < 2000; ++trial) {
+		// Cover empty spans, partial vectors and scalar tails
+		makeCandidates(rng, static_cast<uint32_t>(trial % 70));
+		float px = coord(rng) * 0.5f;
+		float py = coord(rng) * 0.3f;
+		float start = (trial % 3 == 0) ? 1.0e30f : static_cast<float>(coord(rng));
+
+		float scalarBest = start;
+		int scalarIndex = SimdDistance::FindNearest(SimdDistance::Level::Scalar, xs.data(), ys.data(),
+			static_cast<uint32_t>(xs.size()), px, py, scalarBest);
+
+		float best = start;
+		int index = SimdDistance::FindNearest(GetParam(), xs.data(), ys.data(),
+			static_cast<uint32_t>(xs.size()), px, py, best);
+
+		ASSERT_EQ(index, scalarIndex) << "trial " << trial;
+		ASSERT_TRUE(sameBits(best, scalarBest)) << "trial " << trial;
+	}
+}
+
+TEST_P(SimdDistanceTest, FindNearest_PrefersFirstOfEqualCandidates) {
+	// Same distance in lanes 2, 5 and the scalar tail
+	xs = {9.0f, 9.0f, 3.0f, 9.0f, 9.0f, -3.0f, 9.0f, 9.0f, 9.0f, 0.0f};
+	ys = {9.0f, 9.0f, 0.0f, 9.0f, 9.0f, 0.0f, 9.0f, 9.0f, 9.0f, 3.0f};
+
+	float best = 100.0f;
+	int index = SimdDistance::FindNearest(GetParam(), xs.data(), ys.data(),
+		static_cast<uint32_t>(xs.size()), 0.0f, 0.0f, best);
+
+	EXPECT_EQ(index, 2);
+	EXPECT_FLOAT_EQ(best, 9.0f);
+}
+
+TEST_P(SimdDistanceTest, FindNearest_ReturnsMinusOneWhenNothingBeatsBest) {
+	xs = {5.0f, 6.0f, 7.0f, 8.0f, 9.0f};
+	ys = {0.0f, 0.0f, 0.0f, 0.0f, 0.0f};
+
+	// Exactly at the incoming best is not an improvement
+	float best = 25.0f;
+	int index = SimdDistance::FindNearest(GetParam(), xs.data(), ys.data(),
+		static_cast<uint32_t>(xs.size()), 0.0f, 0.0f, best);
+
+	EXPECT_EQ(index, -1);
+	EXPECT_FLOAT_EQ(best, 25.0f);
+}
+
+TEST_P(SimdDistanceTest, FilterInRadius_MatchesScalarBitForBit) {
+	std::mt19937 rng(99);
+	std::uniform_int_distribution<int> coord(0, 40);
+	uint32_t scalarIndices[SimdDistance::ChunkSize];
+	float scalarDists[SimdDistance::ChunkSize];
+	uint32_t indices[SimdDistance::ChunkSize];
+	float dists[SimdDistance::ChunkSize];
+
+	for (int trial = 0; trial < 2000; ++trial) {
+		makeCandidates(rng, static_cast<uint32_t>(trial % SimdDistance::ChunkSize));
+		float px = coord(rng) * 0.5f;
+		float py = coord(rng) * 0.3f;
+		float radiusSq = static_cast<float>(coord(rng) * 3);
+		uint32_t count = static_cast<uint32_t>(xs.size());
+
+		uint32_t scalarHits = SimdDistance::FilterInRadius(SimdDistance::Level::Scalar, xs.data(), ys.data(),
+			count, px, py, radiusSq, scalarIndices, scalarDists);
+		uint32_t hits = SimdDistance::FilterInRadius(GetParam(), xs.data(), ys.data(),
+			count, px, py, radiusSq, indices, dists);
+
+		ASSERT_EQ(hits, scalarHits) << "trial " << trial;
+		for (uint32_t h = 0; h < hits; ++h) {
+			ASSERT_EQ(indices[h], scalarIndices[h]) << "trial " << trial;
+			ASSERT_TRUE(sameBits(dists[h], scalarDists[h])) << "trial " << trial;
+		}
+	}
+}
+
+TEST_P(SimdDistanceTest, FilterInRadius_MatchesVec2DistanceSquared) {
+	xs = {1.5f, -2.25f, 3.0f, 0.1f, 7.0f, 2.0f, -1.0f, 0.3f, 4.4f, 1.0f, 2.5f};
+	ys = {0.5f, 1.75f, -4.0f, 0.2f, 1.0f, 2.0f, -1.0f, 0.7f, 0.1f, 3.0f, -2.5f};
+	Vec2 pos(0.37f, -0.21f);
+	uint32_t indices[SimdDistance::ChunkSize];
+	float dists[SimdDistance::ChunkSize];
+
+	uint32_t hits = SimdDistance::FilterInRadius(GetParam(), xs.data(), ys.data(),
+		static_cast<uint32_t>(xs.size()), pos.x, pos.y, 1.0e9f, indices, dists);
+
+	ASSERT_EQ(hits, xs.size());
+	for (uint32_t h = 0; h < hits; ++h) {
+		float expected = Vec2::distance_squared(pos, Vec2(xs[h], ys[h]));
+		EXPECT_TRUE(sameBits(dists[h], expected)) << "candidate " << h;
+	}
+}
+
+INSTANTIATE_TEST_SUITE_P(Levels, SimdDistanceTest,
+	::testing::Values(SimdDistance::Level::Scalar, SimdDistance::Level::SSE2, SimdDistance::Level::AVX2),
+	[](const ::testing::TestParamInfo<SimdDistance::Level>& info) {
+		return std::string(SimdDistance::GetLevelName(info.param));
+	});
+
+TEST(SimdDistanceDispatchTest, SetLevel_ClampsToSupportedLevel) {
+	SimdDistance::Level original = SimdDistance::GetLevel();
+
+	EXPECT_EQ(SimdDistance::SetLevel(SimdDistance::Level::Scalar), SimdDistance::Level::Scalar);
+	EXPECT_EQ(SimdDistance::GetLevel(), SimdDistance::Level::Scalar);
+
+	SimdDistance::Level applied = SimdDistance::SetLevel(SimdDistance::Level::AVX2);
+	EXPECT_TRUE(SimdDistance::IsSupported(applied));
+
+	SimdDistance::SetLevel(original);
+}
@@ -0,0 +1,54 @@
+#include <gtest/gtest.h>
+#include "../src/world/snapshot_codec.hpp"
+#include "../src/world/snapshot_file.hpp"
+#include "../src/world/world.hpp"
+#include "../src/utils/resource_loader.hpp"
+#include <memory>
+#include <vector>
+
+// Image of a world with two armies of identical stats, like a generated battle
+static std::vector<std::byte> battleImage(int unitCount) {
+	nlohmann::json config;
+	EXPECT_TRUE(ResourceLoader::load_config("data/test_config.json", config));
+	auto world = std::make_unique<World>();
+	EXPECT_TRUE(world->Initialize(config, false));
+	for (int i = 0; i < unitCount; ++i) {
+		int faction = i % 2;
+		world->SpawnUnit(static_cast<UnitType>(i % 4), faction, Vec2(faction * 256.0f + (i / 2) % 250, (i / 500) % 500 + 0.37f * (i % 3)));
+	}
+
+	std::vector<std::byte> image;
+	SnapshotFile::Capture(world->GetRegistry(), World::PersistedComponents{}, image);
+	return image;
+}
+
+TEST(SnapshotCodecTest, RoundTrip_IsBitIdentical) {
+	std::vector<std::byte> image = battleImage(5000);
+	std::vector<std::byte> encoded;
+	ASSERT_TRUE(SnapshotCodec::Encode(image, encoded));
+
+	std::vector<std::byte> decoded;
+	ASSERT_TRUE(SnapshotCodec::Decode(encoded.data(), encoded.size(), decoded, "memory"));
+	EXPECT_EQ(decoded, image);
+}
+
+TEST(SnapshotCodecTest, RepeatedStats_CompressWell) {
+	std::vector<std::byte> image = battleImage(20000);
+	std::vector<std::byte> encoded;
+	ASSERT_TRUE(SnapshotCodec::Encode(image, encoded));
+	EXPECT_LT(encoded.size() * 4, image.size());
+}
+
+TEST(SnapshotCodecTest, Decode_RejectsTruncatedAndForeignData) {
+	std::vector<std::byte> image = battleImage(1000);
+	std::vector<std::byte> encoded;
+	ASSERT_TRUE(SnapshotCodec::Encode(image, encoded));
+
+	std::vector<std::byte> decoded;
+	for (size_t cut : {size_t(1), size_t(64), encoded.size() / 2, encoded.size() - 1}) {
+		EXPECT_FALSE(SnapshotCodec::Decode(encoded.data(), encoded.size() - cut, decoded, "truncated")) << "cut " << cut;
+	}
+
+	// An uncompressed image is not a compressed one
+	EXPECT_FALSE(SnapshotCodec::Decode(image.data(), image.size(), decoded, "image"));
+}
@@ -0,0 +1,195 @@
+#include <gtest/gtest.h>
+#include "../src/world/spatial_grid.hpp"
+#include "../src/components/components.hpp"
+#include "../src/utils/vec2.hpp"
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+// Runs the same world through a linked-list grid and a packed grid and compares query results
+class SpatialGridBackendTest : public ::testing::Test {
+protected:
+	void SetUp() override {
+		linkedGrid = std::make_unique<SpatialGrid>(linkedRegistry, 1000, 1000, 50);
+		packedGrid = std::make_unique<SpatialGrid>(packedRegistry, 1000, 1000, 50);
+		packedGrid->SetBackend(GridBackend::Packed);
+	}
+
+	// Create the same entity in both registries; ids match because both registries see the same sequence
+	entt::entity createEntity(Vec2 pos, int faction = 0) {
+		auto linked = createIn(linkedRegistry, *linkedGrid, pos, faction);
+		auto packed = createIn(packedRegistry, *packedGrid, pos, faction);
+		EXPECT_EQ(linked, packed);
+		return linked;
+	}
+
+	void populate(int count) {
+		for (int i = 0; i < count; ++i) {
+			float x = static_cast<float>((i * 37) % 1000);
+			float y = static_cast<float>((i * 91) % 1000);
+			createEntity(Vec2(x, y), i % MAX_FACTIONS);
+		}
+	}
+
+	// Move an entity in both worlds the way the movement system does
+	void moveEntity(entt::entity entity, Vec2 newPos) {
+		moveIn(linkedRegistry, *linkedGrid, entity, newPos);
+		moveIn(packedRegistry, *packedGrid, entity, newPos);
+	}
+
+	std::vector<entt::entity> radius(SpatialGrid& grid, Vec2 pos, float r, int faction, bool same) {
+		std::vector<entt::entity> result;
+		grid.VisitRadius(pos, r, [&](entt::entity e) {
+			result.push_back(e);
+		}, faction, same);
+		return result;
+	}
+
+	std::vector<entt::entity> rect(SpatialGrid& grid, Vec2 min, Vec2 max) {
+		std::vector<entt::entity> result;
+		grid.VisitRect(min, max, [&](entt::entity e) {
+			result.push_back(e);
+		});
+		return result;
+	}
+
+	entt::registry linkedRegistry;
+	entt::registry packedRegistry;
+	std::unique_ptr<SpatialGrid> linkedGrid;
+	std::unique_ptr<SpatialGrid> packedGrid;
+
+private:
+	static entt::entity createIn(entt::registry& registry, SpatialGrid& grid, Vec2 pos, int faction) {
+		auto entity = registry.create();
+		registry.emplace<Position>(entity, Position{pos});
+		registry.emplace<Faction>(entity, Faction{faction});
+		grid.Insert(entity, pos, faction);
+		return entity;
+	}
+
+	static void moveIn(entt::registry& registry, SpatialGrid& grid, entt::entity entity, Vec2 newPos) {
+		auto& pos = registry.get<Position>(entity);
+		Vec2 oldPos = pos.value;
+		pos.value = newPos;
+		grid.Update(entity, oldPos, newPos);
+	}
+};
+
+TEST_F(SpatialGridBackendTest, ParseBackend_DefaultsToLinkedList) {
+	EXPECT_EQ(SpatialGrid::ParseBackend("packed"), GridBackend::Packed);
+	EXPECT_EQ(SpatialGrid::ParseBackend("linked_list"), GridBackend::LinkedList);
+	EXPECT_EQ(SpatialGrid::ParseBackend("unknown"), GridBackend::LinkedList);
+}
+
+TEST_F(SpatialGridBackendTest, VisitRadius_SameEntitiesInSameOrder) {
+	populate(300);
+
+	for (int faction = -1; faction < MAX_FACTIONS; ++faction) {
+		for (bool same : {false, true}) {
+			auto expected = radius(*linkedGrid, Vec2(400.0f, 400.0f), 220.0f, faction, same);
+			auto result = radius(*packedGrid, Vec2(400.0f, 400.0f), 220.0f, faction, same);
+			EXPECT_EQ(result, expected) << "faction " << faction << " same " << same;
+		}
+	}
+}
+
+TEST_F(SpatialGridBackendTest, VisitRect_SameEntitiesInSameOrder) {
+	populate(300);
+
+	auto expected = rect(*linkedGrid, Vec2(120.0f, 80.0f), Vec2(640.0f, 410.0f));
+	auto result = rect(*packedGrid, Vec2(120.0f, 80.0f), Vec2(640.0f, 410.0f));
+
+	EXPECT_FALSE(expected.empty());
+	EXPECT_EQ(result, expected);
+}
+
+TEST_F(SpatialGridBackendTest, FindNearest_MatchesIncludingTies) {
+	populate(300);
+	// Equidistant pair to exercise tie-breaking
+	createEntity(Vec2(503.0f, 500.0f), 1);
+	createEntity(Vec2(497.0f, 500.0f), 1);
+
+	for (int i = 0; i < 50; ++i) {
+		Vec2 pos(static_cast<float>((i * 53) % 1000), static_cast<float>((i * 29) % 1000));
+		EXPECT_EQ(packedGrid->FindNearest(pos, 120.0f, 0, false), linkedGrid->FindNearest(pos, 120.0f, 0, false));
+	}
+	EXPECT_EQ(packedGrid->FindNearest(Vec2(500.0f, 500.0f), 10.0f, 0, false),
+	          linkedGrid->FindNearest(Vec2(500.0f, 500.0f), 10.0f, 0, false));
+}
+
+TEST_F(SpatialGridBackendTest, Packed_SeesMovesWithinTheSameCell) {
+	auto e = createEntity(Vec2(10.0f, 10.0f), 1);
+
+	// Prime the packed arrays, then move without leaving cell (0,0)
+	EXPECT_EQ(packedGrid->FindNearest(Vec2(0.0f, 0.0f), 20.0f), e);
+	moveEntity(e, Vec2(40.0f, 40.0f));
+
+	EXPECT_EQ(packedGrid->FindNearest(Vec2(0.0f, 0.0f), 20.0f), entt::null);
+	EXPECT_EQ(packedGrid->FindNearest(Vec2(40.0f, 40.0f), 1.0f), e);
+}
+
+TEST_F(SpatialGridBackendTest, Packed_SeesMovesAcrossCellsAndRemovals) {
+	populate(100);
+	auto mover = createEntity(Vec2(5.0f, 5.0f), 2);
+	auto removed = createEntity(Vec2(6.0f, 6.0f), 2);
+
+	radius(*packedGrid, Vec2(0.0f, 0.0f), 50.0f, -1, false); // Prime
+	moveEntity(mover, Vec2(900.0f, 900.0f));
+	linkedGrid->Remove(removed);
+	packedGrid->Remove(removed);
+
+	auto result = radius(*packedGrid, Vec2(0.0f, 0.0f), 50.0f, -1, false);
+	EXPECT_EQ(result, radius(*linkedGrid, Vec2(0.0f, 0.0f), 50.0f, -1, false));
+	EXPECT_EQ(std::count(result.begin(), result.end(), mover), 0);
+	EXPECT_EQ(std::count(result.begin(), result.end(), removed), 0);
+	EXPECT_EQ(packedGrid->FindNearest(Vec2(900.0f, 900.0f), 1.0f), mover);
+}
+
+TEST_F(SpatialGridBackendTest, Packed_ClearEmptiesResults) {
+	populate(50);
+	radius(*packedGrid, Vec2(500.0f, 500.0f), 1000.0f, -1, false); // Prime
+
+	packedGrid->Clear();
+
+	EXPECT_TRUE(radius(*packedGrid, Vec2(500.0f, 500.0f), 1000.0f, -1, false).empty());
+}
+
+TEST_F(SpatialGridBackendTest, Packed_EveryKernelLevelMatchesLinkedList) {
+	populate(400);
+	SimdDistance::Level original = SimdDistance::GetLevel();
+
+	for (auto level : {SimdDistance::Level::Scalar, SimdDistance::Level::SSE2, SimdDistance::Level::AVX2}) {
+		if (!SimdDistance::IsSupported(level)) continue;
+		SimdDistance::SetLevel(level);
+
+		for (int i = 0; i < 40; ++i) {
+			Vec2 pos(static_cast<float>((i * 53) % 1000), static_cast<float>((i * 29) % 1000));
+			EXPECT_EQ(packedGrid->FindNearest(pos, 150.0f, i % MAX_FACTIONS, false),
+			          linkedGrid->FindNearest(pos, 150.0f, i % MAX_FACTIONS, false))
+				<< SimdDistance::GetLevelName(level);
+			EXPECT_EQ(radius(*packedGrid, pos, 150.0f, -1, false), radius(*linkedGrid, pos, 150.0f, -1, false))
+				<< SimdDistance::GetLevelName(level);
+		}
+	}
+
+	SimdDistance::SetLevel(original);
+}
+
+TEST_F(SpatialGridBackendTest, FindKNearestBatch_SameOnBothBackends) {
+	populate(400);
+
+	std::vector<NearestQuery> queries;
+	for (int i = 0; i < 60; ++i) {
+		queries.push_back({Vec2(static_cast<float>((i * 53) % 1000), static_cast<float>((i * 29) % 1000)), 150.0f, i % MAX_FACTIONS, false});
+	}
+
+	std::vector<entt::entity> linked;
+	std::vector<entt::entity> packed;
+	linkedGrid->FindKNearestBatch(queries, 4, linked);
+	packedGrid->FindKNearestBatch(queries, 4, packed);
+	EXPECT_EQ(packed, linked);
+
+	linkedGrid->FindNearestBatch(queries, linked);
+	packedGrid->FindNearestBatch(queries, packed);
+	EXPECT_EQ(packed, linked);
+}
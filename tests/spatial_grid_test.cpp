@@ -2,6 +2,8 @@
 #include "../src/world/spatial_grid.hpp"
 #include "../src/components/components.hpp"
 #include "../src/utils/vec2.hpp"
+#include "../src/utils/frame_arena.hpp"
+#include "allocation_counter.hpp"
 #include <algorithm>
 #include <set>
 #include <memory>
@@ -102,6 +104,79 @@ TEST_F(SpatialGridTest, Update_NoOpWhenSameCell) {
 	EXPECT_EQ(node2.cell_index, old_cell);
 }
 
+TEST_F(SpatialGridTest, InsertBatch_MatchesSequentialInsert) {
+	// Entities already in the grid share cells with the batch, so old heads get relinked
+	std::vector<Vec2> existing = {Vec2(10.0f, 10.0f), Vec2(60.0f, 10.0f)};
+	std::vector<Vec2> batch = {Vec2(20.0f, 20.0f), Vec2(70.0f, 5.0f), Vec2(30.0f, 40.0f), Vec2(900.0f, 900.0f), Vec2(55.0f, 45.0f)};
+
+	entt::registry batchRegistry;
+	SpatialGrid batchGrid(batchRegistry, 1000, 1000, 50);
+	for (const Vec2& pos : existing) {
+		createEntity(pos, 1);
+		auto entity = batchRegistry.create();
+		batchRegistry.emplace<Position>(entity, Position{pos});
+		batchGrid.Insert(entity, pos, 1);
+	}
+
+	std::vector<entt::entity> entities;
+	for (const Vec2& pos : batch) {
+		createEntity(pos, 1);
+		auto entity = batchRegistry.create();
+		batchRegistry.emplace<Position>(entity, Position{pos});
+		entities.push_back(entity);
+	}
+	batchGrid.InsertBatch(entities, batch, 1);
+
+	// Same lists in the same order, and the same node in every slot of the pool
+	std::vector<entt::entity> expected, actual;
+	grid->QueryRect(Vec2(0.0f, 0.0f), Vec2(999.0f, 999.0f), [&](entt::entity e) { expected.push_back(e); });
+	batchGrid.QueryRect(Vec2(0.0f, 0.0f), Vec2(999.0f, 999.0f), [&](entt::entity e) { actual.push_back(e); });
+	EXPECT_EQ(actual, expected);
+
+	const auto& expectedNodes = registry.storage<SpatialNode>();
+	const auto& actualNodes = batchRegistry.storage<SpatialNode>();
+	ASSERT_EQ(actualNodes.size(), expectedNodes.size());
+	for (auto entity : expectedNodes) {
+		const SpatialNode& want = registry.get<SpatialNode>(entity);
+		const SpatialNode& got = batchRegistry.get<SpatialNode>(entity);
+		EXPECT_EQ(got.next, want.next);
+		EXPECT_EQ(got.prev, want.prev);
+		EXPECT_EQ(got.cell_index, want.cell_index);
+		EXPECT_EQ(got.faction, want.faction);
+	}
+}
+
+TEST_F(SpatialGridTest, InsertBatch_ConsecutiveBatchesMatchSequentialInsert) {
+	// The second batch lands in cells whose heads came from the first
+	std::vector<Vec2> first = {Vec2(20.0f, 20.0f), Vec2(70.0f, 5.0f), Vec2(30.0f, 40.0f)};
+	std::vector<Vec2> second = {Vec2(55.0f, 45.0f), Vec2(10.0f, 10.0f)};
+
+	entt::registry batchRegistry;
+	SpatialGrid batchGrid(batchRegistry, 1000, 1000, 50);
+	for (const auto* batch : {&first, &second}) {
+		std::vector<entt::entity> entities;
+		for (const Vec2& pos : *batch) {
+			createEntity(pos, 1);
+			auto entity = batchRegistry.create();
+			batchRegistry.emplace<Position>(entity, Position{pos});
+			entities.push_back(entity);
+		}
+		batchGrid.InsertBatch(entities, *batch, 1);
+	}
+
+	std::vector<entt::entity> expected, actual;
+	grid->QueryRect(Vec2(0.0f, 0.0f), Vec2(999.0f, 999.0f), [&](entt::entity e) { expected.push_back(e); });
+	batchGrid.QueryRect(Vec2(0.0f, 0.0f), Vec2(999.0f, 999.0f), [&](entt::entity e) { actual.push_back(e); });
+	EXPECT_EQ(actual, expected);
+
+	for (auto entity : registry.storage<SpatialNode>()) {
+		const SpatialNode& want = registry.get<SpatialNode>(entity);
+		const SpatialNode& got = batchRegistry.get<SpatialNode>(entity);
+		EXPECT_EQ(got.next, want.next);
+		EXPECT_EQ(got.prev, want.prev);
+	}
+}
+
 // ============================================================================
 // QueryRect Tests
 // ============================================================================
@@ -632,3 +707,254 @@ TEST_F(SpatialGridTest, QueryRadius_MultipleFactions) {
 	EXPECT_EQ(result.size(), 1);
 	EXPECT_TRUE(containsEntity(result, e2));
 }
+
+// ============================================================================
+// QueryCells Tests
+// ============================================================================
+
+TEST_F(SpatialGridTest, QueryCells_ReturnsEntitiesInOverlappingCells) {
+	auto e1 = createEntity(Vec2(5.0f, 5.0f));
+	auto e2 = createEntity(Vec2(45.0f, 45.0f));   // Same cell, outside the rect
+	auto e3 = createEntity(Vec2(60.0f, 5.0f));    // Neighbouring cell
+	auto e4 = createEntity(Vec2(500.0f, 500.0f)); // Far away
+
+	std::vector<entt::entity> result;
+	for (entt::entity e : grid->QueryCells(Vec2(0.0f, 0.0f), Vec2(10.0f, 10.0f))) {
+		result.push_back(e);
+	}
+
+	// Cell-granular: everything in cell (0,0), nothing else
+	EXPECT_EQ(result.size(), 2);
+	EXPECT_TRUE(containsEntity(result, e1));
+	EXPECT_TRUE(containsEntity(result, e2));
+	EXPECT_FALSE(containsEntity(result, e3));
+	EXPECT_FALSE(containsEntity(result, e4));
+}
+
+TEST_F(SpatialGridTest, QueryCells_SpansMultipleCellsAndFactions) {
+	auto e1 = createEntity(Vec2(5.0f, 5.0f), 0);
+	auto e2 = createEntity(Vec2(60.0f, 5.0f), 1);
+	auto e3 = createEntity(Vec2(5.0f, 60.0f), 2);
+	auto e4 = createEntity(Vec2(60.0f, 60.0f), 0);
+	createEntity(Vec2(200.0f, 200.0f), 1);
+
+	std::vector<entt::entity> result;
+	for (entt::entity e : grid->QueryCells(Vec2(0.0f, 0.0f), Vec2(99.0f, 99.0f))) {
+		result.push_back(e);
+	}
+
+	EXPECT_TRUE(sameEntities(result, {e1, e2, e3, e4}));
+}
+
+TEST_F(SpatialGridTest, QueryCells_MatchesQueryRectAfterPositionFilter) {
+	std::vector<entt::entity> all;
+	for (int i = 0; i < 200; ++i) {
+		float x = static_cast<float>((i * 37) % 1000);
+		float y = static_cast<float>((i * 91) % 1000);
+		all.push_back(createEntity(Vec2(x, y), i % MAX_FACTIONS));
+	}
+
+	Vec2 min(120.0f, 80.0f);
+	Vec2 max(640.0f, 410.0f);
+
+	std::vector<entt::entity> expected;
+	grid->QueryRect(min, max, [&](entt::entity e) {
+		expected.push_back(e);
+	});
+
+	std::vector<entt::entity> result;
+	for (entt::entity e : grid->QueryCells(min, max)) {
+		if (Vec2::point_in_rect(registry.get<Position>(e).value, min, max)) {
+			result.push_back(e);
+		}
+	}
+
+	EXPECT_FALSE(expected.empty());
+	EXPECT_TRUE(sameEntities(result, expected));
+}
+
+TEST_F(SpatialGridTest, QueryCells_InvertedRectangleIsEmpty) {
+	createEntity(Vec2(5.0f, 5.0f));
+	createEntity(Vec2(100.0f, 100.0f));
+
+	auto range = grid->QueryCells(Vec2(200.0f, 200.0f), Vec2(0.0f, 0.0f));
+
+	EXPECT_TRUE(range.begin() == range.end());
+}
+
+TEST_F(SpatialGridTest, QueryCells_EmptyRegistry) {
+	auto range = grid->QueryCells(Vec2(0.0f, 0.0f), Vec2(1000.0f, 1000.0f));
+
+	EXPECT_TRUE(range.begin() == range.end());
+}
+
+// ============================================================================
+// Templated Visitor Tests
+// ============================================================================
+
+TEST_F(SpatialGridTest, VisitRadius_MatchesQueryRadiusInSameOrder) {
+	for (int i = 0; i < 200; ++i) {
+		float x = static_cast<float>((i * 37) % 1000);
+		float y = static_cast<float>((i * 91) % 1000);
+		createEntity(Vec2(x, y), i % MAX_FACTIONS);
+	}
+
+	std::vector<entt::entity> expected;
+	grid->QueryRadius(Vec2(400.0f, 400.0f), 250.0f, [&](entt::entity e) {
+		expected.push_back(e);
+	}, 1, false);
+
+	std::vector<entt::entity> result;
+	grid->VisitRadius(Vec2(400.0f, 400.0f), 250.0f, [&](entt::entity e) {
+		result.push_back(e);
+	}, 1, false);
+
+	EXPECT_FALSE(expected.empty());
+	EXPECT_EQ(result, expected);
+}
+
+TEST_F(SpatialGridTest, VisitRect_VisitorCanRemoveAndDestroyCurrentEntity) {
+	createEntity(Vec2(5.0f, 5.0f));
+	createEntity(Vec2(6.0f, 6.0f));
+	createEntity(Vec2(7.0f, 7.0f));
+	auto outside = createEntity(Vec2(500.0f, 500.0f));
+
+	int visited = 0;
+	grid->VisitRect(Vec2(0.0f, 0.0f), Vec2(20.0f, 20.0f), [&](entt::entity e) {
+		grid->Remove(e);
+		registry.destroy(e);
+		visited++;
+	});
+
+	EXPECT_EQ(visited, 3);
+	EXPECT_TRUE(registry.valid(outside));
+	EXPECT_EQ(grid->FindNearest(Vec2(5.0f, 5.0f), 50.0f), entt::null);
+}
+
+// ============================================================================
+// Batched / K-Nearest Tests
+// ============================================================================
+
+TEST_F(SpatialGridTest, FindNearestBatch_MatchesFindNearestPerQuery) {
+	for (int i = 0; i < 300; ++i) {
+		float x = static_cast<float>((i * 37) % 1000);
+		float y = static_cast<float>((i * 91) % 1000);
+		createEntity(Vec2(x, y), i % MAX_FACTIONS);
+	}
+
+	// Clustered shooters with mixed ranges and filters, so some queries share scans and some don't
+	std::vector<NearestQuery> queries;
+	for (int i = 0; i < 120; ++i) {
+		Vec2 pos(static_cast<float>(300 + (i * 7) % 60), static_cast<float>(400 + (i * 13) % 60));
+		float radius = (i % 3 == 0) ? 35.0f : 120.0f;
+		queries.push_back({pos, radius, i % 4 - 1, i % 5 == 0});
+	}
+
+	std::vector<entt::entity> results;
+	grid->FindNearestBatch(queries, results);
+
+	ASSERT_EQ(results.size(), queries.size());
+	for (size_t i = 0; i < queries.size(); ++i) {
+		const auto& q = queries[i];
+		EXPECT_EQ(results[i], grid->FindNearest(q.pos, q.radius, q.faction, q.same_faction)) << "query " << i;
+	}
+}
+
+TEST_F(SpatialGridTest, FindNearestBatch_EmptyInput) {
+	createEntity(Vec2(5.0f, 5.0f), 0);
+
+	std::vector<entt::entity> results = {entt::null};
+	grid->FindNearestBatch({}, results);
+
+	EXPECT_TRUE(results.empty());
+}
+
+TEST_F(SpatialGridTest, FindKNearest_ReturnsClosestFirst) {
+	auto e1 = createEntity(Vec2(3.0f, 0.0f), 1);
+	auto e2 = createEntity(Vec2(1.0f, 0.0f), 1);
+	auto e3 = createEntity(Vec2(2.0f, 0.0f), 1);
+	createEntity(Vec2(4.0f, 0.0f), 1);
+
+	std::vector<entt::entity> results;
+	int found = grid->FindKNearest(Vec2(0.0f, 0.0f), 100.0f, 3, results, 0, false);
+
+	EXPECT_EQ(found, 3);
+	EXPECT_EQ(results, (std::vector<entt::entity>{e2, e3, e1}));
+}
+
+TEST_F(SpatialGridTest, FindKNearest_FewerThanKAndStrictRadius) {
+	auto e1 = createEntity(Vec2(5.0f, 0.0f), 0);
+	createEntity(Vec2(10.0f, 0.0f), 0); // Exactly at radius, excluded like FindNearest
+
+	std::vector<entt::entity> results;
+	int found = grid->FindKNearest(Vec2(0.0f, 0.0f), 10.0f, 4, results);
+
+	EXPECT_EQ(found, 1);
+	ASSERT_EQ(results.size(), 1);
+	EXPECT_EQ(results[0], e1);
+}
+
+TEST_F(SpatialGridTest, FindKNearest_ArenaScratchKeepsTheHeapOut) {
+	if (!AllocationCounter::IsEnabled()) {
+		GTEST_SKIP() << "Allocation counting is not built in";
+	}
+	for (int i = 0; i < 100; ++i) {
+		createEntity(Vec2(static_cast<float>((i * 41) % 300), static_cast<float>((i * 17) % 300)), i % 2);
+	}
+
+	FrameArena arena;
+	std::vector<entt::entity> results;
+	grid->FindKNearest(Vec2(100.0f, 100.0f), 60.0f, 4, results, 0, false, &arena); // Warm-up: arena and results grow
+	arena.Reset();
+
+	AllocationCounter allocations;
+	for (int i = 0; i < 10; ++i) {
+		grid->FindKNearest(Vec2(100.0f, 100.0f), 60.0f, 4, results, 0, false, &arena);
+		arena.Reset();
+	}
+	EXPECT_EQ(allocations.GetCount(), 0u);
+	EXPECT_EQ(results.size(), 4u);
+}
+
+TEST_F(SpatialGridTest, FindKNearestBatch_FirstColumnMatchesFindNearestAndPadsWithNull) {
+	for (int i = 0; i < 100; ++i) {
+		createEntity(Vec2(static_cast<float>((i * 41) % 300), static_cast<float>((i * 17) % 300)), i % 2);
+	}
+	// Equidistant pair so the first column also checks tie-breaking
+	createEntity(Vec2(505.0f, 500.0f), 1);
+	createEntity(Vec2(495.0f, 500.0f), 1);
+
+	std::vector<NearestQuery> queries = {
+		{Vec2(100.0f, 100.0f), 60.0f, 0, false},
+		{Vec2(500.0f, 500.0f), 20.0f, 0, false},
+		{Vec2(900.0f, 900.0f), 20.0f, 0, false}, // Nothing in range
+	};
+	const int k = 3;
+
+	std::vector<entt::entity> results;
+	grid->FindKNearestBatch(queries, k, results);
+
+	ASSERT_EQ(results.size(), queries.size() * k);
+	for (size_t i = 0; i < queries.size(); ++i) {
+		const auto& q = queries[i];
+		EXPECT_EQ(results[i * k], grid->FindNearest(q.pos, q.radius, q.faction, q.same_faction)) << "query " << i;
+	}
+	EXPECT_NE(results[1 * k + 1], entt::null);
+	EXPECT_EQ(results[1 * k + 2], entt::null);
+	EXPECT_EQ(results[2 * k], entt::null);
+}
+
+TEST_F(SpatialGridTest, GetOccupancy_CountsEntitiesPerCellAcrossFactions) {
+	// Cells are 50 units: two factions share one cell, a third entity sits alone
+	createEntity(Vec2(10.0f, 10.0f), 0);
+	createEntity(Vec2(20.0f, 20.0f), 1);
+	createEntity(Vec2(30.0f, 15.0f), 1);
+	createEntity(Vec2(510.0f, 510.0f), 2);
+
+	GridOccupancy occupancy = grid->GetOccupancy();
+	EXPECT_EQ(occupancy.cells, 20 * 20);
+	EXPECT_EQ(occupancy.entities, 4);
+	EXPECT_EQ(occupancy.occupiedCells, 2);
+	EXPECT_EQ(occupancy.maxPerCell, 3);
+	EXPECT_FLOAT_EQ(occupancy.GetMeanPerOccupiedCell(), 2.0f);
+}
@@ -0,0 +1,66 @@
+#include <gtest/gtest.h>
+#include "../src/systems/sprite_batch.hpp"
+#include "../src/world/spatial_grid.hpp"
+#include "../src/components/components.hpp"
+#include <memory>
+#include <vector>
+
+class SpriteBatchTest : public ::testing::Test {
+protected:
+	void SetUp() override {
+		grid = std::make_unique<SpatialGrid>(registry, 1000, 1000, 50);
+	}
+
+	void TearDown() override {
+		grid.reset();
+		registry.clear();
+	}
+
+	// Unit that moved from previous to pos during the last tick
+	entt::entity createUnit(Vec2 previous, Vec2 pos) {
+		auto entity = registry.create();
+		registry.emplace<Position>(entity, Position{pos});
+		registry.emplace<PreviousPosition>(entity, PreviousPosition{previous});
+		registry.emplace<Unit>(entity, Unit{UnitType::Footman, 0});
+		grid->Insert(entity, pos, 0);
+		return entity;
+	}
+
+	std::vector<float> visibleX(SpriteBatch& batch) {
+		batch.BuildVisible(registry, *grid, viewMin, viewMax, 1, unitUVs, factionColors, 1.0f);
+		std::vector<float> xs;
+		for (const auto& bucket : batch.GetBuckets()) {
+			for (const auto& instance : bucket.instances) {
+				xs.push_back(instance.x);
+			}
+		}
+		return xs;
+	}
+
+	entt::registry registry;
+	std::unique_ptr<SpatialGrid> grid;
+	Vec2 viewMin = {100.0f, 100.0f};
+	Vec2 viewMax = {200.0f, 200.0f};
+	std::vector<UVRect> unitUVs = {{0.0f, 0.0f, 1.0f, 1.0f}};
+	std::vector<Color> factionColors = {{1.0f, 0.0f, 0.0f, 1.0f}};
+};
+
+// Culling tests where the sprite is drawn, not where the unit already is
+TEST_F(SpriteBatchTest, BuildVisible_CullsOnTheInterpolatedPosition) {
+	createUnit({150.0f, 150.0f}, {150.0f, 150.0f});
+	createUnit({199.0f, 150.0f}, {260.0f, 150.0f}); // Left the view, still drawn inside it
+	createUnit({210.0f, 150.0f}, {190.0f, 150.0f}); // Entered the view, still drawn outside it
+
+	SpriteBatch batch;
+	batch.SetInterpolationAlpha(0.01f);
+	batch.SetMaxTickMovement(61.0f);
+	std::vector<float> xs = visibleX(batch);
+	ASSERT_EQ(xs.size(), 2u);
+	EXPECT_FLOAT_EQ(xs[0] + xs[1], 150.0f + 199.61f);
+
+	// Without interpolation the current positions decide
+	batch.SetInterpolationAlpha(1.0f);
+	xs = visibleX(batch);
+	ASSERT_EQ(xs.size(), 2u);
+	EXPECT_FLOAT_EQ(xs[0] + xs[1], 150.0f + 190.0f);
+}
@@ -0,0 +1,124 @@
+#include <gtest/gtest.h>
+#include "../src/utils/time_controller.hpp"
+#include "../src/utils/resource_loader.hpp"
+#include "../src/world/world.hpp"
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+TEST(TimeControllerTest, VariableStep_ScalesTheFrameTime) {
+	TimeController time;
+	time.SetSpeedCoefficient(2.0f);
+	time.Update(0.02f);
+	EXPECT_FLOAT_EQ(time.GetDeltaTime(), 0.04f);
+	EXPECT_EQ(time.GetTickCount(), 0);
+	EXPECT_FLOAT_EQ(time.GetInterpolationAlpha(), 1.0f);
+}
+
+TEST(TimeControllerTest, FixedStep_SpeedRunsMoreTicksOfTheSameSize) {
+	TimeController time;
+	time.SetFixedStep(0.01f, 1000);
+
+	time.Update(0.01f);
+	EXPECT_EQ(time.GetTickCount(), 1);
+
+	time.SetSpeedCoefficient(20.0f);
+	time.Update(0.01f);
+	EXPECT_EQ(time.GetTickCount(), 20);
+	EXPECT_FLOAT_EQ(time.GetFixedStep(), 0.01f);
+}
+
+TEST(TimeControllerTest, FixedStep_CarriesPartialStepsBetweenFrames) {
+	TimeController time;
+	time.SetFixedStep(1.0f / 60.0f, 10);
+
+	// 144 Hz frames: most frames run no tick, one second of frames runs 60
+	int ticks = 0;
+	for (int frame = 0; frame < 144; ++frame) {
+		time.Update(1.0f / 144.0f);
+		ticks += time.GetTickCount();
+		EXPECT_LE(time.GetTickCount(), 1);
+		EXPECT_GE(time.GetInterpolationAlpha(), 0.0f);
+		EXPECT_LT(time.GetInterpolationAlpha(), 1.0f);
+	}
+	EXPECT_NEAR(ticks, 60, 1);
+}
+
+TEST(TimeControllerTest, FixedStep_DropsTimeBeyondTheCatchUpBudget) {
+	TimeController time;
+	time.SetFixedStep(0.01f, 5);
+	time.SetSpeedCoefficient(20.0f);
+
+	// 0.1 s at 20x wants 200 ticks
+	time.Update(0.1f);
+	EXPECT_EQ(time.GetTickCount(), 5);
+	EXPECT_EQ(time.GetDroppedTicks(), 195u);
+	EXPECT_LT(time.GetInterpolationAlpha(), 1.0f);
+
+	// The backlog is gone rather than carried into the next frame
+	time.SetSpeedCoefficient(1.0f);
+	time.Update(0.01f);
+	EXPECT_EQ(time.GetTickCount(), 1);
+}
+
+TEST(TimeControllerTest, FixedStep_PausedRunsNoTicks) {
+	TimeController time;
+	time.SetFixedStep(0.01f, 100);
+	time.SetPaused(true);
+	time.Update(0.05f);
+	EXPECT_EQ(time.GetTickCount(), 0);
+}
+
+// The same game time gives the same battle whatever the frame rate and speed
+TEST(TimeControllerTest, FixedStep_SimulationDoesNotDependOnFrameRate) {
+	auto run = [](float frameTime, float speed) {
+		nlohmann::json config;
+		EXPECT_TRUE(ResourceLoader::load_config("data/test_config.json", config));
+		auto world = std::make_unique<World>();
+		EXPECT_TRUE(world->Initialize(config, false));
+		EXPECT_TRUE(world->LoadGame("data/tests/move_and_fight/input.json"));
+
+		TimeController time;
+		time.SetFixedStep(0.01f, 1000);
+		time.SetSpeedCoefficient(speed);
+		int ticks = 0;
+		while (ticks < 300) {
+			time.Update(frameTime);
+			int frameTicks = std::min(time.GetTickCount(), 300 - ticks);
+			world->Step(frameTicks, time.GetFixedStep());
+			ticks += frameTicks;
+		}
+
+		std::vector<float> state;
+		auto view = world->GetRegistry().view<Unit, Position, Health>();
+		for (auto entity : view) {
+			state.insert(state.end(), {view.get<Position>(entity).value.x, view.get<Position>(entity).value.y, view.get<Health>(entity).current});
+		}
+		return state;
+	};
+
+	std::vector<float> reference = run(0.01f, 1.0f);
+	EXPECT_EQ(run(1.0f / 144.0f, 1.0f), reference);
+	EXPECT_EQ(run(1.0f / 30.0f, 20.0f), reference);
+}
+
+TEST(TimeControllerTest, WorldStep_SumsTheGameplayTimingsOverTheFrame) {
+	nlohmann::json config;
+	ASSERT_TRUE(ResourceLoader::load_config("data/test_config.json", config));
+	auto world = std::make_unique<World>();
+	ASSERT_TRUE(world->Initialize(config, false));
+	ASSERT_TRUE(world->LoadGame("data/tests/move_and_fight/input.json"));
+
+	const GameplayTimings& timings = world->GetGameplaySystem().GetTimings();
+	world->Step(20, 0.01f);
+	EXPECT_EQ(timings.ticks, 20);
+	EXPECT_GT(timings.Total(), 0.0);
+
+	// A frame without ticks reports nothing instead of the previous frame
+	world->Step(0, 0.01f);
+	EXPECT_EQ(timings.ticks, 0);
+	EXPECT_EQ(timings.Total(), 0.0);
+
+	world->Update(0.01f);
+	EXPECT_EQ(timings.ticks, 1);
+}
@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+#include "../src/world/unit_factory.hpp"
+
+static nlohmann::json factoryConfig() {
+	return nlohmann::json::parse(R"({
+		"units": [
+			{"hp": 100, "speed": 10.0, "shield": 5, "range": 4.0, "attack_cooldown": 1.0, "damage": 10},
+			{"hp": 60, "speed": 12.0, "shield": 2, "range": 20.0, "attack_cooldown": 2.0, "projectile_speed": 25.0, "damage": 8},
+			{"hp": 150, "speed": 5.0, "range": 35.0, "attack_cooldown": 5.0, "damage": 50, "projectile_speed": 20.0, "damage_radius": 3.0},
+			{"hp": 50, "heal_cooldown": 2.0, "heal_range": 5.0, "heal_amount": 10}
+		]
+	})");
+}
+
+TEST(UnitFactoryTest, Archetypes_AreCompiledFromTheConfig) {
+	UnitFactory factory(factoryConfig());
+
+	const UnitArchetype& footman = factory.GetArchetype(UnitType::Footman);
+	ASSERT_TRUE(footman.configured);
+	EXPECT_FLOAT_EQ(footman.health.max, 100.0f);
+	EXPECT_FLOAT_EQ(footman.health.shield, 5.0f);
+	ASSERT_TRUE(footman.directDamage.has_value());
+	EXPECT_FLOAT_EQ(footman.directDamage->range, 4.0f);
+	EXPECT_FALSE(footman.projectileEmitter.has_value());
+	EXPECT_TRUE(footman.hasAttackTarget);
+
+	const UnitArchetype& ballista = factory.GetArchetype(UnitType::Ballista);
+	ASSERT_TRUE(ballista.projectileEmitter.has_value());
+	EXPECT_EQ(ballista.projectileEmitter->projectile_type, 1);
+	EXPECT_FLOAT_EQ(ballista.projectileEmitter->aoe_radius, 3.0f);
+
+	// Missing fields fall back to the defaults
+	const UnitArchetype& healer = factory.GetArchetype(UnitType::Healer);
+	EXPECT_FLOAT_EQ(healer.speed, 10.0f);
+	EXPECT_FLOAT_EQ(healer.health.shield, 0.0f);
+	ASSERT_TRUE(healer.healer.has_value());
+	EXPECT_FALSE(healer.hasAttackTarget);
+}
+
+TEST(UnitFactoryTest, SpawnUnit_StampsTheArchetype) {
+	UnitFactory factory(factoryConfig());
+	entt::registry registry;
+
+	auto archer = factory.spawn_unit(registry, UnitType::Archer, 1, Vec2(3.0f, 4.0f));
+	EXPECT_EQ(registry.get<Position>(archer).value, Vec2(3.0f, 4.0f));
+	EXPECT_EQ(registry.get<Movement>(archer).target, Vec2(3.0f, 4.0f));
+	EXPECT_FLOAT_EQ(registry.get<Movement>(archer).speed, 12.0f);
+	EXPECT_EQ(registry.get<Faction>(archer).id, 1);
+	EXPECT_FLOAT_EQ(registry.get<Health>(archer).current, 60.0f);
+	EXPECT_FLOAT_EQ(registry.get<ProjectileEmitter>(archer).projectile_speed, 25.0f);
+	EXPECT_FLOAT_EQ(registry.get<ProjectileEmitter>(archer).timer, 0.0f);
+	EXPECT_EQ(registry.get<AttackTarget>(archer).target, entt::null);
+	EXPECT_FALSE((registry.any_of<DirectDamage, Healer>(archer)));
+}
+
+TEST(UnitFactoryTest, SpawnUnit_WithoutConfigEntry_AddsOnlyTheBasics) {
+	nlohmann::json config = nlohmann::json::parse(R"({"units": [{"hp": 100}]})");
+	UnitFactory factory(config);
+	entt::registry registry;
+
+	auto healer = factory.spawn_unit(registry, UnitType::Healer, 0, Vec2(1.0f, 1.0f));
+	EXPECT_TRUE((registry.all_of<Position, Unit, Faction>(healer)));
+	EXPECT_FALSE((registry.any_of<Movement, Health, Healer>(healer)));
+}
+
+TEST(UnitFactoryTest, SpawnUnits_MatchesSpawnUnitInOrder) {
+	UnitFactory factory(factoryConfig());
+	std::vector<Vec2> positions = {Vec2(1.0f, 2.0f), Vec2(3.0f, 4.0f), Vec2(5.0f, 6.0f)};
+
+	entt::registry expected;
+	for (UnitType type : {UnitType::Footman, UnitType::Healer}) {
+		for (const Vec2& pos : positions) {
+			factory.spawn_unit(expected, type, 1, pos);
+		}
+	}
+
+	entt::registry actual;
+	std::vector<entt::entity> entities;
+	factory.spawn_units(actual, UnitType::Footman, 1, positions, entities);
+	ASSERT_EQ(entities.size(), positions.size());
+	factory.spawn_units(actual, UnitType::Healer, 1, positions, entities);
+	ASSERT_EQ(entities.size(), positions.size());
+
+	// Same entities in the same pool order
+	auto poolOrder = [](const auto& storage) { return std::vector<entt::entity>(storage.begin(), storage.end()); };
+	EXPECT_EQ(poolOrder(actual.storage<Position>()), poolOrder(expected.storage<Position>()));
+	EXPECT_EQ(poolOrder(actual.storage<Health>()), poolOrder(expected.storage<Health>()));
+	EXPECT_EQ(poolOrder(actual.storage<Healer>()), poolOrder(expected.storage<Healer>()));
+	EXPECT_EQ(poolOrder(actual.storage<AttackTarget>()), poolOrder(expected.storage<AttackTarget>()));
+
+	for (auto entity : expected.storage<Position>()) {
+		EXPECT_EQ(actual.get<Position>(entity).value, expected.get<Position>(entity).value);
+		EXPECT_EQ(actual.get<Movement>(entity).target, expected.get<Movement>(entity).target);
+		EXPECT_FLOAT_EQ(actual.get<Health>(entity).current, expected.get<Health>(entity).current);
+	}
+}